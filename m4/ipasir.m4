@@ -0,0 +1,80 @@
+# ipasir.m4: Locate an (optional) IPASIR solver library build and runtime deps for autoconf-based projects.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Additional permission under section 7 of the GNU General Public
+# License, version 3 ("GPLv3"):
+#
+# If you convey this file as part of a work that contains a
+# configuration script generated by Autoconf, you may do so under
+# terms of your choice.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+AC_DEFUN([AC_IPASIR], [
+  AC_ARG_WITH(
+    [ipasir],
+    AC_HELP_STRING(
+    [--with-ipasir=LIB],
+    [link the IPASIR-compatible SAT solver library `libLIB` (e.g. cadical, glucose). By default, an IPASIR library is looked for and the backend is built if one is found. Use --without-ipasir to disable it.]),
+    ipasir_lib="$withval",
+    ipasir_lib="check")
+
+  AC_ARG_WITH(
+    [ipasir-prefix],
+    AC_HELP_STRING(
+    [--with-ipasir-prefix=PATH],
+    [find the IPASIR header and library in `PATH/include` and `PATH/lib`. By default, checks in /usr.]),
+    ipasir_prefix="$withval",
+    ipasir_prefix="/usr")
+
+  IPASIR_CPPFLAGS=""
+  IPASIR_LIBS=""
+
+  if test "x$ipasir_lib" != "xno"; then
+    case "x$ipasir_lib" in
+      xcheck) ipasir_candidates="ipasir cadical glucose" ;;
+      xyes) ipasir_candidates="ipasir" ;;
+      *) ipasir_candidates="$ipasir_lib" ;;
+    esac
+
+    save_CPPFLAGS=$CPPFLAGS
+    save_LIBS=$LIBS
+    AC_LANG_PUSH([C++])
+
+    CPPFLAGS="$save_CPPFLAGS -I$ipasir_prefix/include"
+    LIBS="$save_LIBS -L$ipasir_prefix/lib"
+
+    ipasir_found="no"
+    AC_CHECK_HEADER(ipasir.h,
+    [AC_SEARCH_LIBS([ipasir_init], [$ipasir_candidates],
+                    [ipasir_found="yes"])])
+
+    if test "x$ipasir_found" = "xyes"; then
+      IPASIR_CPPFLAGS="-I$ipasir_prefix/include"
+      IPASIR_LIBS="-L$ipasir_prefix/lib"
+      if test "x$ac_cv_search_ipasir_init" != "xnone required"; then
+        IPASIR_LIBS="$IPASIR_LIBS $ac_cv_search_ipasir_init"
+      fi
+
+      AC_DEFINE(HAVE_IPASIR, 1, Defined to 1 if an IPASIR SAT solver is available)
+    elif test "x$ipasir_lib" != "xcheck"; then
+      AC_MSG_ERROR([IPASIR library `$ipasir_candidates' not found in $ipasir_prefix])
+    fi
+
+    AC_LANG_POP([C++])
+    CPPFLAGS=$save_CPPFLAGS
+    LIBS=$save_LIBS
+  fi
+
+  AC_SUBST(IPASIR_CPPFLAGS)
+  AC_SUBST(IPASIR_LIBS)
+])
@@ -22,6 +22,7 @@
  **/
 
 #include <vector>
+#include <climits>
 
 #include <base.hh>
 #include <symb/proxy.hh>
@@ -40,6 +41,7 @@ Algorithm::Algorithm(Command& command, Model& model)
     , f_em(ExprMgr::INSTANCE())
     , f_tm(TypeMgr::INSTANCE())
     , f_witness(NULL)
+    , f_state_bits_ready(false)
 {}
 
 Algorithm::~Algorithm()
@@ -47,210 +49,162 @@ Algorithm::~Algorithm()
 
 void Algorithm::setup()
 {
-    f_ok = true;
-
-    /* Force mgr to exist */
-    EngineMgr& mgr
-        (EngineMgr::INSTANCE());
-
-    /* suppress warning */
-    (void) mgr;
-
-    ExprMgr& em
-        (ExprMgr::INSTANCE());
-
-    Environment& env
-        (Environment::INSTANCE());
-
-    Model& model
+    ConeOfInfluence coi
         (f_model);
 
-    Module& main_module
-        (model.main_module());
+    compile_constraints(coi);
+}
 
-    std::stack< std::pair<Expr_ptr, Module_ptr> > stack;
-    stack.push( std::pair< Expr_ptr, Module_ptr >
-                (em.make_empty(), &main_module));
+void Algorithm::setup(const ExprVector& roots)
+{
+    ConeOfInfluence coi
+        (f_model);
 
-    /* walk of var decls, starting from main module */
-    while (0 < stack.size()) {
+    if (coi_enabled()) {
+        coi.process(roots);
 
-        const std::pair< Expr_ptr, Module_ptr > top
-            (stack.top());
-        stack.pop();
+        INFO
+            << "COI: "
+            << coi
+            << std::endl;
+    }
 
-        Expr_ptr ctx
-            (top.first);
+    compile_constraints(coi);
+}
 
-        Module& module
-            (* top.second);
+void Algorithm::compile_constraints(const ConeOfInfluence& coi)
+{
+    f_ok = true;
 
-        /* module INITs */
-        const ExprVector& init
-            (module.init());
-        process_init(ctx, init);
+    /* Force mgr to exist */
+    EngineMgr& mgr
+        (EngineMgr::INSTANCE());
 
-        /* module INVARs */
-        const ExprVector& invar
-            (module.invar());
-        process_invar(ctx, invar);
+    /* suppress warning */
+    (void) mgr;
 
-        /* module TRANSes */
-        const ExprVector& trans
-            (module.trans());
-        process_trans(ctx, trans);
+    const COIConstraints& constraints
+        (coi.constraints());
 
-        Variables attrs
-            (module.vars());
-        Variables::const_iterator vi;
-        for (vi = attrs.begin(); attrs.end() != vi; ++ vi) {
+    /* compile all the relevant constraints at once, with a pool of
+       workers (cfr. ModelMgr::precompile()). Those failing are
+       compiled again below, to report errors. */
+    CompilationKeys keys;
+    for (COIConstraints::const_iterator i = constraints.begin();
+         constraints.end() != i; ++ i)
+        if (i->relevant)
+            keys.push_back(CompilationKey(i->ctx, i->body));
 
-            Expr_ptr id
-                (vi->first);
+    f_mm.precompile(keys);
 
-            Variable& var
-                (* vi->second);
+    for (COIConstraints::const_iterator i = constraints.begin();
+         constraints.end() != i; ++ i) {
 
-            Type_ptr vtype
-                (var.type());
+        if (! i->relevant) {
+            DEBUG
+                << "pruning "
+                << i->ctx << "::" << i->body
+                << std::endl;
 
-            Expr_ptr local_ctx
-                (em.make_dot( ctx, id));
+            continue;
+        }
 
-            if (vtype->is_instance()) {
+        switch (i->kind) {
+        case COI_INIT:
+            process_init(i->ctx, i->body);
+            break;
 
-                InstanceType_ptr instance
-                    (vtype->as_instance());
+        case COI_INVAR:
+            process_invar(i->ctx, i->body);
+            break;
 
-                Module&  module
-                    (model.module(instance->name()));
+        case COI_TRANS:
+            process_trans(i->ctx, i->body);
+            break;
 
-                stack.push( std::pair< Expr_ptr, Module_ptr >
-                            (local_ctx, &module));
-            }
+        default: assert(false);
         }
-    } /* while() */
-
-    /* processing environment extra constraints */
-    const ExprVector& extra_init
-        (env.extra_init());
-    process_init(NULL, extra_init);
-
-    /* environment INVARs */
-    const ExprVector& extra_invar
-        (env.extra_invar());
-    process_invar(NULL, extra_invar);
-
-    /* environment TRANSes */
-    const ExprVector& extra_trans
-        (env.extra_trans());
-    process_trans(NULL, extra_trans);
+    }
 }
 
-void Algorithm::process_init(Expr_ptr ctx, const ExprVector& exprs)
+void Algorithm::process_init(Expr_ptr ctx, Expr_ptr body)
 {
-    Compiler& cmpl
-        (compiler()); // just a local ref
+    DEBUG
+        << "processing INIT "
+        << ctx << "::" << body
+        << std::endl;
 
-    for (ExprVector::const_iterator ii = exprs.begin(); ii != exprs.end(); ++ ii ) {
+    try {
+        f_init.push_back( f_mm.compile(ctx, body));
+    }
+    catch (Exception& ae) {
+        f_ok = false;
 
-        Expr_ptr body
-            (*ii);
+        pconst_char what
+            (ae.what());
 
-        DEBUG
-            << "processing INIT "
+        ERR
+            << what
+            << std::endl
+            << "  in INIT "
             << ctx << "::" << body
             << std::endl;
 
-        try {
-            f_init.push_back( cmpl.process(ctx, *ii));
-        }
-        catch (Exception& ae) {
-            f_ok = false;
-
-            pconst_char what
-                (ae.what());
-
-            ERR
-                << what
-                << std::endl
-                << "  in INIT "
-                << ctx << "::" << body
-                << std::endl;
-
-            free ((void *) what);
-        }
+        free ((void *) what);
     }
 } /* process_init() */
 
-void Algorithm::process_invar(Expr_ptr ctx, const ExprVector& exprs)
+void Algorithm::process_invar(Expr_ptr ctx, Expr_ptr body)
 {
-    Compiler& cmpl
-        (compiler()); // just a local ref
-
-    for (ExprVector::const_iterator ii = exprs.begin(); ii != exprs.end(); ++ ii ) {
-
-            Expr_ptr body
-                (*ii);
+    DEBUG
+        << "processing INVAR "
+        << ctx << "::" << body
+        << std::endl;
 
-            DEBUG
-                << "processing INVAR "
-                << ctx << "::" << body
-                << std::endl;
-            try {
-                f_invar.push_back( cmpl.process(ctx, *ii));
-            }
-            catch (Exception& ae) {
-                f_ok = false;
+    try {
+        f_invar.push_back( f_mm.compile(ctx, body));
+    }
+    catch (Exception& ae) {
+        f_ok = false;
 
-                pconst_char what
-                    (ae.what());
+        pconst_char what
+            (ae.what());
 
-                ERR
-                    << what
-                    << std::endl
-                    << "  in INVAR "
-                    << ctx << "::" << body
-                    << std::endl;
+        ERR
+            << what
+            << std::endl
+            << "  in INVAR "
+            << ctx << "::" << body
+            << std::endl;
 
-                free((void *) what);
-            }
-        }
+        free ((void *) what);
+    }
 } /* process_invar() */
 
-void Algorithm::process_trans(Expr_ptr ctx, const ExprVector& exprs)
+void Algorithm::process_trans(Expr_ptr ctx, Expr_ptr body)
 {
-    Compiler& cmpl
-        (compiler()); // just a local ref
+    DEBUG
+        << "processing TRANS "
+        << ctx << "::" << body
+        << std::endl;
 
-    for (ExprVector::const_iterator ti = exprs.begin(); ti != exprs.end(); ++ ti ) {
+    try {
+        f_trans.push_back( f_mm.compile(ctx, body));
+    }
+    catch (Exception& ae) {
+        f_ok = false;
 
-        Expr_ptr body
-            (*ti);
+        pconst_char what
+            (ae.what());
 
-        DEBUG
-            << "processing TRANS "
+        ERR
+            << what
+            << std::endl
+            << "  in TRANS "
             << ctx << "::" << body
             << std::endl;
 
-        try {
-            f_trans.push_back( cmpl.process(ctx, *ti));
-        }
-        catch (Exception& ae) {
-            f_ok = false;
-
-            pconst_char what
-                (ae.what());
-
-            ERR
-                << what
-                << std::endl
-                << "  in TRANS "
-                << ctx << "::" << body
-                << std::endl;
-
-            free ((void *) what);
-        }
+        free ((void *) what);
     }
 } /* process_trans() */
 
@@ -272,15 +226,34 @@ void Algorithm::assert_fsm_trans(Engine& engine, step_t time, group_t group)
         engine.push( *i, time, group);
 }
 
-void Algorithm::assert_fsm_uniqueness(Engine& engine, step_t j, step_t k, group_t group)
+const IndexVector& Algorithm::state_bits()
+{
+    boost::mutex::scoped_lock lock
+        (f_state_bits_mutex);
+
+    collect_bits();
+
+    return f_state_bits;
+}
+
+const IndexVector& Algorithm::frozen_bits()
 {
+    boost::mutex::scoped_lock lock
+        (f_state_bits_mutex);
+
+    collect_bits();
+
+    return f_frozen_bits;
+}
+
+void Algorithm::collect_bits()
+{
+    if (f_state_bits_ready)
+        return;
+
     SymbIter symbs
         (model());
 
-    /* this will hold the activation vars for the uniqueness clauses
-       defined below */
-    VarVector uniqueness_vars;
-
     while (symbs.has_next()) {
 
         std::pair< Expr_ptr, Symbol_ptr> pair
@@ -298,15 +271,18 @@ void Algorithm::assert_fsm_uniqueness(Engine& engine, step_t j, step_t k, group_
                 (symb->as_variable());
 
             if (var.is_input() ||
-                var.is_frozen() ||
                 var.is_temp())
                 continue ;
 
+            /* frozen vars are encoded once and for all, cfr. Compiler */
+            bool frozen
+                (var.is_frozen());
+
             Expr_ptr expr
                 (var.name());
 
             TimedExpr key
-                (em().make_dot( ctx, expr), 0);
+                (em().make_dot( ctx, expr), frozen ? UINT_MAX : 0);
 
             Encoding_ptr enc
                 (f_bm.find_encoding(key));
@@ -314,77 +290,313 @@ void Algorithm::assert_fsm_uniqueness(Engine& engine, step_t j, step_t k, group_
             if (!enc)
                 continue;
 
+            IndexVector& bits
+                (frozen ? f_frozen_bits : f_state_bits);
+
             DDVector::const_iterator di;
-            unsigned ndx;
-            for (ndx = 0, di = enc->bits().begin();
-                 enc->bits().end() != di; ++ ndx, ++ di) {
+            for (di = enc->bits().begin(); enc->bits().end() != di; ++ di)
+                bits.push_back((*di).getNode()->index);
+        }
+    }
 
-                unsigned bit
-                    ((*di).getNode()->index);
+    f_state_bits_ready = true;
+}
 
-                const UCBI& ucbi
-                    (f_bm.find_ucbi(bit));
+void Algorithm::alloc_fsm_state(Engine& engine, step_t time)
+{
+    const IndexVector& bits
+        (state_bits());
 
-                const TCBI jtcbi
-                    (TCBI(ucbi, j));
+    for (IndexVector::const_iterator i = bits.begin(); bits.end() != i; ++ i)
+        engine.find_dd_var(*i, time);
+}
 
-                const TCBI ktcbi
-                    (TCBI(ucbi, k));
+void Algorithm::assert_fsm_uniqueness(Engine& engine, step_t j, step_t k, group_t group)
+{
+    const IndexVector& bits
+        (state_bits());
 
-                Var jkne
-                    (engine.new_sat_var());
+    /* this will hold the activation vars for the uniqueness clauses
+       defined below */
+    VarVector uniqueness_vars;
 
-                uniqueness_vars.push_back(jkne);
+    for (IndexVector::const_iterator i = bits.begin(); bits.end() != i; ++ i) {
 
-                Var jvar
-                    (engine.tcbi_to_var(jtcbi));
+        Var jkne
+            (engine.new_sat_var());
 
-                Var kvar
-                    (engine.tcbi_to_var(ktcbi));
+        uniqueness_vars.push_back(jkne);
 
-                /* for each pair (j, k) we assert two clauses, both
-                   activated by jkne. The first clause is satisfied if
-                   at least one of the two variables (j, k) is false;
-                   the second clause is satisified if at least one of
-                   the two variables is true. As it is impossibile for
-                   the same variable to be false and true at the same
-                   time, this is equivalent to state:
+        Var jvar
+            (engine.find_dd_var(*i, j));
 
-                   jkne -> j xor k */
+        Var kvar
+            (engine.find_dd_var(*i, k));
 
-                {
-                    vec<Lit> ps;
-                    ps.push( mkLit( jkne, true));
-                    ps.push( mkLit( jvar, true));
-                    ps.push( mkLit( kvar, true));
+        /* for each pair (j, k) we assert two clauses, both
+           activated by jkne. The first clause is satisfied if
+           at least one of the two variables (j, k) is false;
+           the second clause is satisified if at least one of
+           the two variables is true. As it is impossibile for
+           the same variable to be false and true at the same
+           time, this is equivalent to state:
 
-                    engine.add_clause(ps);
-                }
+           jkne -> j xor k */
 
-                {
-                    vec<Lit> ps;
-                    ps.push( mkLit( jkne, true));
-                    ps.push( mkLit( jvar, false));
-                    ps.push( mkLit( kvar, false));
+        engine.append_lit( mkLit( jkne, true));
+        engine.append_lit( mkLit( jvar, true));
+        engine.append_lit( mkLit( kvar, true));
+        engine.close_clause();
 
-                    engine.add_clause(ps);
-                }
-            }
-        }
+        engine.append_lit( mkLit( jkne, true));
+        engine.append_lit( mkLit( jvar, false));
+        engine.append_lit( mkLit( kvar, false));
+        engine.close_clause();
     }
 
     /* ...  finally, we assert that at least one of the activation
        variables is true */
-    {
-        vec<Lit> ps;
-        ps.push( mkLit( group, true));
+    engine.append_lit( mkLit( group, true));
+    for (VarVector::const_iterator eye = uniqueness_vars.begin();
+         eye != uniqueness_vars.end(); ++ eye) {
+        engine.append_lit( mkLit( *eye, false));
+    }
+    engine.close_clause();
 
-        for (VarVector::const_iterator eye = uniqueness_vars.begin();
-             eye != uniqueness_vars.end(); ++ eye) {
-            ps.push( mkLit( *eye, false));
+    engine.flush_clauses();
+}
+
+unsigned Algorithm::refine_fsm_uniqueness(Engine& engine, const TimeVector& times)
+{
+    typedef boost::unordered_map<std::vector<bool>, step_t> State2TimeMap;
+
+    const IndexVector& bits
+        (state_bits());
+
+    State2TimeMap seen;
+    unsigned res
+        (0);
+
+    for (TimeVector::const_iterator t = times.begin(); times.end() != t; ++ t) {
+        std::vector<bool> state;
+        state.reserve(bits.size());
+
+        for (IndexVector::const_iterator i = bits.begin(); bits.end() != i; ++ i)
+            state.push_back(engine.value( engine.find_dd_var(*i, *t)));
+
+        std::pair<State2TimeMap::iterator, bool> eye
+            (seen.insert(std::pair<std::vector<bool>, step_t> (state, *t)));
+
+        /* a loop in the path, rule it out */
+        if (! eye.second) {
+            DEBUG
+                << "States @" << eye.first->second
+                << " and @" << *t
+                << " are equal, adding uniqueness constraint"
+                << std::endl;
+
+            assert_fsm_uniqueness(engine, eye.first->second, *t);
+            ++ res;
         }
+    }
+
+    return res;
+}
+
+/* each clause is activated by group, cfr. assert_fsm_uniqueness() */
+static inline void append_clause(Engine& engine, group_t group,
+                                 std::initializer_list<Lit> lits)
+{
+    engine.append_lit( mkLit( group, true));
+    for (std::initializer_list<Lit>::const_iterator i = lits.begin();
+         lits.end() != i; ++ i)
+        engine.append_lit(*i);
+
+    engine.close_clause();
+}
+
+void Algorithm::assert_vector_swap(Engine& engine, const VarVector& x,
+                                   const VarVector& y, Var swap,
+                                   VarVector& lo, VarVector& hi, group_t group)
+{
+    assert(x.size() == y.size());
+
+    Lit s
+        (mkLit( swap, false));
+
+    for (unsigned i = 0; i < x.size(); ++ i) {
+        Var l
+            (engine.new_sat_var());
+        Var h
+            (engine.new_sat_var());
+
+        /* l = s ? y : x */
+        append_clause(engine, group, {  s, mkLit( x[i], true ), mkLit( l, false) });
+        append_clause(engine, group, {  s, mkLit( x[i], false), mkLit( l, true ) });
+        append_clause(engine, group, { ~s, mkLit( y[i], true ), mkLit( l, false) });
+        append_clause(engine, group, { ~s, mkLit( y[i], false), mkLit( l, true ) });
+
+        /* h = s ? x : y */
+        append_clause(engine, group, {  s, mkLit( y[i], true ), mkLit( h, false) });
+        append_clause(engine, group, {  s, mkLit( y[i], false), mkLit( h, true ) });
+        append_clause(engine, group, { ~s, mkLit( x[i], true ), mkLit( h, false) });
+        append_clause(engine, group, { ~s, mkLit( x[i], false), mkLit( h, true ) });
+
+        lo.push_back(l);
+        hi.push_back(h);
+    }
+}
+
+void Algorithm::assert_vector_less(Engine& engine, const VarVector& x,
+                                   const VarVector& y, group_t group)
+{
+    assert(x.size() == y.size());
+
+    /* x < y (lexicographic), unless y is an inactive slot (cfr.
+       SimplePath), positive polarity only: x and y are decided at
+       some bit i (d_i), they agree on all bits before i (e_i). */
+    VarVector decided;
+
+    Var prev_eq
+        (MAINGROUP); /* e_0 is true */
+
+    for (unsigned i = 0; i < x.size(); ++ i) {
+        Lit xi (mkLit( x[i], false));
+        Lit yi (mkLit( y[i], false));
+
+        Var d
+            (engine.new_sat_var());
+        decided.push_back(d);
+
+        /* d_i -> e_i & !x_i & y_i */
+        append_clause(engine, group, { mkLit( d, true), mkLit( prev_eq, false) });
+        append_clause(engine, group, { mkLit( d, true), ~xi });
+        append_clause(engine, group, { mkLit( d, true),  yi });
+
+        /* e_i+1 -> e_i & (x_i <-> y_i) */
+        Var eq
+            (engine.new_sat_var());
+
+        append_clause(engine, group, { mkLit( eq, true), mkLit( prev_eq, false) });
+        append_clause(engine, group, { mkLit( eq, true), ~xi,  yi });
+        append_clause(engine, group, { mkLit( eq, true),  xi, ~yi });
+
+        prev_eq = eq;
+    }
+
+    engine.append_lit( mkLit( group, true));
+    engine.append_lit( mkLit( y[0], false));
+    for (VarVector::const_iterator i = decided.begin(); decided.end() != i; ++ i)
+        engine.append_lit( mkLit( *i, false));
+    engine.close_clause();
+}
+
+void Algorithm::extend_fsm_simple_path(Engine& engine, SimplePath& path,
+                                       step_t time)
+{
+    const IndexVector& bits
+        (state_bits());
+
+    VarVector state;
+    for (IndexVector::const_iterator bi = bits.begin(); bits.end() != bi; ++ bi)
+        state.push_back( engine.find_dd_var(*bi, time));
+
+    path.states.push_back(state);
+
+    if (path.slots.size() < path.states.size())
+        build_simple_path_network(engine, path);
+    else
+        link_simple_path_slot(engine, path, path.states.size() - 1);
+
+    engine.flush_clauses();
+}
+
+/* Each comparator has a free swap variable, its outputs are a
+   permutation of its inputs in any case. If the active slots are
+   pairwise distinct some choice of the swaps sorts them, inactive
+   slots last, hence the outputs can be strictly increasing up to the
+   first inactive one iff all the states are distinct. */
+void Algorithm::build_simple_path_network(Engine& engine, SimplePath& path)
+{
+    /* the network path has outgrown is disabled for good, the solver
+       will get rid of its clauses */
+    if (MAINGROUP != path.group)
+        engine.finalize_group(- path.group);
+
+    group_t group
+        (engine.new_group());
+    path.group = group;
+
+    unsigned nslots
+        (path.slots.empty() ? 1 : 2 * path.slots.size());
+
+    unsigned width
+        (1 + state_bits().size());
+
+    /* slots are linked to the states later on, cfr.
+       link_simple_path_slot() */
+    path.slots.clear();
+    for (unsigned i = 0; i < nslots; ++ i) {
+        VarVector slot;
+        for (unsigned b = 0; b < width; ++ b)
+            slot.push_back( engine.new_sat_var(true));
+
+        path.slots.push_back(slot);
+    }
+
+    /* Batcher's odd-even merge sort */
+    std::vector<VarVector> wires
+        (path.slots);
+
+    unsigned ncomparators
+        (0);
+
+    for (unsigned p = 1; p < nslots; p <<= 1)
+        for (unsigned k = p; 0 < k; k >>= 1)
+            for (unsigned j = k % p; j + k < nslots; j += 2 * k)
+                for (unsigned i = 0; i < k && i + j + k < nslots; ++ i)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        VarVector lo;
+                        VarVector hi;
+
+                        assert_vector_swap(engine, wires[i + j], wires[i + j + k],
+                                           engine.new_sat_var(), lo, hi, group);
+
+                        wires[i + j].swap(lo);
+                        wires[i + j + k].swap(hi);
+                        ++ ncomparators;
+                    }
+
+    for (unsigned i = 1; i < nslots; ++ i)
+        assert_vector_less(engine, wires[i - 1], wires[i], group);
+
+    for (unsigned i = 0; i < path.states.size(); ++ i)
+        link_simple_path_slot(engine, path, i);
+
+    DEBUG
+        << "Simple path network rebuilt for "
+        << nslots << " states, "
+        << ncomparators << " comparators"
+        << std::endl;
+}
+
+/* slot i holds the i-th state of path, and it is active */
+void Algorithm::link_simple_path_slot(Engine& engine, SimplePath& path,
+                                      unsigned i)
+{
+    const VarVector& slot
+        (path.slots[i]);
+
+    const VarVector& state
+        (path.states[i]);
+
+    append_clause(engine, path.group, { mkLit( slot[0], true) });
 
-        engine.add_clause(ps);
+    for (unsigned b = 0; b < state.size(); ++ b) {
+        append_clause(engine, path.group, { mkLit( slot[1 + b], true ),
+                                            mkLit( state[b], false) });
+        append_clause(engine, path.group, { mkLit( slot[1 + b], false),
+                                            mkLit( state[b], true ) });
     }
 }
 
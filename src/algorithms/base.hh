@@ -29,6 +29,7 @@
 #define BASE_ALGORITHM_H
 
 #include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <sat/sat.hh>
 
@@ -44,9 +45,33 @@
 
 #include <utils/variant.hh>
 #include <algorithms/exceptions.hh>
+#include <algorithms/coi.hh>
 
 class Command;
 
+/* Simple path, cfr. extend_fsm_simple_path(): the states inserted so
+   far, and the sorting network keeping them pairwise distinct. It
+   grows with the engine it was built on. */
+struct SimplePath {
+    /* state vectors, in insertion order */
+    std::vector<VarVector> states;
+
+    /* network inputs, one per slot: an inactive flag, then the state
+       bits. The first size() slots hold the states. */
+    std::vector<VarVector> slots;
+
+    /* activates the network, MAINGROUP if none was built yet */
+    group_t group;
+
+    SimplePath()
+        : group(MAINGROUP)
+    {}
+
+    /* number of states on the path */
+    inline unsigned size() const
+    { return states.size(); }
+};
+
 /* Engine-less algorithm base class. Engine instances are provided by
    strategies. */
 class Algorithm {
@@ -58,8 +83,13 @@ public:
     /* Build encodings to perform model compilation */
     virtual void setup();
 
+    /* Same as above, restricted to the cone of influence of roots
+       (if enabled, cfr. coi_enabled()) */
+    void setup(const ExprVector& roots);
+
+    /* Model-scoped, cfr. ModelMgr::compiler() */
     inline Compiler& compiler()
-    { return f_compiler; }
+    { return f_mm.compiler(); }
 
     inline bool has_witness() const
     { return NULL != f_witness; }
@@ -85,6 +115,22 @@ public:
     inline bool ok() const
     { return f_ok; }
 
+    /* Compiled FSM constraints, cfr. setup() */
+    inline const CompilationUnits& init() const
+    { return f_init; }
+
+    inline const CompilationUnits& invar() const
+    { return f_invar; }
+
+    inline const CompilationUnits& trans() const
+    { return f_trans; }
+
+    /* DD indexes of all state bits, built on first use (synchronized).
+       Frozen bits are kept apart, they take the same value in all the
+       time frames. */
+    const IndexVector& state_bits();
+    const IndexVector& frozen_bits();
+
     /* FSM */
     void assert_fsm_init(Engine& engine, step_t time,
                          group_t group = MAINGROUP);
@@ -95,10 +141,27 @@ public:
     void assert_fsm_trans(Engine& engine, step_t time,
                           group_t group = MAINGROUP);
 
+    /* Allocates SAT variables for all state bits at time */
+    void alloc_fsm_state(Engine& engine, step_t time);
+
     /* Generate uniqueness constraints between j-th and k-th state */
     void assert_fsm_uniqueness(Engine& engine, step_t j, step_t k,
                                group_t group = MAINGROUP);
 
+    /* Lazy uniqueness: generates uniqueness constraints for each pair
+       of states in times that are equal in the last model found by
+       engine. Returns the number of such pairs, 0 means the model is a
+       simple path. State bits at times must have been allocated before
+       solving, cfr. alloc_fsm_state(). */
+    unsigned refine_fsm_uniqueness(Engine& engine, const TimeVector& times);
+
+    /* Compact uniqueness, incremental: the state at time is added to
+       path, all the states in path are pairwise distinct. States are
+       sorted by an odd-even merge sorting network, which is rebuilt
+       whenever path outgrows it, twice as large. Hence a path of n
+       states takes O(n log^2 n) comparators overall. */
+    void extend_fsm_simple_path(Engine& engine, SimplePath& path, step_t time);
+
     /* Generic formulas */
     void assert_formula(Engine& engine, step_t time, CompilationUnit& term,
                         group_t group = MAINGROUP);
@@ -109,9 +172,11 @@ public:
 
 private:
     /* internals */
-    void process_init (Expr_ptr ctx, const ExprVector& init);
-    void process_invar(Expr_ptr ctx, const ExprVector& invar);
-    void process_trans(Expr_ptr ctx, const ExprVector& trans);
+    void compile_constraints(const ConeOfInfluence& coi);
+
+    void process_init (Expr_ptr ctx, Expr_ptr body);
+    void process_invar(Expr_ptr ctx, Expr_ptr body);
+    void process_trans(Expr_ptr ctx, Expr_ptr body);
 
     /* all good? */
     bool f_ok;
@@ -128,9 +193,6 @@ private:
     ExprMgr& f_em;
     TypeMgr& f_tm;
 
-    /* Model Compiler */
-    Compiler f_compiler;
-
     /* Formulas */
     CompilationUnits f_init;
     CompilationUnits f_invar;
@@ -138,6 +200,25 @@ private:
 
     /* Witness */
     Witness_ptr f_witness;
+
+    /* state and frozen bits, cfr. state_bits() */
+    void collect_bits();
+
+    boost::mutex f_state_bits_mutex;
+    IndexVector f_state_bits;
+    IndexVector f_frozen_bits;
+    bool f_state_bits_ready;
+
+    /* simple path helpers, cfr. extend_fsm_simple_path() */
+    void build_simple_path_network(Engine& engine, SimplePath& path);
+    void link_simple_path_slot(Engine& engine, SimplePath& path, unsigned i);
+
+    void assert_vector_swap(Engine& engine, const VarVector& x,
+                            const VarVector& y, Var swap,
+                            VarVector& lo, VarVector& hi, group_t group);
+
+    void assert_vector_less(Engine& engine, const VarVector& x,
+                            const VarVector& y, group_t group);
 };
 
 #endif /* BASE_ALGORITHM_H */
@@ -0,0 +1,685 @@
+/**
+ * @file bdd/bdd.cc
+ * @brief BDD-based symbolic reachability, implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+#include <algorithms/bdd/bdd.hh>
+
+#include <env/environment.hh>
+
+#include <sat/inlining.hh>
+
+#include <symb/classes.hh>
+#include <symb/symb_iter.hh>
+
+static const char* BDD_CLUSTER_IDENTIFIER = "bdd_cluster";
+
+static const unsigned DEFAULT_BDD_CLUSTER (5000);
+
+UnsupportedBDDModel::UnsupportedBDDModel(const std::string& message)
+    : AlgorithmException("UnsupportedBDDModel", message)
+{}
+
+/* a state bit of the shared manager, indexes are -1 if not encoded */
+struct BDDStateBit {
+    int level;
+    int curr;
+    int next;
+    bool frozen;
+
+    BDDStateBit(int level_, int curr_, int next_, bool frozen_)
+        : level(level_)
+        , curr(curr_)
+        , next(next_)
+        , frozen(frozen_)
+    {}
+
+    inline bool operator<(const BDDStateBit& other) const
+    { return level < other.level; }
+};
+
+BDDReachability::BDDReachability(Algorithm& algorithm, CompilationUnit& target,
+                                 CompilationUnits& constraints)
+    : f_algorithm(algorithm)
+    , f_target(target)
+    , f_constraints(constraints)
+    , f_enc(EncodingMgr::INSTANCE())
+    , f_cudd(0, 0,
+             OptsMgr::INSTANCE().dd_unique_slots(),
+             OptsMgr::INSTANCE().dd_cache_slots())
+    , f_depth(0)
+{
+    if (OptsMgr::INSTANCE().dd_reorder())
+        f_cudd.AutodynEnable(CUDD_REORDER_GROUP_SIFT);
+
+    f_reached = f_cudd.bddZero();
+}
+
+BDDReachability::~BDDReachability()
+{}
+
+status_t BDDReachability::process(std::function<bool ()> interrupted)
+{
+    setup();
+
+    BDD frontier
+        (f_init * f_invar);
+
+    f_reached = frontier;
+    for (step_t k = 0; ; ++ k) {
+
+        if (interrupted())
+            return STATUS_UNKNOWN;
+
+        if (! (frontier * f_bad).IsZero()) {
+            f_depth = k;
+            return STATUS_SAT;
+        }
+
+        /* any set of states between the frontier and the states
+           reached so far has the same new successors */
+        BDD successors
+            (image(frontier.Squeeze(f_reached)) * f_invar);
+
+        frontier = successors * ! f_reached;
+        if (frontier.IsZero())
+            return STATUS_UNSAT;
+
+        f_reached += frontier;
+
+        unsigned size
+            (f_reached.nodeCount());
+
+        if (f_stats.peak < size)
+            f_stats.peak = size;
+
+        step_t depth
+            (k + 1);
+
+        double nstates
+            (states());
+
+        DEBUG
+            << "BDD: depth "
+            << depth
+            << ", "
+            << nstates
+            << " states reached ("
+            << size
+            << " nodes)"
+            << std::endl;
+    }
+}
+
+double BDDReachability::states() const
+{
+    return f_reached.CountMinterm(f_state.size());
+}
+
+void BDDReachability::setup()
+{
+    setup_state();
+
+    f_init = f_cudd.bddOne();
+    const CompilationUnits& init
+        (f_algorithm.init());
+    for (CompilationUnits::const_iterator i = init.begin(); init.end() != i; ++ i)
+        f_init *= unit(*i, false);
+
+    f_invar = f_cudd.bddOne();
+    const CompilationUnits& invar
+        (f_algorithm.invar());
+    for (CompilationUnits::const_iterator i = invar.begin(); invar.end() != i; ++ i)
+        f_invar *= unit(*i, false);
+
+    for (CompilationUnits::const_iterator i = f_constraints.begin();
+         f_constraints.end() != i; ++ i)
+        f_invar *= unit(*i, false);
+
+    std::vector<BDD> trans;
+    const CompilationUnits& fsm_trans
+        (f_algorithm.trans());
+    for (CompilationUnits::const_iterator i = fsm_trans.begin(); fsm_trans.end() != i; ++ i)
+        trans.push_back(unit(*i, true));
+
+    f_bad = unit(f_target, false);
+
+    setup_partitions(trans);
+
+    /* translation is over, the shared nodes are not needed anymore */
+    f_memo.clear();
+}
+
+void BDDReachability::setup_state()
+{
+    ExprMgr& em
+        (f_algorithm.em());
+
+    Cudd& shared
+        (f_enc.dd());
+
+    std::vector<BDDStateBit> bits;
+
+    SymbIter symbs
+        (f_algorithm.model());
+
+    while (symbs.has_next()) {
+
+        std::pair< Expr_ptr, Symbol_ptr> pair
+            (symbs.next());
+
+        Symbol_ptr symb
+            (pair.second);
+
+        if (! symb->is_variable())
+            continue;
+
+        Variable& var
+            (symb->as_variable());
+
+        if (var.is_input() ||
+            var.is_temp() ||
+            var.type()->is_instance())
+            continue;
+
+        Expr_ptr full
+            (em.make_dot(pair.first, var.name()));
+
+        f_state_vars.insert(std::pair<Expr_ptr, bool>(full, true));
+
+        if (var.is_frozen()) {
+            Encoding_ptr enc
+                (f_enc.find_encoding(TimedExpr(full, UINT_MAX)));
+
+            if (! enc)
+                continue;
+
+            const DDVector& dds
+                (enc->bits());
+
+            for (DDVector::const_iterator i = dds.begin(); dds.end() != i; ++ i) {
+                int index
+                    ((*i).getNode()->index);
+
+                bits.push_back(BDDStateBit(shared.ReadPerm(index), index, -1, true));
+            }
+
+            continue;
+        }
+
+        /* current and next state, either may be missing */
+        Encoding_ptr curr
+            (f_enc.find_encoding(TimedExpr(full, 0)));
+
+        Encoding_ptr next
+            (f_enc.find_encoding(TimedExpr(full, 1)));
+
+        if (! curr && ! next)
+            continue;
+
+        unsigned width
+            ((curr ? curr : next)->bits().size());
+
+        for (unsigned i = 0; i < width; ++ i) {
+            int curr_index
+                (curr ? curr->bits()[i].getNode()->index : -1);
+
+            int next_index
+                (next ? next->bits()[i].getNode()->index : -1);
+
+            bits.push_back(BDDStateBit(shared.ReadPerm(0 <= curr_index
+                                                       ? curr_index
+                                                       : next_index),
+                                       curr_index, next_index, false));
+        }
+    }
+
+    /* the initial order follows the shared manager */
+    std::stable_sort(bits.begin(), bits.end());
+
+    for (std::vector<BDDStateBit>::const_iterator i = bits.begin();
+         bits.end() != i; ++ i) {
+
+        if (i->frozen) {
+            BDD frozen
+                (new_var(BDD_FROZEN));
+
+            f_vars.insert(std::pair<int, BDD>(i->curr, frozen));
+            f_state.push_back(frozen);
+            continue;
+        }
+
+        BDD curr
+            (new_var(BDD_CURR));
+
+        BDD next
+            (new_var(BDD_NEXT));
+
+        /* current and next bits move together when reordering */
+        f_cudd.MakeTreeNode(curr.getNode()->index, 2, MTR_DEFAULT);
+
+        if (0 <= i->curr)
+            f_vars.insert(std::pair<int, BDD>(i->curr, curr));
+
+        if (0 <= i->next)
+            f_vars.insert(std::pair<int, BDD>(i->next, next));
+
+        f_state.push_back(curr);
+        f_curr.push_back(curr);
+        f_next.push_back(next);
+    }
+
+    unsigned nbits
+        (f_state.size());
+
+    DEBUG
+        << "BDD: "
+        << nbits
+        << " state bits"
+        << std::endl;
+}
+
+void BDDReachability::setup_partitions(std::vector<BDD>& trans)
+{
+    unsigned ntrans
+        (trans.size());
+
+    f_stats.trans = ntrans;
+
+    /* 1. current state vars of each TRANS */
+    std::vector< std::set<unsigned> > supports
+        (ntrans);
+    boost::unordered_map<unsigned, unsigned> occurrences;
+
+    for (unsigned i = 0; i < ntrans; ++ i) {
+        std::vector<unsigned> indexes
+            (trans[i].SupportIndices());
+
+        for (std::vector<unsigned>::const_iterator j = indexes.begin();
+             indexes.end() != j; ++ j)
+            if (BDD_CURR == f_kinds[*j]) {
+                supports[i].insert(*j);
+                ++ occurrences[*j];
+            }
+    }
+
+    /* 2. greedy schedule: next is the TRANS which allows the most
+       vars to be quantified, the smallest one on ties */
+    std::vector<unsigned> schedule;
+    std::vector<bool> scheduled
+        (ntrans, false);
+
+    while (schedule.size() < ntrans) {
+        int best
+            (-1);
+        unsigned best_score
+            (0);
+
+        for (unsigned i = 0; i < ntrans; ++ i) {
+            if (scheduled[i])
+                continue;
+
+            unsigned score
+                (0);
+
+            for (std::set<unsigned>::const_iterator j = supports[i].begin();
+                 supports[i].end() != j; ++ j)
+                if (1 == occurrences[*j])
+                    ++ score;
+
+            if (best < 0 || best_score < score ||
+                (best_score == score && supports[i].size() < supports[best].size())) {
+                best = i;
+                best_score = score;
+            }
+        }
+
+        scheduled[best] = true;
+        schedule.push_back(best);
+
+        for (std::set<unsigned>::const_iterator j = supports[best].begin();
+             supports[best].end() != j; ++ j)
+            -- occurrences[*j];
+    }
+
+    /* 3. clustering, in schedule order */
+    unsigned limit
+        (env_unsigned(BDD_CLUSTER_IDENTIFIER, 0, DEFAULT_BDD_CLUSTER));
+
+    for (std::vector<unsigned>::const_iterator i = schedule.begin();
+         schedule.end() != i; ++ i) {
+
+        if (! f_partitions.empty()) {
+            BDD cluster
+                (f_partitions.back() * trans[*i]);
+
+            if ((unsigned) cluster.nodeCount() <= limit) {
+                f_partitions.back() = cluster;
+                continue;
+            }
+        }
+
+        f_partitions.push_back(trans[*i]);
+    }
+
+    f_stats.partitions = f_partitions.size();
+
+    /* 4. current state vars are quantified after the last partition
+       depending on them */
+    boost::unordered_map<unsigned, unsigned> last;
+    for (unsigned i = 0; i < f_partitions.size(); ++ i) {
+        std::vector<unsigned> indexes
+            (f_partitions[i].SupportIndices());
+
+        for (std::vector<unsigned>::const_iterator j = indexes.begin();
+             indexes.end() != j; ++ j)
+            if (BDD_CURR == f_kinds[*j])
+                last[*j] = i;
+    }
+
+    f_quantify.assign(std::max<unsigned>(1, f_partitions.size()), f_cudd.bddOne());
+    for (std::vector<BDD>::const_iterator i = f_curr.begin(); f_curr.end() != i; ++ i) {
+        boost::unordered_map<unsigned, unsigned>::const_iterator eye
+            (last.find((*i).getNode()->index));
+
+        f_quantify[last.end() != eye ? eye->second : 0] *= *i;
+    }
+
+    unsigned npartitions
+        (f_stats.partitions);
+
+    DEBUG
+        << "BDD: "
+        << ntrans
+        << " TRANSes, "
+        << npartitions
+        << " partitions"
+        << std::endl;
+}
+
+BDD BDDReachability::new_var(bdd_var_t kind)
+{
+    BDD res
+        (f_cudd.bddVar());
+
+    assert(f_kinds.size() == res.getNode()->index);
+    f_kinds.push_back(kind);
+
+    return res;
+}
+
+BDD BDDReachability::var(int index)
+{
+    boost::unordered_map<int, BDD>::const_iterator eye
+        (f_vars.find(index));
+
+    if (f_vars.end() != eye)
+        return eye->second;
+
+    /* not a state bit, unless out of the current/next window */
+    const UCBI& ucbi
+        (f_enc.find_ucbi(index));
+
+    if (f_state_vars.end() != f_state_vars.find(ucbi.expr())) {
+        std::ostringstream oss;
+        oss
+            << "State bit "
+            << ucbi
+            << " is more than one step apart";
+
+        throw UnsupportedBDDModel(oss.str());
+    }
+
+    BDD res
+        (new_var(BDD_AUX));
+
+    f_vars.insert(std::pair<int, BDD>(index, res));
+
+    return res;
+}
+
+BDD BDDReachability::translate(const ADD& add)
+{
+    return translate(add.getNode());
+}
+
+/* shared nodes are only read, no shared DD is built here */
+BDD BDDReachability::translate(DdNode* node)
+{
+    if (cuddIsConstant(node))
+        return cuddV(node) ? f_cudd.bddOne() : f_cudd.bddZero();
+
+    boost::unordered_map<DdNode*, BDD, PtrHash, PtrEq>::const_iterator eye
+        (f_memo.find(node));
+
+    if (f_memo.end() != eye)
+        return eye->second;
+
+    BDD res
+        (var(node->index).Ite(translate(cuddT(node)),
+                              translate(cuddE(node))));
+
+    f_memo.insert(std::pair<DdNode*, BDD>(node, res));
+
+    return res;
+}
+
+BDD BDDReachability::unit(const CompilationUnit& cu, bool next)
+{
+    BDD res
+        (f_cudd.bddOne());
+
+    const DDVector& dds
+        (cu.dds());
+
+    for (DDVector::const_iterator i = dds.begin(); dds.end() != i; ++ i)
+        res *= translate(*i);
+
+    const InlinedOperatorDescriptors& inlined_operator_descriptors
+        (cu.inlined_operator_descriptors());
+
+    for (InlinedOperatorDescriptors::const_iterator i = inlined_operator_descriptors.begin();
+         inlined_operator_descriptors.end() != i; ++ i)
+        res *= inlined_operator(*i);
+
+    /* ITE muxes: act ? z = x : z = y */
+    const Expr2BinarySelectionDescriptorsMap& binary_selection_descriptors_map
+        (cu.binary_selection_descriptors_map());
+
+    for (Expr2BinarySelectionDescriptorsMap::const_iterator i = binary_selection_descriptors_map.begin();
+         binary_selection_descriptors_map.end() != i; ++ i) {
+
+        const BinarySelectionDescriptors& descriptors
+            (i->second);
+
+        for (BinarySelectionDescriptors::const_iterator j = descriptors.begin();
+             descriptors.end() != j; ++ j) {
+
+            BDD act
+                (translate(j->aux()));
+
+            for (unsigned k = 0; k < j->width(); ++ k) {
+                BDD z
+                    (translate(j->z()[k]));
+
+                res *= act.Ite(z.Xnor(translate(j->x()[k])),
+                               z.Xnor(translate(j->y()[k])));
+            }
+        }
+    }
+
+    /* array muxes: act_j -> z = x_j */
+    const MultiwaySelectionDescriptors& array_mux_descriptors
+        (cu.array_mux_descriptors());
+
+    for (MultiwaySelectionDescriptors::const_iterator i = array_mux_descriptors.begin();
+         array_mux_descriptors.end() != i; ++ i) {
+
+        unsigned width
+            (i->elem_width());
+
+        for (unsigned j = 0; j < i->elem_count(); ++ j) {
+            BDD act
+                (translate(i->acts()[j]));
+
+            for (unsigned k = 0; k < width; ++ k)
+                res *= ! act + translate(i->z()[k]).Xnor(translate(i->x()[k + j * width]));
+        }
+    }
+
+    /* auxiliary bits are functions of the state bits, they can be
+       quantified out of each unit on its own */
+    res = res.ExistAbstract(support_cube(res, BDD_AUX));
+
+    if (! next && ! support_cube(res, BDD_NEXT).IsOne())
+        throw UnsupportedBDDModel("Next state bits outside of TRANS");
+
+    return res;
+}
+
+BDD BDDReachability::inlined_operator(const InlinedOperatorDescriptor& md)
+{
+    const LitsVector& clauses
+        (InlinedOperatorMgr::INSTANCE()
+         .require(md.ios())
+         .clauses());
+
+    int width
+        (ios_width(md.ios()));
+
+    /* operand bits, cfr. CNFOperatorInliner::inject() */
+    std::vector<BDD> bits;
+    for (int i = 0; i < width; ++ i)
+        bits.push_back(translate(md.is_relational()
+                                 ? md.z()[0]
+                                 : md.z()[width - i - 1]));
+
+    for (int i = 0; i < width; ++ i)
+        bits.push_back(translate(md.x()[width - i - 1]));
+
+    if (md.is_binary())
+        for (int i = 0; i < width; ++ i)
+            bits.push_back(translate(md.y()[width - i - 1]));
+
+    /* microcode vars are quantified right after their last clause */
+    boost::unordered_map<int, unsigned> last;
+    for (unsigned i = 0; i < clauses.size(); ++ i)
+        for (Lits::const_iterator j = clauses[i].begin(); clauses[i].end() != j; ++ j) {
+            int ndx
+                (Minisat::var(*j) - 3 * width);
+
+            if (0 <= ndx) {
+                last[ndx] = i;
+
+                while (f_scratch.size() <= (unsigned) ndx)
+                    f_scratch.push_back(new_var(BDD_SCRATCH));
+            }
+        }
+
+    std::vector<BDD> quantify
+        (clauses.size(), f_cudd.bddOne());
+    for (boost::unordered_map<int, unsigned>::const_iterator i = last.begin();
+         last.end() != i; ++ i)
+        quantify[i->second] *= f_scratch[i->first];
+
+    BDD res
+        (f_cudd.bddOne());
+
+    for (unsigned i = 0; i < clauses.size(); ++ i) {
+        BDD clause
+            (f_cudd.bddZero());
+
+        for (Lits::const_iterator j = clauses[i].begin(); clauses[i].end() != j; ++ j) {
+            int lit_var
+                (Minisat::var(*j));
+
+            assert(lit_var < 3 * width + (int) f_scratch.size());
+            assert(3 * width <= lit_var || lit_var < (int) bits.size());
+
+            BDD bit
+                (lit_var < 3 * width
+                 ? bits[lit_var]
+                 : f_scratch[lit_var - 3 * width]);
+
+            clause += Minisat::sign(*j) ? ! bit : bit;
+        }
+
+        res = res.AndAbstract(clause, quantify[i]);
+    }
+
+    return res;
+}
+
+BDD BDDReachability::support_cube(const BDD& bdd, bdd_var_t kind)
+{
+    BDD res
+        (f_cudd.bddOne());
+
+    std::vector<unsigned> indexes
+        (bdd.SupportIndices());
+
+    for (std::vector<unsigned>::const_iterator i = indexes.begin();
+         indexes.end() != i; ++ i)
+        if (kind == f_kinds[*i])
+            res *= f_cudd.bddVar(*i);
+
+    return res;
+}
+
+BDD BDDReachability::image(const BDD& states)
+{
+    BDD res
+        (states);
+
+    if (f_partitions.empty())
+        res = res.ExistAbstract(f_quantify[0]);
+
+    else for (unsigned i = 0; i < f_partitions.size(); ++ i)
+        res = res.AndAbstract(f_partitions[i], f_quantify[i]);
+
+    ++ f_stats.images;
+
+    /* no current state var is left */
+    return res.SwapVariables(f_next, f_curr);
+}
+
+std::ostream& operator<<(std::ostream& os, const BDDReachability& bdd)
+{
+    const BDDStats& stats
+        (bdd.stats());
+
+    os
+        << stats.images
+        << " images, "
+        << stats.partitions << "/" << stats.trans
+        << " partitions, peak "
+        << stats.peak
+        << " nodes, "
+        << bdd.states()
+        << " states"
+        ;
+
+    return os;
+}
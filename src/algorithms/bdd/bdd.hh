@@ -0,0 +1,189 @@
+/**
+ * @file bdd/bdd.hh
+ * @brief BDD-based symbolic reachability, declarations.
+ *
+ * Compiled units are translated from the (shared) compiler DD
+ * manager into BDDs of a private manager: the shared manager is only
+ * read, so that SAT strategies running in parallel are not
+ * affected. Word-level operators and selections, which the SAT layer
+ * inlines as CNF, are translated from the same microcode clauses and
+ * descriptors, auxiliary variables are quantified out of each unit.
+ *
+ * Reachable states are computed breadth-first, from INIT. The
+ * transition relation is kept partitioned (one partition per TRANS,
+ * clustered up to `bdd_cluster` nodes) and current state variables
+ * are quantified out of the image as soon as no partition left
+ * depends on them. Frontiers are simplified within the states
+ * reached so far before each image.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef BDD_ALGORITHM_H
+#define BDD_ALGORITHM_H
+
+#include <functional>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <algorithms/base.hh>
+
+/** Raised when the model can not be encoded by BDDs, e.g. states
+    more than one step apart in a TRANS */
+class UnsupportedBDDModel : public AlgorithmException {
+public:
+    UnsupportedBDDModel(const std::string& message);
+};
+
+/* kinds of the private BDD variables */
+typedef enum {
+    BDD_CURR,
+    BDD_NEXT,
+    BDD_FROZEN,
+    BDD_AUX,     /* compiler auxiliary bits */
+    BDD_SCRATCH, /* microcode CNF variables */
+} bdd_var_t;
+
+struct BDDStats {
+    /* image computations */
+    unsigned images;
+
+    /* TRANS partitions, before and after clustering */
+    unsigned trans;
+    unsigned partitions;
+
+    /* largest reached states BDD, in nodes */
+    unsigned peak;
+
+    BDDStats()
+        : images(0)
+        , trans(0)
+        , partitions(0)
+        , peak(0)
+    {}
+};
+
+class BDDReachability {
+public:
+    /**
+     * @brief BDD reachability of target, for the FSM compiled by
+     * algorithm. Constraints hold in all states.
+     */
+    BDDReachability(Algorithm& algorithm, CompilationUnit& target,
+                    CompilationUnits& constraints);
+
+    ~BDDReachability();
+
+    /**
+     * @brief STATUS_SAT if target is reachable (cfr. depth()),
+     * STATUS_UNSAT if the fixpoint is reached with no target state,
+     * STATUS_UNKNOWN if interrupted (polled once per image).
+     */
+    status_t process(std::function<bool ()> interrupted);
+
+    /**
+     * @brief Length of the shortest path to target, after
+     * STATUS_SAT. Witnesses are to be extracted by plain BMC.
+     */
+    inline step_t depth() const
+    { return f_depth; }
+
+    /**
+     * @brief Number of reachable states found so far
+     */
+    double states() const;
+
+    inline const BDDStats& stats() const
+    { return f_stats; }
+
+private:
+    Algorithm& f_algorithm;
+
+    CompilationUnit& f_target;
+    CompilationUnits& f_constraints;
+
+    EncodingMgr& f_enc;
+
+    /* private manager, must outlive all the BDDs below */
+    Cudd f_cudd;
+
+    /* shared DD index -> private var */
+    boost::unordered_map<int, BDD> f_vars;
+
+    /* private var index -> kind */
+    std::vector<bdd_var_t> f_kinds;
+
+    /* scratch vars, reused by all the microcode injections */
+    std::vector<BDD> f_scratch;
+
+    /* state bits (frozen included), and current/next pairs */
+    std::vector<BDD> f_state;
+    std::vector<BDD> f_curr;
+    std::vector<BDD> f_next;
+
+    /* fully qualified state variables */
+    boost::unordered_map<Expr_ptr, bool, PtrHash, PtrEq> f_state_vars;
+
+    /* shared node -> BDD, cfr. translate() */
+    boost::unordered_map<DdNode*, BDD, PtrHash, PtrEq> f_memo;
+
+    BDD f_init;
+    BDD f_invar;
+    BDD f_bad;
+
+    /* clustered TRANS, and current state vars quantified after each
+       of them (f_quantify[0] also holds vars no partition depends
+       on) */
+    std::vector<BDD> f_partitions;
+    std::vector<BDD> f_quantify;
+
+    step_t f_depth;
+    BDD f_reached;
+    BDDStats f_stats;
+
+    void setup();
+    void setup_state();
+    void setup_partitions(std::vector<BDD>& trans);
+
+    BDD new_var(bdd_var_t kind);
+
+    /* private var for shared DD index */
+    BDD var(int index);
+
+    /* a 0-1 ADD of the shared manager, as a BDD */
+    BDD translate(DdNode* node);
+    BDD translate(const ADD& add);
+
+    /* all the constraints of a unit, with auxiliary vars quantified
+       out. Only current state vars are allowed unless next is true */
+    BDD unit(const CompilationUnit& cu, bool next);
+
+    BDD inlined_operator(const InlinedOperatorDescriptor& md);
+
+    /* cube of the vars of kind in the support of bdd */
+    BDD support_cube(const BDD& bdd, bdd_var_t kind);
+
+    /* states reachable from states in one step */
+    BDD image(const BDD& states);
+};
+
+std::ostream& operator<<(std::ostream& os, const BDDReachability& bdd);
+
+#endif /* BDD_ALGORITHM_H */
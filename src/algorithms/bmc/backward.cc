@@ -30,9 +30,10 @@
 // reserved for witnesses
 static const char *reach_trace_prfx ("reach_");
 
-void BMC::backward_strategy()
+void BMC::backward_strategy(const BMCJob& job)
 {
-    Engine engine { "backward" };
+    Engine engine { job.name, job.config };
+    SimplePath path;
     step_t k { 0 };
 
     /* goal state constraints */
@@ -122,6 +123,7 @@ void BMC::backward_strategy()
                 << std::endl ;
 
             engine.invert_last_group();
+            engine.finalize_last_group();
 
             /* unrolling next */
             ++ k;
@@ -133,10 +135,10 @@ void BMC::backward_strategy()
                               this->assert_formula(engine, k, cu);
                           });
 
-            /* build state uniqueness constraint for each pair of states
-               (j, k), where j < k */
-            for (step_t j = 0; j < k; ++ j)
-                assert_fsm_uniqueness(engine, UINT_MAX - j, UINT_MAX - k);
+            /* states on the path, cfr. solve_uniqueness() */
+            TimeVector times;
+            for (step_t j = 0; j <= k; ++ j)
+                times.push_back(UINT_MAX - j);
 
             /* is this still relevant? */
             if (sync_status() != BMC_UNKNOWN)
@@ -147,7 +149,7 @@ void BMC::backward_strategy()
                 << std::endl ;
 
             status_t status
-                (engine.solve());
+                (solve_uniqueness(engine, path, times));
 
             if (STATUS_UNKNOWN == status)
                 goto cleanup;
@@ -177,7 +179,7 @@ void BMC::backward_strategy()
  cleanup:
     /* signal other threads it's time to go home */
     EngineMgr::INSTANCE()
-        .interrupt();
+        .interrupt(this);
 
     INFO
         << engine
@@ -0,0 +1,96 @@
+/**
+ * @file bmc/bdd.cc
+ * @brief SAT-based BMC reachability algorithm, BDD strategy implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithms/bmc/bmc.hh>
+#include <algorithms/bdd/bdd.hh>
+
+void BMC::bdd_strategy(const BMCJob& job)
+{
+    BDDReachability bdd { *this, *f_target_cu, f_constraint_cus };
+
+    INFO
+        << "BDD: now computing reachable states..."
+        << std::endl;
+
+    status_t status
+        (STATUS_UNKNOWN);
+
+    try {
+        status = bdd.process([this]() {
+                return BMC_UNKNOWN != this->sync_status();
+            });
+    }
+    catch (UnsupportedBDDModel& ubm) {
+        pconst_char what
+            (ubm.what());
+
+        WARN
+            << what
+            << std::endl
+            << "BDD: giving up."
+            << std::endl;
+
+        free ((void *) what);
+        return;
+    }
+
+    INFO
+        << "BDD: "
+        << bdd
+        << std::endl;
+
+    if (STATUS_UNKNOWN == status)
+        goto cleanup;
+
+    else if (STATUS_UNSAT == status) {
+        INFO
+            << "BDD: fixpoint reached, target `"
+            << f_target
+            << "` is UNREACHABLE."
+            << std::endl;
+
+        sync_set_status(BMC_UNREACHABLE);
+    }
+
+    else if (STATUS_SAT == status) {
+        step_t k
+            (bdd.depth());
+
+        INFO
+            << "BDD: Reachability witness exists (k = " << k << "), target `"
+            << f_target
+            << "` is REACHABLE."
+            << std::endl;
+
+        /* the shortest path has k steps, BMC at depth k finds one */
+        if (sync_set_status(BMC_REACHABLE))
+            rebuild_witness(job, k);
+    }
+
+    else assert(false); /* unreachable */
+
+ cleanup:
+    /* signal other threads it's time to go home */
+    EngineMgr::INSTANCE()
+        .interrupt(this);
+} /* BMC::bdd_strategy() */
@@ -26,6 +26,10 @@
 #include <algorithms/bmc/bmc.hh>
 #include <algorithms/bmc/witness.hh>
 
+#include <cstring>
+#include <sstream>
+
+#include <boost/bind.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -33,15 +37,17 @@ BMC::BMC(Command& command, Model& model)
     : Algorithm(command, model)
     , f_target(NULL)
     , f_target_cu(NULL)
+    , f_neg_target_cu(NULL)
+    , f_uniqueness(BMC_UNIQUENESS_EAGER)
+    , f_strategies()
+    , f_threads(0)
+    , f_threads_set(false)
+    , f_sharing(false)
+    , f_induction_step(1)
 {
     const void* instance
         (this);
 
-    setup();
-
-    if (! ok())
-        throw FailedSetup();
-
     DRIVEL
         << "Created BMC @"
         << instance
@@ -67,6 +73,18 @@ void BMC::process(Expr_ptr target, ExprVector constraints)
     Expr_ptr ctx { em().make_empty() };
 
     try {
+        /* the model is compiled now that the target is known, only
+           its cone of influence is relevant */
+        ExprVector roots
+            (constraints);
+        roots.push_back(f_target);
+        roots.insert(roots.end(), f_lemmas.begin(), f_lemmas.end());
+
+        setup(roots);
+
+        if (! ok())
+            throw FailedSetup();
+
         unsigned nconstraints { 0 };
         std::for_each(begin(constraints),
                       end(constraints),
@@ -78,7 +96,7 @@ void BMC::process(Expr_ptr target, ExprVector constraints)
                               << std::endl;
 
                           CompilationUnit unit
-                              (compiler().process(ctx, expr));
+                              (mm().compile(ctx, expr));
 
                           f_constraint_cus.push_back(unit);
                           ++ nconstraints;
@@ -96,25 +114,60 @@ void BMC::process(Expr_ptr target, ExprVector constraints)
             << std::endl;
 
         CompilationUnit unit
-            (compiler().process(ctx, f_target));
+            (mm().compile(ctx, f_target));
 
         f_target_cu = &unit;
 
         /* fire up strategies */
         f_status = BMC_UNKNOWN;
-        boost::thread fwd(&BMC::forward_strategy, this);
-        boost::thread bwd(&BMC::backward_strategy, this);
 
-        /* falsification only */
-        boost::thread ffwd(&BMC::fast_forward_strategy, this);
-        boost::thread fbwd(&BMC::fast_backward_strategy, this);
+        BMCJobs jobs
+            (schedule());
+
+        /* k-induction also needs the negated target, and the lemmas */
+        bool kinduction
+            (std::any_of(begin(jobs),
+                         end(jobs),
+                         [](const BMCJob& job) {
+                             return BMC_KINDUCTION == job.strategy;
+                         }));
+
+        CompilationUnits neg_target_units;
+        if (kinduction) {
+            neg_target_units.push_back(mm()
+                                       .compile(ctx, em().make_not(f_target)));
+            f_neg_target_cu = &neg_target_units.back();
+
+            std::for_each(begin(f_lemmas),
+                          end(f_lemmas),
+                          [this, ctx](Expr_ptr expr) {
+                              INFO
+                                  << "Compiling lemma `"
+                                  << expr
+                                  << "` ..."
+                                  << std::endl;
+
+                              f_lemma_cus.push_back(mm()
+                                                    .compile(ctx, expr));
+                              f_neg_lemma_cus.push_back(mm()
+                                                        .compile(ctx, em().make_not(expr)));
+                          });
+        }
+
+        else if (! f_lemmas.empty())
+            WARN
+                << "No kinduction strategy scheduled, lemmas are ignored."
+                << std::endl;
+
+        boost::thread_group threads;
+        for (BMCJobs::const_iterator i = jobs.begin(); jobs.end() != i; ++ i)
+            threads.create_thread(boost::bind(&BMC::run, this, *i));
 
         /* wait for termination */
-        fwd.join();
-        bwd.join();
+        threads.join_all();
 
-        ffwd.join();
-        fbwd.join();
+        EngineMgr::INSTANCE()
+            .release(this);
     }
 
     catch (Exception& e) {
@@ -126,6 +179,179 @@ void BMC::process(Expr_ptr target, ExprVector constraints)
     }
 }
 
+BMCJobs BMC::schedule() const
+{
+    BMCStrategies strategies
+        (f_strategies);
+
+    if (strategies.empty()) {
+        strategies.push_back(BMCStrategy(BMC_FORWARD));
+        strategies.push_back(BMCStrategy(BMC_BACKWARD));
+        strategies.push_back(BMCStrategy(BMC_FAST_FORWARD));
+        strategies.push_back(BMCStrategy(BMC_FAST_BACKWARD));
+    }
+
+    unsigned nstrategies
+        (strategies.size());
+
+    unsigned nthreads
+        (nstrategies);
+
+    if (f_threads_set) {
+        nthreads = f_threads
+            ? f_threads
+            : boost::thread::hardware_concurrency();
+
+        if (! nthreads)
+            nthreads = nstrategies;
+    }
+
+    if (nthreads < nstrategies)
+        WARN
+            << "Only " << nthreads << " threads available, "
+            << "running the first " << nthreads << " strategies only."
+            << std::endl;
+
+    bool complete
+        (false);
+
+    BMCJobs res;
+    for (unsigned i = 0; i < nthreads; ++ i) {
+        const BMCStrategy& strategy
+            (strategies[i % nstrategies]);
+
+        /* i-th copy of the strategy, copies differ by seed */
+        unsigned copy
+            (i / nstrategies);
+
+        std::ostringstream oss;
+        oss
+            << bmc_strategy_name(strategy.strategy);
+        if (copy)
+            oss
+                << "#" << copy;
+
+        BMCJob job;
+        job.strategy = strategy.strategy;
+        job.name = oss.str();
+        job.config.backend = strategy.backend;
+        job.config.seed = strategy.seed + copy;
+        job.config.owner = this;
+
+        /* forward and fast_forward (resp. backward and fast_backward)
+           unroll the same time frames, and whatever either of them
+           learns holds on any shortest witness: they can share learned
+           clauses (cfr. ClauseExchange). So does the base case of
+           kinduction, in the forward time base. IC3 frames are not
+           unrollings, ic3 never shares. Neither does bdd, which has no
+           SAT engine. */
+        if (f_sharing &&
+            BMC_IC3 != strategy.strategy &&
+            BMC_BDD != strategy.strategy)
+            job.config.exchange =
+                (BMC_FORWARD == strategy.strategy ||
+                 BMC_FAST_FORWARD == strategy.strategy ||
+                 BMC_KINDUCTION == strategy.strategy)
+                ? "forward" : "backward";
+
+        res.push_back(job);
+
+        if (BMC_FORWARD == strategy.strategy ||
+            BMC_BACKWARD == strategy.strategy ||
+            BMC_IC3 == strategy.strategy ||
+            BMC_KINDUCTION == strategy.strategy ||
+            BMC_BDD == strategy.strategy)
+            complete = true;
+    }
+
+    if (! complete)
+        WARN
+            << "No forward, backward, ic3, kinduction or bdd strategy scheduled, "
+            << "unreachability can not be proved."
+            << std::endl;
+
+    unsigned njobs
+        (res.size());
+
+    INFO
+        << "Scheduled "
+        << njobs
+        << " BMC strategy instances"
+        << std::endl;
+
+    return res;
+}
+
+void BMC::run(BMCJob job)
+{
+    DEBUG
+        << "Starting `"
+        << job.name
+        << "` (seed "
+        << job.config.seed
+        << ")"
+        << std::endl;
+
+    switch (job.strategy) {
+    case BMC_FORWARD:
+        forward_strategy(job);
+        break;
+
+    case BMC_BACKWARD:
+        backward_strategy(job);
+        break;
+
+    case BMC_FAST_FORWARD:
+        fast_forward_strategy(job);
+        break;
+
+    case BMC_FAST_BACKWARD:
+        fast_backward_strategy(job);
+        break;
+
+    case BMC_IC3:
+        ic3_strategy(job);
+        break;
+
+    case BMC_KINDUCTION:
+        kinduction_strategy(job);
+        break;
+
+    case BMC_BDD:
+        bdd_strategy(job);
+        break;
+
+    default: assert(false); /* unreachable */
+    } /* switch() */
+}
+
+static const char* BMC_STRATEGY_NAMES[] = {
+    "forward",
+    "backward",
+    "fast_forward",
+    "fast_backward",
+    "ic3",
+    "kinduction",
+    "bdd",
+};
+
+const char* bmc_strategy_name(bmc_strategy_t strategy)
+{
+    return BMC_STRATEGY_NAMES[strategy];
+}
+
+bool bmc_strategy_from_name(const char* name, bmc_strategy_t& strategy)
+{
+    for (unsigned i = 0; i < sizeof(BMC_STRATEGY_NAMES) /
+             sizeof(BMC_STRATEGY_NAMES[0]); ++ i)
+        if (! strcmp(name, BMC_STRATEGY_NAMES[i])) {
+            strategy = (bmc_strategy_t) i;
+            return true;
+        }
+
+    return false;
+}
+
 /* synchronized */
 reachability_status_t BMC::sync_status()
 {
@@ -153,3 +379,64 @@ bool BMC::sync_set_status(reachability_status_t status)
 
     return res;
 }
+
+status_t BMC::solve_uniqueness(Engine& engine, SimplePath& path,
+                               const TimeVector& times, unsigned fresh)
+{
+    assert(0 < fresh && fresh <= times.size());
+
+    switch (f_uniqueness) {
+    case BMC_UNIQUENESS_EAGER:
+        /* build state uniqueness constraint for each pair of states
+           (j, k), where j < k and k is fresh */
+        for (TimeVector::const_iterator k = times.end() - fresh;
+             times.end() != k; ++ k)
+            for (TimeVector::const_iterator j = times.begin(); k != j; ++ j)
+                assert_fsm_uniqueness(engine, *j, *k);
+
+        return engine.solve();
+
+    case BMC_UNIQUENESS_LAZY:
+        {
+            /* pairs added in previous rounds still hold */
+            for (TimeVector::const_iterator t = times.begin();
+                 times.end() != t; ++ t)
+                alloc_fsm_state(engine, *t);
+
+            status_t status;
+            unsigned npairs;
+
+            do {
+                status = engine.solve();
+                if (STATUS_SAT != status || sync_status() != BMC_UNKNOWN)
+                    break;
+
+                npairs = refine_fsm_uniqueness(engine, times);
+
+                DEBUG
+                    << npairs
+                    << " uniqueness constraints added"
+                    << std::endl;
+
+            } while (0 < npairs);
+
+            return status;
+        }
+
+    case BMC_UNIQUENESS_SORTING:
+        /* the states not in path yet are added to it, cfr.
+           extend_fsm_simple_path() */
+        for (TimeVector::const_iterator t = times.begin() + path.size();
+             times.end() != t; ++ t)
+            extend_fsm_simple_path(engine, path, *t);
+
+        return engine.solve();
+
+    case BMC_UNIQUENESS_NONE:
+        return engine.solve();
+
+    default: assert(false); /* unreachable */
+    } /* switch() */
+
+    return STATUS_UNKNOWN;
+}
@@ -24,9 +24,45 @@
 #ifndef BMC_ALGORITHM_H
 #define BMC_ALGORITHM_H
 
+#include <string>
+#include <vector>
+
 #include <algorithms/base.hh>
 #include <algorithms/bmc/typedefs.hh>
 
+/* Strategy names, as accepted by `reach -s` */
+const char* bmc_strategy_name(bmc_strategy_t strategy);
+bool bmc_strategy_from_name(const char* name, bmc_strategy_t& strategy);
+
+/* A strategy in the portfolio, cfr. `reach -s` */
+struct BMCStrategy {
+    bmc_strategy_t strategy;
+
+    /* solver seed (0 for default) and SAT backend (empty for default)
+       for the engine, cfr. EngineConfig */
+    unsigned seed;
+    std::string backend;
+
+    BMCStrategy(bmc_strategy_t strategy_,
+                unsigned seed_ = 0,
+                const std::string& backend_ = "")
+        : strategy(strategy_)
+        , seed(seed_)
+        , backend(backend_)
+    {}
+};
+
+typedef std::vector<BMCStrategy> BMCStrategies;
+
+/* A scheduled strategy instance, one for each thread */
+struct BMCJob {
+    bmc_strategy_t strategy;
+    std::string name;
+    EngineConfig config;
+};
+
+typedef std::vector<BMCJob> BMCJobs;
+
 class BMC : public Algorithm {
 
 public:
@@ -35,6 +71,34 @@ public:
 
     void process(Expr_ptr target, ExprVector constraints);
 
+    inline void set_uniqueness(uniqueness_mode_t mode)
+    { f_uniqueness = mode; }
+
+    /* Portfolio: strategies are run in the given order, by default all
+       of them are. With spare threads, diversified copies (different
+       seeds) are run round robin. */
+    inline void add_strategy(const BMCStrategy& strategy)
+    { f_strategies.push_back(strategy); }
+
+    /* Thread budget, 0 for one thread per core. By default, one
+       thread per strategy. */
+    inline void set_threads(unsigned threads)
+    { f_threads = threads; f_threads_set = true; }
+
+    /* Learned clauses sharing among strategies with the same time
+       base (forward and fast_forward, backward and fast_backward) */
+    inline void set_sharing(bool sharing)
+    { f_sharing = sharing; }
+
+    /* k-induction: the induction depth grows by step at each round */
+    inline void set_induction_step(unsigned step)
+    { assert(0 < step); f_induction_step = step; }
+
+    /* k-induction: a candidate invariant, used to strengthen the
+       induction step once proved inductive (cfr. prove_lemmas()) */
+    inline void add_lemma(Expr_ptr lemma)
+    { f_lemmas.push_back(lemma); }
+
     inline reachability_status_t status()
     { return sync_status(); }
 
@@ -48,15 +112,54 @@ private:
     ExprVector f_constraints;
     CompilationUnits f_constraint_cus;
 
+    /* k-induction only, compiled if a kinduction job is scheduled */
+    CompilationUnit_ptr f_neg_target_cu;
+
+    ExprVector f_lemmas;
+    CompilationUnits f_lemma_cus;
+    CompilationUnits f_neg_lemma_cus;
+
     boost::mutex f_status_mutex;
     reachability_status_t f_status;
 
+    uniqueness_mode_t f_uniqueness;
+
+    BMCStrategies f_strategies;
+    unsigned f_threads;
+    bool f_threads_set;
+    bool f_sharing;
+    unsigned f_induction_step;
+
+    /* portfolio scheduling, losers are cancelled via EngineMgr with
+       this BMC instance as the cancellation scope. */
+    BMCJobs schedule() const;
+    void run(BMCJob job);
+
+    /* looks for a simple path through the states at times, with the
+       selected uniqueness mode. The last fresh states in times are new
+       since the previous call on engine; path holds the states and the
+       sorting network built on engine so far (sorting mode only). */
+    status_t solve_uniqueness(Engine& engine, SimplePath& path,
+                              const TimeVector& times, unsigned fresh = 1);
+
+    /* Houdini: clears in proven the lemmas not in the greatest subset
+       of f_lemmas that is inductive, false if interrupted. */
+    bool prove_lemmas(const BMCJob& job, std::vector<bool>& proven);
+
     /* strategies */
-    void forward_strategy();
-    void backward_strategy();
+    void forward_strategy(const BMCJob& job);
+    void backward_strategy(const BMCJob& job);
+
+    void fast_forward_strategy(const BMCJob& job);
+    void fast_backward_strategy(const BMCJob& job);
+
+    void ic3_strategy(const BMCJob& job);
+    void kinduction_strategy(const BMCJob& job);
+    void bdd_strategy(const BMCJob& job);
 
-    void fast_forward_strategy();
-    void fast_backward_strategy();
+    /* strategies proving reachability at depth k with no path (ic3,
+       bdd) rebuild the witness by plain BMC */
+    void rebuild_witness(const BMCJob& job, step_t k);
 };
 
 #endif /* BMC_ALGORITHM_CLASSES_H */
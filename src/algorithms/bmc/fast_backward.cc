@@ -30,9 +30,9 @@
 // reserved for witnesses
 static const char *reach_trace_prfx ("reach_");
 
-void BMC::fast_backward_strategy()
+void BMC::fast_backward_strategy(const BMCJob& job)
 {
-    Engine engine { "fast_backward" };
+    Engine engine { job.name, job.config };
     step_t k { 0 };
 
     /* goal state constraints */
@@ -122,6 +122,7 @@ void BMC::fast_backward_strategy()
                 << std::endl ;
 
             engine.invert_last_group();
+            engine.finalize_last_group();
 
             /* unrolling next */
             ++ k;
@@ -143,7 +144,7 @@ void BMC::fast_backward_strategy()
  cleanup:
     /* signal other threads it's time to go home */
     EngineMgr::INSTANCE()
-        .interrupt();
+        .interrupt(this);
 
     INFO
         << engine
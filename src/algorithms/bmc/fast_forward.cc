@@ -32,9 +32,9 @@
 // reserved for witnesses
 static const char *reach_trace_prfx ("reach_");
 
-void BMC::fast_forward_strategy()
+void BMC::fast_forward_strategy(const BMCJob& job)
 {
-    Engine engine { "fast_forward" };
+    Engine engine { job.name, job.config };
     step_t k  { 0 };
 
     /* initial constraints */
@@ -129,6 +129,7 @@ void BMC::fast_forward_strategy()
                 << std::endl ;
 
             engine.invert_last_group();
+            engine.finalize_last_group();
 
             /* unrolling next */
             assert_fsm_trans(engine, k);
@@ -145,7 +146,7 @@ void BMC::fast_forward_strategy()
  cleanup:
     /* signal other threads it's time to go home */
     EngineMgr::INSTANCE()
-        .interrupt();
+        .interrupt(this);
 
     INFO
         << engine
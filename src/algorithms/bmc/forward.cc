@@ -32,9 +32,10 @@
 // reserved for witnesses
 static const char *reach_trace_prfx ("reach_");
 
-void BMC::forward_strategy()
+void BMC::forward_strategy(const BMCJob& job)
 {
-    Engine engine { "forward" };
+    Engine engine { job.name, job.config };
+    SimplePath path;
     step_t k  { 0 };
 
     /* initial constraints */
@@ -129,6 +130,7 @@ void BMC::forward_strategy()
                 << std::endl ;
 
             engine.invert_last_group();
+            engine.finalize_last_group();
 
             /* unrolling next */
             assert_fsm_trans(engine, k);
@@ -140,10 +142,10 @@ void BMC::forward_strategy()
                               this->assert_formula(engine, k, cu);
                           });
 
-            /* build state uniqueness constraint for each pair of states
-               (j, k), where j < k */
-            for (step_t j = 0; j < k; ++ j)
-                assert_fsm_uniqueness(engine, j, k);
+            /* states on the path, cfr. solve_uniqueness() */
+            TimeVector times;
+            for (step_t j = 0; j <= k; ++ j)
+                times.push_back(j);
 
             /* is this still relevant? */
             if (sync_status() != BMC_UNKNOWN)
@@ -154,7 +156,7 @@ void BMC::forward_strategy()
                 << std::endl ;
 
             status_t status
-                (engine.solve());
+                (solve_uniqueness(engine, path, times));
 
             if (STATUS_UNKNOWN == status)
                 goto cleanup;
@@ -185,7 +187,7 @@ void BMC::forward_strategy()
  cleanup:
     /* signal other threads it's time to go home */
     EngineMgr::INSTANCE()
-        .interrupt();
+        .interrupt(this);
 
     INFO
         << engine
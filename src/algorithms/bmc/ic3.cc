@@ -0,0 +1,154 @@
+/**
+ * @file bmc/ic3.cc
+ * @brief SAT-based BMC reachability algorithm, IC3 strategy implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithms/bmc/bmc.hh>
+#include <algorithms/bmc/witness.hh>
+#include <algorithms/ic3/ic3.hh>
+
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+// reserved for witnesses
+static const char *reach_trace_prfx ("reach_");
+
+void BMC::ic3_strategy(const BMCJob& job)
+{
+    Engine engine { job.name, job.config };
+
+    IC3 ic3 { *this, engine, *f_target_cu, f_constraint_cus };
+
+    INFO
+        << "IC3: now looking for an inductive invariant..."
+        << std::endl;
+
+    status_t status
+        (ic3.process());
+
+    INFO
+        << "IC3: "
+        << ic3
+        << std::endl;
+
+    if (STATUS_UNKNOWN == status)
+        goto cleanup;
+
+    else if (STATUS_UNSAT == status) {
+        unsigned invariant_size
+            (ic3.invariant_size());
+
+        INFO
+            << "IC3: found inductive invariant ("
+            << invariant_size
+            << " clauses), target `"
+            << f_target
+            << "` is UNREACHABLE."
+            << std::endl;
+
+        sync_set_status(BMC_UNREACHABLE);
+    }
+
+    else if (STATUS_SAT == status) {
+        step_t k
+            (ic3.depth());
+
+        INFO
+            << "IC3: Reachability witness exists (k = " << k << "), target `"
+            << f_target
+            << "` is REACHABLE."
+            << std::endl;
+
+        /* IC3 states do not make a path */
+        if (sync_set_status(BMC_REACHABLE))
+            rebuild_witness(job, k);
+    }
+
+    else assert(false); /* unreachable */
+
+ cleanup:
+    /* signal other threads it's time to go home */
+    EngineMgr::INSTANCE()
+        .interrupt(this);
+
+    INFO
+        << engine
+        << std::endl;
+} /* BMC::ic3_strategy() */
+
+void BMC::rebuild_witness(const BMCJob& job, step_t k)
+{
+    /* This engine is not in the cancellation scope: losers may still
+       be signalling. */
+    EngineConfig config
+        (job.config);
+    config.owner = NULL;
+    config.exchange.clear();
+
+    Engine bmc_engine { job.name + "/witness", config };
+
+    for (step_t j = 0; j <= k; ++ j) {
+        if (0 == j)
+            assert_fsm_init(bmc_engine, j);
+        else
+            assert_fsm_trans(bmc_engine, j - 1);
+
+        assert_fsm_invar(bmc_engine, j);
+        std::for_each(begin(f_constraint_cus),
+                      end(f_constraint_cus),
+                      [this, &bmc_engine, j](CompilationUnit& cu) {
+                          this->assert_formula(bmc_engine, j, cu);
+                      });
+    }
+    assert_formula(bmc_engine, k, *f_target_cu);
+
+    status_t bmc_status
+        (bmc_engine.solve());
+    assert(STATUS_SAT == bmc_status);
+
+    /* Extract reachability witness */
+    WitnessMgr& wm
+        (WitnessMgr::INSTANCE());
+
+    Witness& w
+        (* new BMCCounterExample(f_target, model(), bmc_engine, k));
+
+    /* witness identifier */
+    std::ostringstream oss_id;
+    oss_id
+        << reach_trace_prfx
+        << wm.autoincrement();
+    w.set_id(oss_id.str());
+
+    /* witness description */
+    std::ostringstream oss_desc;
+    oss_desc
+        << "Reachability witness for target `"
+        << f_target
+        << "` in module `"
+        << model().main_module().name()
+        << "`" ;
+    w.set_desc(oss_desc.str());
+
+    wm.record(w);
+    wm.set_current(w);
+    set_witness(w);
+} /* BMC::rebuild_witness() */
@@ -0,0 +1,406 @@
+/**
+ * @file bmc/kinduction.cc
+ * @brief SAT-based BMC reachability algorithm, k-induction strategy implementation.
+ *
+ * Two engines are extended incrementally, side by side. The base case
+ * engine unrolls paths from INIT in the forward time base, looking for
+ * a witness at each depth. The induction step engine unrolls paths
+ * backwards from the target (no INIT), in which no state but the last
+ * one satisfies the target. Once the base case has been checked up to
+ * depth k - 1, if no such path of k steps exists the target is
+ * unreachable: the last k steps of a shortest witness would make one.
+ *
+ * Unlike forward and backward, which need the simple path check to
+ * fail at the recurrence diameter, the induction step only needs to
+ * fail at the induction depth of the target, which is often far
+ * smaller. Simple path constraints (cfr. `reach -u`) make it complete,
+ * at a cost; candidate invariants (cfr. `reach -l`) which are proved
+ * inductive are asserted in each state of the induction step, and
+ * make it stronger.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+
+#include <algorithms/bmc/bmc.hh>
+#include <algorithms/bmc/witness.hh>
+
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+// reserved for witnesses
+static const char *reach_trace_prfx ("reach_");
+
+bool BMC::prove_lemmas(const BMCJob& job, std::vector<bool>& proven)
+{
+    unsigned nlemmas
+        (f_lemma_cus.size());
+
+    proven.assign(nlemmas, true);
+    if (! nlemmas)
+        return true;
+
+    /* a single engine for all the queries, INIT and TRANS (along with
+       the next state) are guarded by activation vars, and so is each
+       lemma at time 0, and its negation at times 0 and 1. */
+    EngineConfig config
+        (job.config);
+    config.exchange.clear();
+
+    Engine engine { job.name + "/lemmas", config };
+
+    Var init_act
+        (engine.new_sat_var(true));
+    assert_fsm_init(engine, 0, init_act);
+    assert_fsm_invar(engine, 0);
+    std::for_each(begin(f_constraint_cus),
+                  end(f_constraint_cus),
+                  [this, &engine](CompilationUnit& cu) {
+                      this->assert_formula(engine, 0, cu);
+                  });
+
+    Var trans_act
+        (engine.new_sat_var(true));
+    assert_fsm_trans(engine, 0, trans_act);
+    assert_fsm_invar(engine, 1, trans_act);
+    std::for_each(begin(f_constraint_cus),
+                  end(f_constraint_cus),
+                  [this, &engine, trans_act](CompilationUnit& cu) {
+                      this->assert_formula(engine, 1, cu, trans_act);
+                  });
+
+    VarVector acts;
+    VarVector neg_acts;
+    VarVector next_neg_acts;
+    for (unsigned i = 0; i < nlemmas; ++ i) {
+        acts.push_back(engine.new_sat_var(true));
+        assert_formula(engine, 0, f_lemma_cus[i], acts.back());
+
+        neg_acts.push_back(engine.new_sat_var(true));
+        assert_formula(engine, 0, f_neg_lemma_cus[i], neg_acts.back());
+
+        next_neg_acts.push_back(engine.new_sat_var(true));
+        assert_formula(engine, 1, f_neg_lemma_cus[i], next_neg_acts.back());
+    }
+
+    /* initiation: INIT & !L is UNSAT */
+    for (unsigned i = 0; i < nlemmas; ++ i) {
+        vec<Lit> assumptions;
+        assumptions.push( mkLit( init_act, false));
+        assumptions.push( mkLit( neg_acts[i], false));
+
+        status_t status
+            (engine.solve(assumptions));
+
+        if (STATUS_UNKNOWN == status)
+            return false;
+
+        if (STATUS_SAT == status) {
+            INFO
+                << "K-induction: lemma `"
+                << f_lemmas[i]
+                << "` does not hold in INIT, dropped."
+                << std::endl;
+
+            proven[i] = false;
+        }
+    }
+
+    /* consecution: Ls & TRANS & !L' is UNSAT, for each L in Ls. Lemmas
+       failing it are dropped, until a fixpoint is reached. */
+    bool fixpoint;
+    do {
+        fixpoint = true;
+
+        for (unsigned i = 0; i < nlemmas; ++ i) {
+            if (! proven[i])
+                continue;
+
+            vec<Lit> assumptions;
+            assumptions.push( mkLit( trans_act, false));
+            for (unsigned j = 0; j < nlemmas; ++ j)
+                if (proven[j])
+                    assumptions.push( mkLit( acts[j], false));
+            assumptions.push( mkLit( next_neg_acts[i], false));
+
+            status_t status
+                (engine.solve(assumptions));
+
+            if (STATUS_UNKNOWN == status)
+                return false;
+
+            if (STATUS_SAT == status) {
+                INFO
+                    << "K-induction: lemma `"
+                    << f_lemmas[i]
+                    << "` is not inductive, dropped."
+                    << std::endl;
+
+                proven[i] = false;
+                fixpoint = false;
+            }
+        }
+    } while (! fixpoint);
+
+    return true;
+}
+
+void BMC::kinduction_strategy(const BMCJob& job)
+{
+    /* the base case unrolls the forward time base, and may share
+       learned clauses (cfr. schedule()). Clauses learned by the
+       induction step do not hold on witnesses, it never shares. */
+    EngineConfig step_config
+        (job.config);
+    step_config.exchange.clear();
+
+    Engine base { job.name + "/base", job.config };
+    Engine step { job.name + "/step", step_config };
+    SimplePath path;
+
+    /* no witness of less than k steps exists */
+    step_t k { 0 };
+
+    /* the induction step holds paths of depth steps, through the
+       states at times */
+    step_t depth { 0 };
+    TimeVector times;
+
+    std::vector<bool> proven;
+    status_t status;
+
+    /* states in the induction step, with the proved lemmas */
+    auto assert_step_state = [this, &step, &proven](step_t time) {
+        this->assert_fsm_invar(step, time);
+        std::for_each(begin(f_constraint_cus),
+                      end(f_constraint_cus),
+                      [this, &step, time](CompilationUnit& cu) {
+                          this->assert_formula(step, time, cu);
+                      });
+
+        for (unsigned i = 0; i < proven.size(); ++ i)
+            if (proven[i])
+                this->assert_formula(step, time, f_lemma_cus[i]);
+    };
+
+    if (! prove_lemmas(job, proven))
+        goto cleanup;
+
+    /* initial constraints */
+    assert_fsm_init(base, k);
+    assert_fsm_invar(base, k);
+    std::for_each(begin(f_constraint_cus),
+                  end(f_constraint_cus),
+                  [this, &base, k](CompilationUnit& cu) {
+                      this->assert_formula(base, k, cu);
+                  });
+
+    status = base.solve();
+
+    if (STATUS_UNKNOWN == status)
+        goto cleanup;
+
+    else if (STATUS_UNSAT == status) {
+        INFO
+            << "K-induction: Empty initial states. Target is trivially UNREACHABLE."
+            << std::endl;
+
+        sync_set_status(BMC_UNREACHABLE);
+        goto cleanup;
+    }
+
+    else if (STATUS_SAT == status)
+        INFO
+            << "K-induction: INIT consistency check ok."
+            << std::endl;
+
+    else assert(false); /* unreachable */
+
+    /* goal state constraints */
+    assert_formula(step, UINT_MAX, *f_target_cu);
+    assert_step_state(UINT_MAX);
+    times.push_back(UINT_MAX);
+
+    status = step.solve();
+
+    if (STATUS_UNKNOWN == status)
+        goto cleanup;
+
+    else if (STATUS_UNSAT == status) {
+        INFO
+            << "K-induction: empty final states. Target is trivially UNREACHABLE."
+            << std::endl;
+
+        sync_set_status(BMC_UNREACHABLE);
+        goto cleanup;
+    }
+
+    else if (STATUS_SAT == status)
+        INFO
+            << "K-induction: GOAL consistency check ok."
+            << std::endl;
+
+    else assert(false); /* unreachable */
+
+    do {
+        /* base case, for the next f_induction_step depths */
+        for (unsigned i = 0; i < f_induction_step; ++ i) {
+
+            /* looking for witness : BMC(k-1) ^ P(k) */
+            assert_formula(base, k, *f_target_cu, base.new_group());
+
+            INFO
+                << "K-induction: now looking for reachability witness (k = " << k << ")..."
+                << std::endl ;
+
+            status = base.solve();
+
+            if (STATUS_UNKNOWN == status)
+                goto cleanup;
+
+            else if (STATUS_SAT == status) {
+                INFO
+                    << "K-induction: Reachability witness exists (k = " << k << "), target `"
+                    << f_target
+                    << "` is REACHABLE."
+                    << std::endl;
+
+                if (sync_set_status(BMC_REACHABLE)) {
+
+                    /* Extract reachability witness */
+                    WitnessMgr& wm
+                        (WitnessMgr::INSTANCE());
+
+                    Witness& w
+                        (* new BMCCounterExample(f_target, model(), base, k));
+
+                    /* witness identifier */
+                    std::ostringstream oss_id;
+                    oss_id
+                        << reach_trace_prfx
+                        << wm.autoincrement();
+                    w.set_id(oss_id.str());
+
+                    /* witness description */
+                    std::ostringstream oss_desc;
+                    oss_desc
+                        << "Reachability witness for target `"
+                        << f_target
+                        << "` in module `"
+                        << model().main_module().name()
+                        << "`" ;
+                    w.set_desc(oss_desc.str());
+
+                    wm.record(w);
+                    wm.set_current(w);
+                    set_witness(w);
+                }
+
+                goto cleanup;
+            }
+
+            else if (STATUS_UNSAT == status)
+                INFO
+                    << "K-induction: no reachability witness found (k = " << k << ")..."
+                    << std::endl ;
+
+            else assert(false); /* unreachable */
+
+            base.invert_last_group();
+            base.finalize_last_group();
+
+            /* unrolling next */
+            assert_fsm_trans(base, k);
+            ++ k;
+            assert_fsm_invar(base, k);
+            std::for_each(begin(f_constraint_cus),
+                          end(f_constraint_cus),
+                          [this, &base, k](CompilationUnit& cu) {
+                              this->assert_formula(base, k, cu);
+                          });
+        }
+
+        /* is this still relevant? */
+        if (sync_status() != BMC_UNKNOWN)
+            goto cleanup;
+
+        /* induction step, extended up to depth k : !P(-k) ^ ... ^
+           !P(-1) ^ P(0) */
+        {
+            unsigned fresh
+                (k - depth);
+
+            while (depth < k) {
+                ++ depth;
+
+                step_t time
+                    (UINT_MAX - depth);
+
+                assert_fsm_trans(step, time);
+                assert_formula(step, time, *f_neg_target_cu);
+                assert_step_state(time);
+                times.push_back(time);
+            }
+
+            INFO
+                << "K-induction: now looking for induction proof (k = " << k << ")..."
+                << std::endl ;
+
+            status = solve_uniqueness(step, path, times, fresh);
+        }
+
+        if (STATUS_UNKNOWN == status)
+            goto cleanup;
+
+        else if (STATUS_UNSAT == status) {
+            INFO
+                << "K-induction: found induction proof (k = " << k << ")"
+                << std::endl;
+
+            sync_set_status(BMC_UNREACHABLE);
+            goto cleanup;
+        }
+
+        else if (STATUS_SAT == status)
+            INFO
+                << "K-induction: no induction proof found (k = " << k << ")"
+                << std::endl;
+
+        else assert(false); /* unreachable */
+
+        TRACE
+            << "K-induction: done with k = " << k << "..."
+            << std::endl ;
+
+    } while (sync_status() == BMC_UNKNOWN);
+
+ cleanup:
+    /* signal other threads it's time to go home */
+    EngineMgr::INSTANCE()
+        .interrupt(this);
+
+    INFO
+        << base
+        << std::endl;
+
+    INFO
+        << step
+        << std::endl;
+} /* BMC::kinduction_strategy() */
@@ -31,4 +31,23 @@ typedef enum {
     BMC_ERROR,
 } reachability_status_t;
 
+/* BMC strategies, selected with `reach -s <strategy>,...` */
+typedef enum {
+    BMC_FORWARD,
+    BMC_BACKWARD,
+    BMC_FAST_FORWARD,  /* falsification only */
+    BMC_FAST_BACKWARD, /* falsification only */
+    BMC_IC3,           /* IC3/PDR, cfr. algorithms/ic3 */
+    BMC_KINDUCTION,    /* k-induction, cfr. kinduction.cc */
+    BMC_BDD,           /* BDD reachability, cfr. algorithms/bdd */
+} bmc_strategy_t;
+
+/* simple path constraints, selected with `reach -u <mode>` */
+typedef enum {
+    BMC_UNIQUENESS_EAGER,   /* `eager`, all pairs of states, default */
+    BMC_UNIQUENESS_LAZY,    /* `lazy`, only pairs found equal in a model */
+    BMC_UNIQUENESS_SORTING, /* `sorting`, sorting network */
+    BMC_UNIQUENESS_NONE,    /* `none`, paths need not be simple */
+} uniqueness_mode_t;
+
 #endif /* BMC_ALGORITHM_TYPEDEFS_H */
@@ -29,8 +29,7 @@
 #include <algorithms/bmc/bmc.hh>
 #include <algorithms/bmc/witness.hh>
 
-#include <symb/symb_iter.hh>
-
+#include <witness/extractor.hh>
 #include <witness/witness.hh>
 #include <witness/witness_mgr.hh>
 
@@ -38,28 +37,32 @@ BMCCounterExample::BMCCounterExample(Expr_ptr property, Model& model,
                                      Engine& engine, unsigned k, bool reversed)
     : Witness()
 {
-    EncodingMgr& bm
-        (EncodingMgr::INSTANCE());
-
     ExprMgr& em
         (ExprMgr::INSTANCE());
 
-    /* Collecting symbols for the witness' language */
-    SymbIter si (model);
-    while (si.has_next()) {
-        std::pair <Expr_ptr, Symbol_ptr> pair
-            (si.next());
+    /* raw values only, frames are decoded when first inspected */
+    WitnessSnapshot_ptr snapshot
+        (new WitnessSnapshot(model, false));
+
+    const WitnessExtractor& extractor
+        (snapshot->extractor());
+
+    /* Collecting symbols for the witness' language, monitors are not
+       part of the model */
+    f_lang = extractor.language(false);
 
-        Expr_ptr ctx
-            (pair.first);
+    /* loop monitors are needed right away */
+    std::vector<unsigned> loop_monitors;
 
-        Symbol_ptr symb
-            (pair.second);
+    const WitnessSymbols& variables
+        (extractor.variables());
 
-        Expr_ptr full_name
-            ( em.make_dot( ctx, symb->name()));
+    for (unsigned i = 0; i < variables.size(); ++ i) {
+        Variable& var
+            (variables[i].symb->as_variable());
 
-        f_lang.push_back(full_name);
+        if (var.is_monitor() && MONITOR_LOOP == var.monitor())
+            loop_monitors.push_back(i);
     }
 
     step_t step
@@ -67,98 +70,22 @@ BMCCounterExample::BMCCounterExample(Expr_ptr property, Model& model,
 
     do {
 
-        TimeFrame& tf
-            (extend());
-
-        SymbIter symbols
-            (model);
-
-        while (symbols.has_next()) {
-
-            std::pair <Expr_ptr, Symbol_ptr> pair
-                (symbols.next());
-
-            Expr_ptr ctx
-                (pair.first);
-
-            Symbol_ptr symb
-                (pair.second);
-
-            Expr_ptr symb_name
-                (symb->name());
-
-            Expr_ptr key
-                (em.make_dot( ctx, symb_name));
-
-            if (symb->is_variable()) {
-
-                Variable& var
-                    (symb->as_variable());
-
-                /* time it, and fetch encoding for enc mgr */
-                Encoding_ptr enc
-                    (bm.find_encoding( TimedExpr(key, var.is_frozen()
-                                                 ? UINT_MAX : 0)) );
+        extend();
 
-                if ( ! enc )
-                    continue;
+        snapshot->push_row(engine, reversed
+                           ? UINT_MAX - step
+                           : step);
 
-                int inputs[bm.nbits()];
-                memset(inputs, 0, sizeof(inputs));
+        /* monitors are folded back: the loop monitor holds from the
+           time the last state loops back to on. */
+        for (std::vector<unsigned>::const_iterator i = loop_monitors.begin();
+             ! has_loop() && loop_monitors.end() != i; ++ i) {
 
-                /* 1. for each bit int the encoding, fetch UCBI, time
-                   it into TCBI, fetch its value in MiniSAT model and
-                   set the corresponding entry in input. */
-                DDVector::const_iterator di;
-                unsigned ndx;
-                for (ndx = 0, di = enc->bits().begin();
-                     enc->bits().end() != di; ++ ndx, ++ di) {
+            Expr_ptr value
+                (snapshot->value(*i, size() - 1));
 
-                    unsigned bit
-                        ((*di).getNode()->index);
-
-                    const UCBI& ucbi
-                        (bm.find_ucbi(bit));
-
-                    const TCBI tcbi
-                        (TCBI(ucbi, reversed
-                              ? UINT_MAX - step
-                              : step));
-
-                    Var var
-                        (engine.tcbi_to_var(tcbi));
-
-                    int value
-                        (engine.value(var)); /* XXX: don't cares assigned to 0 */
-
-                    inputs[bit] = value;
-                }
-
-                /* 2. eval the encoding DDs with inputs and put
-                   resulting value into time frame container. */
-                Expr_ptr value
-                    (enc->expr(inputs));
-
-                /* NULL values here indicate UNDEFs */
-                if (value)
-                    tf.set_value( key, value, symb->format());
-            }
-
-            else if (symb->is_define()) {
-
-                WitnessMgr& wm
-                    (WitnessMgr::INSTANCE());
-
-                const Define& define
-                    (symb->as_define());
-
-                Expr_ptr value
-                    (wm.eval( *this, ctx, define.body(), 0));
-
-                /* NULL values here indicate UNDEFs */
-                if (value)
-                    tf.set_value( key, value, symb->format());
-            }
+            if (value && em.is_true(value))
+                set_loop(size() - 1);
         }
 
         step += reversed ? -1 :  1 ;
@@ -166,5 +93,6 @@ BMCCounterExample::BMCCounterExample(Expr_ptr property, Model& model,
             (! reversed && step > k))
             break;
     } while (1);
-} /* BMCCounterExample::BMCCounterExample() */
 
+    set_snapshot(snapshot);
+} /* BMCCounterExample::BMCCounterExample() */
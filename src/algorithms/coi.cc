@@ -0,0 +1,334 @@
+/**
+ * @file coi.cc
+ * @brief Cone of influence reduction, implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <stack>
+
+#include <algorithms/coi.hh>
+
+#include <env/environment.hh>
+
+#include <symb/classes.hh>
+#include <symb/proxy.hh>
+#include <symb/symb_iter.hh>
+
+#include <model/module.hh>
+
+#include <type/type.hh>
+
+static const char* COI_IDENTIFIER = "coi";
+
+/* opt-in: pruning is unsound for models whose constraints outside of
+   the cone are inconsistent, or have deadlocks */
+static const unsigned DEFAULT_COI (0);
+
+bool coi_enabled()
+{
+    return 0 != env_unsigned(COI_IDENTIFIER, 0, DEFAULT_COI);
+}
+
+ConeOfInfluence::ConeOfInfluence(Model& model)
+    : f_model(model)
+    , f_mm(ModelMgr::INSTANCE())
+    , f_em(ExprMgr::INSTANCE())
+{
+    Environment& env
+        (Environment::INSTANCE());
+
+    std::stack< std::pair<Expr_ptr, Module_ptr> > stack;
+    stack.push( std::pair< Expr_ptr, Module_ptr >
+                (f_em.make_empty(), &model.main_module()));
+
+    /* walk of var decls, starting from main module */
+    while (0 < stack.size()) {
+
+        const std::pair< Expr_ptr, Module_ptr > top
+            (stack.top());
+        stack.pop();
+
+        Expr_ptr ctx
+            (top.first);
+
+        Module& module
+            (* top.second);
+
+        collect(COI_INIT, ctx, module.init());
+        collect(COI_INVAR, ctx, module.invar());
+        collect(COI_TRANS, ctx, module.trans());
+
+        Variables attrs
+            (module.vars());
+        Variables::const_iterator vi;
+        for (vi = attrs.begin(); attrs.end() != vi; ++ vi) {
+
+            Type_ptr vtype
+                (vi->second->type());
+
+            if (vtype->is_instance()) {
+
+                InstanceType_ptr instance
+                    (vtype->as_instance());
+
+                stack.push( std::pair< Expr_ptr, Module_ptr >
+                            (f_em.make_dot( ctx, vi->first),
+                             &model.module(instance->name())));
+            }
+        }
+    } /* while() */
+
+    /* environment extra constraints */
+    collect(COI_INIT, NULL, env.extra_init());
+    collect(COI_INVAR, NULL, env.extra_invar());
+    collect(COI_TRANS, NULL, env.extra_trans());
+
+    /* state variables */
+    SymbIter symbs
+        (model);
+
+    while (symbs.has_next()) {
+
+        Symbol_ptr symb
+            (symbs.next().second);
+
+        if (symb->is_variable()) {
+
+            Variable& var
+                (symb->as_variable());
+
+            if (var.is_input() ||
+                var.is_temp() ||
+                var.type()->is_instance())
+                continue;
+
+            ++ f_stats.vars;
+        }
+    }
+
+    f_stats.kept_vars = f_stats.vars;
+}
+
+ConeOfInfluence::~ConeOfInfluence()
+{}
+
+void ConeOfInfluence::collect(coi_kind_t kind, Expr_ptr ctx,
+                              const ExprVector& exprs)
+{
+    for (ExprVector::const_iterator i = exprs.begin(); exprs.end() != i; ++ i) {
+        f_constraints.push_back(COIConstraint(kind, ctx, *i));
+
+        ++ f_stats.total[kind];
+        ++ f_stats.kept[kind];
+    }
+}
+
+void ConeOfInfluence::process(const ExprVector& roots)
+{
+    unsigned nconstraints
+        (f_constraints.size());
+
+    std::vector<COISupport> supports
+        (nconstraints);
+
+    /* variable -> constraints depending on it */
+    boost::unordered_map<Expr_ptr, std::vector<unsigned>,
+                         PtrHash, PtrEq> dependants;
+
+    for (unsigned i = 0; i < nconstraints; ++ i) {
+        COIConstraint& constraint
+            (f_constraints[i]);
+
+        support(constraint.ctx ? constraint.ctx : f_em.make_empty(),
+                constraint.body, supports[i]);
+
+        /* constant constraints (e.g. FALSE) affect the whole model */
+        constraint.relevant = supports[i].empty();
+
+        for (COISupport::const_iterator j = supports[i].begin();
+             supports[i].end() != j; ++ j)
+            dependants[*j].push_back(i);
+    }
+
+    COISupport cone;
+    for (ExprVector::const_iterator i = roots.begin(); roots.end() != i; ++ i)
+        support(f_em.make_empty(), *i, cone);
+
+    /* undirected closure, one variable at a time */
+    std::vector<Expr_ptr> worklist
+        (cone.begin(), cone.end());
+
+    while (! worklist.empty()) {
+        Expr_ptr var
+            (worklist.back());
+        worklist.pop_back();
+
+        const std::vector<unsigned>& indexes
+            (dependants[var]);
+
+        for (std::vector<unsigned>::const_iterator i = indexes.begin();
+             indexes.end() != i; ++ i) {
+
+            COIConstraint& constraint
+                (f_constraints[*i]);
+
+            if (constraint.relevant)
+                continue;
+
+            constraint.relevant = true;
+
+            DEBUG
+                << "COI: "
+                << constraint.ctx << "::" << constraint.body
+                << " is in the cone, because of "
+                << var
+                << std::endl;
+
+            for (COISupport::const_iterator j = supports[*i].begin();
+                 supports[*i].end() != j; ++ j)
+                if (cone.insert(*j).second)
+                    worklist.push_back(*j);
+        }
+    }
+
+    for (unsigned i = 0; i < 3; ++ i)
+        f_stats.kept[i] = 0;
+
+    for (COIConstraints::const_iterator i = f_constraints.begin();
+         f_constraints.end() != i; ++ i)
+        if (i->relevant)
+            ++ f_stats.kept[i->kind];
+
+    f_stats.kept_vars = cone.size();
+}
+
+void ConeOfInfluence::support(Expr_ptr ctx, Expr_ptr expr, COISupport& res)
+{
+    if (! expr)
+        return;
+
+    switch (expr->symb()) {
+
+    /* leaves */
+    case IDENT:
+        symbol_support(f_em.make_dot(ctx, expr), res);
+        return;
+
+    case ICONST:
+    case HCONST:
+    case OCONST:
+    case BCONST:
+    case QSTRING:
+    case UNDEF:
+        return;
+
+    /* types have no support */
+    case TYPE:
+    case BOOL:
+    case SIGNED:
+    case UNSIGNED:
+        return;
+
+    case CAST:
+        support(ctx, expr->rhs(), res);
+        return;
+
+    case DOT:
+        support(f_em.make_dot(ctx, expr->lhs()), expr->rhs(), res);
+        return;
+
+    /* parametric DEFINEs, expanded as in the Compiler */
+    case PARAMS:
+        support(ctx, f_mm.preprocess(expr, ctx), res);
+        return;
+
+    default:
+        support(ctx, expr->lhs(), res);
+        support(ctx, expr->rhs(), res);
+        return;
+    }
+}
+
+void ConeOfInfluence::symbol_support(Expr_ptr full, COISupport& res)
+{
+    ResolverProxy resolver;
+
+    Symbol_ptr symb
+        (resolver.symbol(full));
+
+    if (symb->is_variable()) {
+        Variable& var
+            (symb->as_variable());
+
+        /* inputs are environment values, temporaries live outside of
+           the model */
+        if (var.is_input() ||
+            var.is_temp() ||
+            var.type()->is_instance())
+            return;
+
+        res.insert(full);
+    }
+
+    else if (symb->is_parameter()) {
+        Expr_ptr rewrite
+            (f_mm.rewrite_parameter(full));
+
+        support(rewrite->lhs(), rewrite->rhs(), res);
+    }
+
+    else if (symb->is_define()) {
+        COISupport& define_support
+            (f_define_supports[full]);
+
+        /* cached, or being computed */
+        if (define_support.empty()) {
+            COISupport tmp;
+            support(full->lhs(), symb->as_define().body(), tmp);
+            define_support.insert(tmp.begin(), tmp.end());
+        }
+
+        res.insert(define_support.begin(), define_support.end());
+    }
+
+    /* constants and literals have no support */
+}
+
+std::ostream& operator<<(std::ostream& os, const ConeOfInfluence& coi)
+{
+    const COIStats& stats
+        (coi.stats());
+
+    os
+        << "INIT "
+        << stats.kept[COI_INIT] << "/" << stats.total[COI_INIT]
+
+        << ", INVAR "
+        << stats.kept[COI_INVAR] << "/" << stats.total[COI_INVAR]
+
+        << ", TRANS "
+        << stats.kept[COI_TRANS] << "/" << stats.total[COI_TRANS]
+
+        << ", variables "
+        << stats.kept_vars << "/" << stats.vars
+        ;
+
+    return os;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file coi.hh
+ * @brief Cone of influence reduction, declarations.
+ *
+ * The cone of influence of a set of formulas (e.g. a reachability
+ * target and its constraints) is the smallest set of model
+ * constraints (INITs, INVARs and TRANSes) closed under the relation
+ * "shares a variable with". Supports are computed over variables,
+ * DEFINEs are expanded and parameters are rewritten in the context of
+ * the module instance they belong to, just like the Compiler does.
+ *
+ * Constraints are relations, not assignments: a TRANS may constrain
+ * its current state variables as much as its next ones. Hence the
+ * closure is undirected, which keeps the reduction sound as long as
+ * the constraints outside of the cone are consistent and deadlock
+ * free (i.e. they do not restrict the variables in the cone by
+ * themselves).
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef COI_ALGORITHM_H
+#define COI_ALGORITHM_H
+
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <expr/expr.hh>
+#include <expr/expr_mgr.hh>
+
+#include <model/model.hh>
+#include <model/model_mgr.hh>
+
+#include <utils/pool.hh>
+
+typedef enum {
+    COI_INIT,
+    COI_INVAR,
+    COI_TRANS,
+} coi_kind_t;
+
+/* fully qualified variables */
+typedef boost::unordered_set<Expr_ptr, PtrHash, PtrEq> COISupport;
+
+struct COIConstraint {
+    coi_kind_t kind;
+
+    /* NULL for environment extra constraints */
+    Expr_ptr ctx;
+    Expr_ptr body;
+
+    /* in the cone? */
+    bool relevant;
+
+    COIConstraint(coi_kind_t kind_, Expr_ptr ctx_, Expr_ptr body_)
+        : kind(kind_)
+        , ctx(ctx_)
+        , body(body_)
+        , relevant(true)
+    {}
+};
+
+typedef std::vector<COIConstraint> COIConstraints;
+
+struct COIStats {
+    /* constraints, by kind, and those in the cone */
+    unsigned total[3];
+    unsigned kept[3];
+
+    /* state variables, and those in the cone */
+    unsigned vars;
+    unsigned kept_vars;
+
+    COIStats()
+        : vars(0)
+        , kept_vars(0)
+    {
+        for (unsigned i = 0; i < 3; ++ i)
+            total[i] = kept[i] = 0;
+    }
+};
+
+class ConeOfInfluence {
+public:
+    /**
+     * @brief Collects all the constraints of model, walking module
+     * instances from the main module, followed by the environment
+     * extra constraints. All of them are relevant, until process() is
+     * called.
+     */
+    ConeOfInfluence(Model& model);
+    ~ConeOfInfluence();
+
+    /**
+     * @brief Restricts relevant constraints to the cone of influence of
+     * roots, formulas in the main module context.
+     */
+    void process(const ExprVector& roots);
+
+    /**
+     * @brief Model constraints, in compilation order
+     */
+    inline const COIConstraints& constraints() const
+    { return f_constraints; }
+
+    inline const COIStats& stats() const
+    { return f_stats; }
+
+private:
+    Model& f_model;
+
+    ModelMgr& f_mm;
+    ExprMgr& f_em;
+
+    COIConstraints f_constraints;
+    COIStats f_stats;
+
+    /* supports of DEFINEs, by fully qualified name */
+    boost::unordered_map<Expr_ptr, COISupport, PtrHash, PtrEq> f_define_supports;
+
+    void collect(coi_kind_t kind, Expr_ptr ctx, const ExprVector& exprs);
+
+    /* adds the variables ctx::expr depends upon to support */
+    void support(Expr_ptr ctx, Expr_ptr expr, COISupport& support);
+
+    /* support of a (fully qualified) symbol */
+    void symbol_support(Expr_ptr full, COISupport& support);
+};
+
+std::ostream& operator<<(std::ostream& os, const ConeOfInfluence& coi);
+
+/* Is COI reduction enabled? (cfr. `coi` environment identifier) */
+bool coi_enabled();
+
+#endif /* COI_ALGORITHM_H */
@@ -65,7 +65,7 @@ void CheckInitConsistency::process(ExprVector constraints)
                           << std::endl;
 
                       CompilationUnit unit
-                          (compiler().process(ctx, expr));
+                          (mm().compile(ctx, expr));
 
                       f_constraint_cus.push_back(unit);
                       ++ nconstraints;
@@ -67,7 +67,7 @@ void CheckTransConsistency::process(ExprVector constraints)
                           << std::endl;
 
                       CompilationUnit unit
-                          (compiler().process(ctx, expr));
+                          (mm().compile(ctx, expr));
 
                       f_constraint_cus.push_back(unit);
                       ++ nconstraints;
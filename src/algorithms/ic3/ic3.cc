@@ -0,0 +1,511 @@
+/**
+ * @file ic3/ic3.cc
+ * @brief SAT-based IC3/PDR reachability algorithm, IC3 class implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+#include <queue>
+
+#include <boost/unordered_set.hpp>
+
+#include <algorithms/ic3/ic3.hh>
+
+/* raised by IC3::solve() when the engine is interrupted, never leaves
+   IC3::process() */
+struct IC3Interrupted {};
+
+/* A state to be blocked in frame level, depth steps away from the
+   target */
+struct IC3Obligation {
+    unsigned level;
+    unsigned depth;
+    Cube cube;
+
+    IC3Obligation(unsigned level_, unsigned depth_, const Cube& cube_)
+        : level(level_)
+        , depth(depth_)
+        , cube(cube_)
+    {}
+
+    /* lowest level first */
+    inline bool operator<(const IC3Obligation& other) const
+    { return other.level < level; }
+};
+
+IC3::IC3(Algorithm& algorithm, Engine& engine,
+         CompilationUnit& target, CompilationUnits& constraints)
+    : f_algorithm(algorithm)
+    , f_engine(engine)
+    , f_target(target)
+    , f_constraints(constraints)
+    , f_trans_act(VAR_UNDEF)
+    , f_target_act(VAR_UNDEF)
+    , f_cube_act(VAR_UNDEF)
+    , f_depth(0)
+    , f_invariant_size(0)
+{}
+
+IC3::~IC3()
+{}
+
+status_t IC3::process()
+{
+    try {
+        setup();
+
+        /* 0-steps paths are special: F_0 is INIT */
+        vec<Lit> assumptions;
+        assume_frame(0, assumptions);
+        assumptions.push( mkLit( f_target_act, false));
+
+        if (STATUS_SAT == solve(assumptions)) {
+            f_depth = 0;
+            return STATUS_SAT;
+        }
+
+        new_frame();
+        for (unsigned k = 1; ; ++ k) {
+            Cube bad;
+            while (bad_cube(k, bad))
+                if (! block(bad, k))
+                    return STATUS_SAT;
+
+            new_frame();
+
+            DEBUG
+                << "IC3: frame "
+                << k
+                << " done, "
+                << *this
+                << std::endl;
+
+            if (propagate(k))
+                return STATUS_UNSAT;
+        }
+    }
+
+    catch (IC3Interrupted& ii) {
+        return STATUS_UNKNOWN;
+    }
+}
+
+void IC3::setup()
+{
+    const IndexVector& state_bits
+        (f_algorithm.state_bits());
+
+    const IndexVector& frozen_bits
+        (f_algorithm.frozen_bits());
+
+    /* frozen bits are the same vars at both times */
+    IndexVector bits
+        (state_bits);
+    bits.insert(bits.end(), frozen_bits.begin(), frozen_bits.end());
+
+    for (IndexVector::const_iterator i = bits.begin(); bits.end() != i; ++ i) {
+        f_curr.push_back(f_engine.find_dd_var(*i, 0));
+        f_next.push_back(f_engine.find_dd_var(*i, 1));
+    }
+
+    /* F_0 */
+    new_frame();
+    f_algorithm.assert_fsm_init(f_engine, 0, f_frame_acts[0]);
+
+    /* states not satisfying invariants and constraints do not exist */
+    for (step_t time = 0; time <= 1; ++ time) {
+        f_algorithm.assert_fsm_invar(f_engine, time);
+
+        for (CompilationUnits::iterator i = f_constraints.begin();
+             f_constraints.end() != i; ++ i)
+            f_algorithm.assert_formula(f_engine, time, *i);
+    }
+
+    f_trans_act = f_engine.new_sat_var(true);
+    f_algorithm.assert_fsm_trans(f_engine, 0, f_trans_act);
+
+    f_target_act = f_engine.new_sat_var(true);
+    f_algorithm.assert_formula(f_engine, 0, f_target, f_target_act);
+
+    unsigned nbits
+        (f_curr.size());
+
+    /* diff_i -> (pos_i & !x_i) | (neg_i & x_i), x_i being the i-th
+       state bit at time 0. Relative induction queries need no
+       clauses of their own. */
+    f_cube_act = f_engine.new_sat_var(true);
+
+    vec<Lit> not_cube;
+    not_cube.push( mkLit( f_cube_act, true));
+
+    for (unsigned i = 0; i < nbits; ++ i) {
+        Var pos
+            (f_engine.new_sat_var(true));
+        Var neg
+            (f_engine.new_sat_var(true));
+        Var diff
+            (f_engine.new_sat_var());
+
+        vec<Lit> ps;
+        ps.push( mkLit( diff, true));
+        ps.push( mkLit( pos, false));
+        ps.push( mkLit( neg, false));
+        f_engine.add_clause(ps);
+
+        ps.clear();
+        ps.push( mkLit( diff, true));
+        ps.push( mkLit( pos, true));
+        ps.push( mkLit( f_curr[i], true));
+        f_engine.add_clause(ps);
+
+        ps.clear();
+        ps.push( mkLit( diff, true));
+        ps.push( mkLit( neg, true));
+        ps.push( mkLit( f_curr[i], false));
+        f_engine.add_clause(ps);
+
+        not_cube.push( mkLit( diff, false));
+        f_cube_pos.push_back(pos);
+        f_cube_neg.push_back(neg);
+    }
+
+    f_engine.add_clause(not_cube);
+
+    DEBUG
+        << "IC3: "
+        << nbits
+        << " state bits"
+        << std::endl;
+}
+
+void IC3::new_frame()
+{
+    f_frame_acts.push_back(f_engine.new_sat_var(true));
+    f_frames.push_back(Cubes());
+}
+
+status_t IC3::solve(const vec<Lit>& assumptions)
+{
+    ++ f_stats.queries;
+
+    status_t res
+        (f_engine.solve(assumptions));
+
+    if (STATUS_UNKNOWN == res)
+        throw IC3Interrupted();
+
+    return res;
+}
+
+void IC3::assume_frame(unsigned k, vec<Lit>& assumptions)
+{
+    if (0 == k)
+        assumptions.push( mkLit( f_frame_acts[0], false));
+
+    else for (unsigned i = k; i < f_frame_acts.size(); ++ i)
+        assumptions.push( mkLit( f_frame_acts[i], false));
+}
+
+/* selects the literal of cube for each bit, no literal (both
+   selectors off) for the bits cube does not constrain */
+void IC3::assume_not_cube(const Cube& cube, vec<Lit>& assumptions)
+{
+    assumptions.push( mkLit( f_cube_act, false));
+
+    Cube::const_iterator j
+        (cube.begin());
+
+    for (unsigned i = 0; i < f_curr.size(); ++ i) {
+        bool pos
+            (false);
+        bool neg
+            (false);
+
+        if (cube.end() != j && i == (unsigned) Minisat::var(*j)) {
+            if (Minisat::sign(*j))
+                neg = true;
+            else
+                pos = true;
+
+            ++ j;
+        }
+
+        assumptions.push( mkLit( f_cube_pos[i], ! pos));
+        assumptions.push( mkLit( f_cube_neg[i], ! neg));
+    }
+
+    assert(cube.end() == j);
+}
+
+void IC3::model_cube(step_t time, Cube& cube)
+{
+    const VarVector& vars
+        (time ? f_next : f_curr);
+
+    cube.clear();
+    for (unsigned i = 0; i < vars.size(); ++ i)
+        cube.push_back( mkLit( i, ! f_engine.value(vars[i])));
+}
+
+bool IC3::bad_cube(unsigned k, Cube& cube)
+{
+    vec<Lit> assumptions;
+    assume_frame(k, assumptions);
+    assumptions.push( mkLit( f_target_act, false));
+
+    if (STATUS_UNSAT == solve(assumptions))
+        return false;
+
+    model_cube(0, cube);
+    return true;
+}
+
+bool IC3::intersects_init(const Cube& cube, Cube* init)
+{
+    vec<Lit> assumptions;
+    assume_frame(0, assumptions);
+
+    for (Cube::const_iterator i = cube.begin(); cube.end() != i; ++ i)
+        assumptions.push( curr(*i));
+
+    if (STATUS_UNSAT == solve(assumptions))
+        return false;
+
+    if (init)
+        model_cube(0, *init);
+
+    return true;
+}
+
+bool IC3::relative_induction(const Cube& cube, unsigned k,
+                             Cube* core, Cube* pred)
+{
+    vec<Lit> assumptions;
+    assume_frame(k, assumptions);
+    assumptions.push( mkLit( f_trans_act, false));
+    assume_not_cube(cube, assumptions);
+    for (Cube::const_iterator i = cube.begin(); cube.end() != i; ++ i)
+        assumptions.push( next(*i));
+
+    status_t status
+        (solve(assumptions));
+
+    bool res
+        (STATUS_UNSAT == status);
+
+    if (res && core) {
+        vec<Lit> failed;
+        f_engine.failed(failed);
+
+        boost::unordered_set<int> lits;
+        for (int i = 0; i < failed.size(); ++ i)
+            lits.insert( Minisat::toInt( failed[i]));
+
+        core->clear();
+        for (Cube::const_iterator i = cube.begin(); cube.end() != i; ++ i)
+            if (lits.end() != lits.find( Minisat::toInt( next(*i))))
+                core->push_back(*i);
+    }
+
+    else if (! res && pred)
+        model_cube(0, *pred);
+
+    return res;
+}
+
+void IC3::exclude_init(const Cube& cube, Cube& core)
+{
+    Cube init;
+    while (intersects_init(core, &init)) {
+
+        /* init satisfies core but not cube, some literal of cube
+           rules it out */
+        Cube::const_iterator i;
+        for (i = cube.begin(); cube.end() != i; ++ i)
+            if (init[ Minisat::var(*i)] != *i)
+                break;
+
+        assert(cube.end() != i);
+
+        core.insert(std::lower_bound(core.begin(), core.end(), *i), *i);
+    }
+}
+
+void IC3::generalize(Cube& cube, unsigned k)
+{
+    /* try dropping each literal in turn */
+    Cube lits
+        (cube);
+
+    for (Cube::const_iterator i = lits.begin(); lits.end() != i; ++ i) {
+        if (1 == cube.size())
+            break;
+
+        Cube::iterator eye
+            (std::lower_bound(cube.begin(), cube.end(), *i));
+
+        /* already dropped */
+        if (cube.end() == eye || *eye != *i)
+            continue;
+
+        Cube candidate
+            (cube);
+        candidate.erase(candidate.begin() + (eye - cube.begin()));
+
+        if (intersects_init(candidate))
+            continue;
+
+        Cube core;
+        if (relative_induction(candidate, k, &core, NULL)) {
+            exclude_init(candidate, core);
+            f_stats.dropped += cube.size() - core.size();
+            cube.swap(core);
+        }
+    }
+}
+
+void IC3::add_blocked(const Cube& cube, unsigned level)
+{
+    assert(0 < level && level < f_frames.size());
+
+    f_frames[level].push_back(cube);
+
+    vec<Lit> ps;
+    ps.push( mkLit( f_frame_acts[level], true));
+    for (Cube::const_iterator i = cube.begin(); cube.end() != i; ++ i)
+        ps.push( ~ curr(*i));
+    f_engine.add_clause(ps);
+
+    ++ f_stats.blocked;
+}
+
+bool IC3::block(const Cube& bad, unsigned k)
+{
+    std::priority_queue<IC3Obligation> obligations;
+    obligations.push(IC3Obligation(k, 0, bad));
+
+    while (! obligations.empty()) {
+        IC3Obligation obligation
+            (obligations.top());
+        obligations.pop();
+
+        ++ f_stats.obligations;
+
+        Cube core;
+        Cube pred;
+
+        if (relative_induction(obligation.cube, obligation.level - 1,
+                               &core, &pred)) {
+
+            exclude_init(obligation.cube, core);
+            f_stats.dropped += obligation.cube.size() - core.size();
+            generalize(core, obligation.level - 1);
+
+            /* block it as far as possible */
+            unsigned level
+                (obligation.level);
+            while (level < k && relative_induction(core, level, NULL, NULL))
+                ++ level;
+
+            add_blocked(core, level);
+
+            /* the same state, in the frames after that */
+            if (level < k)
+                obligations.push(IC3Obligation(level + 1,
+                                               obligation.depth,
+                                               obligation.cube));
+        }
+
+        else {
+            /* a path from INIT */
+            if (1 == obligation.level || intersects_init(pred)) {
+                f_depth = obligation.depth + 1;
+                return false;
+            }
+
+            obligations.push(obligation);
+            obligations.push(IC3Obligation(obligation.level - 1,
+                                           obligation.depth + 1, pred));
+        }
+    }
+
+    return true;
+}
+
+bool IC3::propagate(unsigned k)
+{
+    for (unsigned i = 1; i <= k; ++ i) {
+        Cubes cubes;
+        cubes.swap(f_frames[i]);
+
+        for (Cubes::const_iterator j = cubes.begin(); cubes.end() != j; ++ j) {
+            if (relative_induction(*j, i, NULL, NULL)) {
+                add_blocked(*j, i + 1);
+                ++ f_stats.propagated;
+            }
+            else f_frames[i].push_back(*j);
+        }
+
+        /* F_i = F_i+1, an inductive invariant */
+        if (f_frames[i].empty()) {
+            for (unsigned j = i + 1; j < f_frames.size(); ++ j)
+                f_invariant_size += f_frames[j].size();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::ostream& operator<<(std::ostream& os, const IC3& ic3)
+{
+    const IC3Stats& stats
+        (ic3.stats());
+
+    os
+        << "frames: "
+        << ic3.nframes()
+        << " [";
+
+    for (unsigned i = 1; i <= ic3.nframes(); ++ i)
+        os
+            << (1 < i ? " " : "")
+            << ic3.frame_size(i);
+
+    os
+        << "], queries: "
+        << stats.queries
+
+        << ", obligations: "
+        << stats.obligations
+
+        << ", blocked cubes: "
+        << stats.blocked
+
+        << ", dropped lits: "
+        << stats.dropped
+
+        << ", propagated clauses: "
+        << stats.propagated
+        ;
+
+    return os;
+}
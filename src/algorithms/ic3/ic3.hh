@@ -0,0 +1,210 @@
+/**
+ * @file ic3/ic3.hh
+ * @brief SAT-based IC3/PDR reachability algorithm, IC3 class declaration.
+ *
+ * IC3 (property directed reachability) proves unreachability by
+ * building a sequence of frames F_0 = INIT, F_1, ..., F_k: each frame
+ * is a set of clauses over the state bits, over-approximating the
+ * states reachable within i steps. States reaching the target are
+ * blocked frame by frame by means of relative induction queries;
+ * clauses are then propagated forward, until two consecutive frames
+ * are equal, which makes them an inductive invariant.
+ *
+ * A single Engine holds the whole problem: INIT, TRANS and the target
+ * are instantiated once (time frames 0 and 1), each guarded by an
+ * activation var. Frames are delta encoded, each blocked cube is
+ * added once, guarded by the activation var of the last frame it is
+ * blocked in. Queries are then just a matter of assumptions.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef IC3_ALGORITHM_H
+#define IC3_ALGORITHM_H
+
+#include <vector>
+
+#include <algorithms/base.hh>
+
+/* A cube is a conjunction of state bit literals. Literal vars are
+   positions in the state vector (cfr. IC3::f_curr), literals are kept
+   sorted. */
+typedef Lits Cube;
+typedef std::vector<Cube> Cubes;
+
+struct IC3Stats {
+    /* SAT queries */
+    unsigned queries;
+
+    /* proof obligations processed */
+    unsigned obligations;
+
+    /* cubes blocked, and literals dropped by generalization */
+    unsigned blocked;
+    unsigned dropped;
+
+    /* clauses propagated to the next frame */
+    unsigned propagated;
+
+    IC3Stats()
+        : queries(0)
+        , obligations(0)
+        , blocked(0)
+        , dropped(0)
+        , propagated(0)
+    {}
+};
+
+class IC3 {
+public:
+    /**
+     * @brief An IC3 instance for target, all the formulas of
+     * algorithm's model are asserted in engine. Constraints hold in
+     * all states.
+     */
+    IC3(Algorithm& algorithm, Engine& engine,
+        CompilationUnit& target, CompilationUnits& constraints);
+
+    ~IC3();
+
+    /**
+     * @brief STATUS_SAT if target is reachable (cfr. depth()),
+     * STATUS_UNSAT if it is not (cfr. invariant_size()), and
+     * STATUS_UNKNOWN if the engine was interrupted.
+     */
+    status_t process();
+
+    /**
+     * @brief Length of the shortest path to target found, after
+     * STATUS_SAT. Witnesses are to be extracted by plain BMC.
+     */
+    inline step_t depth() const
+    { return f_depth; }
+
+    /**
+     * @brief Number of clauses in the inductive invariant, after
+     * STATUS_UNSAT
+     */
+    inline unsigned invariant_size() const
+    { return f_invariant_size; }
+
+    /**
+     * @brief Number of frames, F_0 excluded
+     */
+    inline unsigned nframes() const
+    { return f_frames.size() - 1; }
+
+    /**
+     * @brief Number of clauses in the i-th frame (delta encoded)
+     */
+    inline unsigned frame_size(unsigned i) const
+    { return f_frames[i].size(); }
+
+    inline const IC3Stats& stats() const
+    { return f_stats; }
+
+private:
+    Algorithm& f_algorithm;
+    Engine& f_engine;
+
+    CompilationUnit& f_target;
+    CompilationUnits& f_constraints;
+
+    /* state bits at time 0 (current) and 1 (next) */
+    VarVector f_curr;
+    VarVector f_next;
+
+    /* activation vars for TRANS and target, INIT is F_0 */
+    Var f_trans_act;
+    Var f_target_act;
+
+    /* !cube, for any cube: a single clause, some state bit differs
+       from the literal selected for it. Cube literals are selected by
+       assumptions, cfr. assume_not_cube(). */
+    Var f_cube_act;
+    VarVector f_cube_pos;
+    VarVector f_cube_neg;
+
+    /* frame activation vars, and cubes blocked in frames up to i
+       (but not in i + 1) */
+    VarVector f_frame_acts;
+    std::vector<Cubes> f_frames;
+
+    step_t f_depth;
+    unsigned f_invariant_size;
+    IC3Stats f_stats;
+
+    void setup();
+    void new_frame();
+
+    /* throws IC3Interrupted on STATUS_UNKNOWN */
+    status_t solve(const vec<Lit>& assumptions);
+
+    /* F_k, as assumptions */
+    void assume_frame(unsigned k, vec<Lit>& assumptions);
+
+    /* !cube, at time 0, as assumptions */
+    void assume_not_cube(const Cube& cube, vec<Lit>& assumptions);
+
+    inline Lit curr(Lit lit) const
+    { return mkLit( f_curr[ Minisat::var(lit)], Minisat::sign(lit)); }
+
+    inline Lit next(Lit lit) const
+    { return mkLit( f_next[ Minisat::var(lit)], Minisat::sign(lit)); }
+
+    /* the state at time in the last model */
+    void model_cube(step_t time, Cube& cube);
+
+    /* a state in F_k reaching target, if any */
+    bool bad_cube(unsigned k, Cube& cube);
+
+    /* is there an initial state in cube? If so, the state is stored
+       in init (if not NULL) */
+    bool intersects_init(const Cube& cube, Cube* init = NULL);
+
+    /* is !cube inductive relative to F_k, i.e. is F_k & !cube &
+       TRANS & cube' UNSAT? If so, the subcube of cube used to prove it
+       is stored in core, otherwise a predecessor is stored in pred (if
+       not NULL). */
+    bool relative_induction(const Cube& cube, unsigned k,
+                            Cube* core, Cube* pred);
+
+    /* adds literals of cube back to core, until core and INIT are
+       disjoint. cube and INIT must be disjoint. */
+    void exclude_init(const Cube& cube, Cube& core);
+
+    /* drops literals from cube, as long as !cube is still inductive
+       relative to F_k */
+    void generalize(Cube& cube, unsigned k);
+
+    /* blocks cube, in frames 1 to level */
+    void add_blocked(const Cube& cube, unsigned level);
+
+    /* blocks bad and all its predecessors in F_k, false if a path
+       from INIT is found instead */
+    bool block(const Cube& bad, unsigned k);
+
+    /* propagates clauses in frames 1 to k forward, true if a fixpoint
+       is reached */
+    bool propagate(unsigned k);
+};
+
+std::ostream& operator<<(std::ostream& os, const IC3& ic3);
+
+#endif /* IC3_ALGORITHM_H */
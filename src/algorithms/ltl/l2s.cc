@@ -0,0 +1,277 @@
+/**
+ * @file ltl/l2s.cc
+ * @brief SAT-based SBMC Algorithm for LTL properties checking, liveness to safety transformation implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+#include <sstream>
+
+#include <algorithms/ltl/l2s.hh>
+#include <algorithms/ltl/tableau.hh>
+
+#include <symb/symb_iter.hh>
+
+/* reserved for monitor variables */
+static const char *l2s_prfx ("__l2s_");
+
+LivenessToSafety::LivenessToSafety(Model& model)
+    : f_model(model)
+    , f_em(ExprMgr::INSTANCE())
+    , f_tm(TypeMgr::INSTANCE())
+{}
+
+LivenessToSafety::~LivenessToSafety()
+{
+    Module& main_module
+        (f_model.main_module());
+
+    std::for_each(begin(f_trans), end(f_trans),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.remove_trans(expr);
+                  });
+
+    std::for_each(begin(f_invar), end(f_invar),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.remove_invar(expr);
+                  });
+
+    std::for_each(begin(f_init), end(f_init),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.remove_init(expr);
+                  });
+
+    std::for_each(begin(f_vars), end(f_vars),
+                  [&main_module](Expr_ptr id) {
+                      main_module.remove_var(id);
+                  });
+}
+
+Expr_ptr LivenessToSafety::add_var(const char* name, Type_ptr type,
+                                   monitor_t monitor, bool frozen)
+{
+    Module& main_module
+        (f_model.main_module());
+
+    std::ostringstream oss;
+    oss
+        << l2s_prfx
+        << name;
+
+    Expr_ptr id
+        (f_em.make_identifier(oss.str()));
+
+    Variable_ptr var
+        (new Variable(main_module.name(), id, type));
+
+    var->set_hidden(true);
+    var->set_frozen(frozen);
+    var->set_monitor(monitor);
+
+    main_module.add_var(id, var);
+    f_vars.push_back(id);
+
+    return id;
+}
+
+/* ctx.id, as seen from the main module */
+static Expr_ptr qualified(ExprMgr& em, Expr_ptr ctx, Expr_ptr id)
+{
+    if (em.is_empty(ctx))
+        return id;
+
+    assert(em.is_dot(ctx));
+    return em.make_dot( qualified(em, ctx->lhs(), ctx->rhs()), id);
+}
+
+Expr_ptr LivenessToSafety::make_shadows()
+{
+    Expr_ptr res
+        (f_em.make_true());
+
+    /* collect state variables first, the iterator is not to see
+       shadows */
+    std::vector< std::pair<Expr_ptr, Variable_ptr> > state_vars;
+
+    SymbIter symbs
+        (f_model);
+
+    while (symbs.has_next()) {
+        std::pair< Expr_ptr, Symbol_ptr > pair
+            (symbs.next());
+
+        Symbol_ptr symb
+            (pair.second);
+
+        if (! symb->is_variable())
+            continue;
+
+        Variable& var
+            (symb->as_variable());
+
+        /* frozen vars never change, no need to save them */
+        if (var.is_input() || var.is_frozen() ||
+            var.is_temp() || var.is_monitor())
+            continue;
+
+        state_vars.push_back(std::pair< Expr_ptr, Variable_ptr >
+                             (qualified(f_em, pair.first, var.name()), &var));
+    }
+
+    for (std::vector< std::pair<Expr_ptr, Variable_ptr> >::const_iterator i
+             = state_vars.begin(); state_vars.end() != i; ++ i) {
+
+        Expr_ptr name
+            (i->first);
+
+        Type_ptr type
+            (i->second->type());
+
+        /* a.b.x -> __l2s_a_b_x */
+        std::ostringstream oss;
+        oss
+            << name;
+
+        std::string shadow_name
+            (oss.str());
+        std::replace(shadow_name.begin(), shadow_name.end(), '.', '_');
+
+        Expr_ptr shadow
+            (add_var(shadow_name.c_str(), type, MONITOR_AUX, true));
+
+        if (type->is_array()) {
+            unsigned nelems
+                (type->as_array()->nelems());
+
+            for (unsigned j = 0; j < nelems; ++ j) {
+                Expr_ptr index
+                    (f_em.make_const(j));
+
+                res = f_em.make_and(res,
+                                    f_em.make_eq( f_em.make_subscript(name, index),
+                                                  f_em.make_subscript(shadow, index)));
+            }
+        }
+        else
+            res = f_em.make_and(res, f_em.make_eq(name, shadow));
+    }
+
+    return res;
+}
+
+Expr_ptr LivenessToSafety::process(Expr_ptr property)
+{
+    LTLTableau tableau
+        (f_em);
+
+    /* counterexamples satisfy !property */
+    unsigned root
+        (tableau.process(property, true));
+
+    const LTLNode& node
+        (tableau.node(root));
+
+    if (LTL_F != node.op)
+        if (LTL_G != node.op || LTL_F != tableau.node(node.lhs).op)
+            throw UnsupportedLTLFormula(property);
+
+    const LTLNode& inner
+        (tableau.node(node.lhs));
+
+    /* G p: F !p is a plain target */
+    if (LTL_ATOM == inner.op)
+        return inner.expr;
+
+    const LTLNode& atom
+        (tableau.node(inner.lhs));
+
+    if (LTL_ATOM != atom.op ||
+        (LTL_F == node.op && LTL_G != inner.op))
+        throw UnsupportedLTLFormula(property);
+
+    /* F G a: a holds all along the loop, i.e. !a is never seen in
+       it. G F a: a is seen in the loop. */
+    bool persistence
+        (LTL_F == node.op);
+
+    Expr_ptr seen_expr
+        (persistence ? f_em.make_not(atom.expr) : atom.expr);
+
+    Module& main_module
+        (f_model.main_module());
+
+    Type_ptr boolean
+        (f_tm.find_boolean());
+
+    Expr_ptr same
+        (make_shadows());
+
+    Expr_ptr save
+        (add_var("save", boolean, MONITOR_AUX));
+
+    Expr_ptr saved
+        (add_var("saved", boolean, MONITOR_LOOP));
+
+    Expr_ptr seen
+        (add_var("seen", boolean, MONITOR_AUX));
+
+    /* saving happens at most once, into the shadows */
+    f_init.push_back(f_em.make_not(saved));
+    f_init.push_back(f_em.make_not(seen));
+
+    f_invar.push_back(f_em.make_implies( f_em.make_and( save,
+                                                        f_em.make_not(saved)),
+                                         same));
+
+    /* saved holds after the state has been saved, seen after a state
+       satisfying seen_expr has been seen since (the saved state
+       included) */
+    Expr_ptr looping
+        (f_em.make_or(saved, save));
+
+    f_trans.push_back(f_em.make_guard( f_em.make_true(),
+                                       f_em.make_eq( f_em.make_next(saved),
+                                                     looping)));
+
+    f_trans.push_back(f_em.make_guard( f_em.make_true(),
+                                       f_em.make_eq( f_em.make_next(seen),
+                                                     f_em.make_or( seen,
+                                                                   f_em.make_and( looping,
+                                                                                  seen_expr)))));
+
+    std::for_each(begin(f_init), end(f_init),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.add_init(expr);
+                  });
+
+    std::for_each(begin(f_invar), end(f_invar),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.add_invar(expr);
+                  });
+
+    std::for_each(begin(f_trans), end(f_trans),
+                  [&main_module](Expr_ptr expr) {
+                      main_module.add_trans(expr);
+                  });
+
+    /* back to the saved state, the loop closes */
+    return f_em.make_and( f_em.make_and(saved, same),
+                          persistence ? f_em.make_not(seen) : seen);
+}
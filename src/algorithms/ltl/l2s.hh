@@ -0,0 +1,87 @@
+/**
+ * @file ltl/l2s.hh
+ * @brief SAT-based SBMC Algorithm for LTL properties checking, liveness to safety transformation declarations.
+ *
+ * A liveness property is violated iff there is a lasso shaped path
+ * violating it (Biere, Artho, Schuppan, FMICS 2002). The model is
+ * instrumented with a loop detection monitor: a frozen shadow copy of
+ * each state variable, an oracle input choosing when the current
+ * state is saved into the shadows, and a flag recording whether a
+ * state satisfying a given formula has been seen since then. The
+ * property is violated iff a state equal to the saved one is
+ * reachable, with the right value of the flag. Such a target can be
+ * checked by any reachability strategy (cfr. BMC), unbounded ones
+ * included.
+ *
+ * Monitor variables are marked (cfr. monitor_t): they are left out of
+ * witnesses, and the loop monitor tells BMCCounterExample where the
+ * lasso loops back to.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef LTL_L2S_H
+#define LTL_L2S_H
+
+#include <expr/expr.hh>
+#include <expr/expr_mgr.hh>
+
+#include <model/model.hh>
+#include <model/module.hh>
+
+#include <type/type.hh>
+#include <type/type_mgr.hh>
+
+class LivenessToSafety {
+public:
+    LivenessToSafety(Model& model);
+
+    /* the monitor is removed from the model */
+    ~LivenessToSafety();
+
+    /**
+     * @brief Instruments the model with a loop detection monitor for
+     * property, returns a target which is reachable iff property is
+     * violated. Supported properties are G p, G F p and F G p, with p
+     * propositional.
+     */
+    Expr_ptr process(Expr_ptr property);
+
+private:
+    Model& f_model;
+    ExprMgr& f_em;
+    TypeMgr& f_tm;
+
+    /* what was added to the main module */
+    ExprVector f_vars;
+    ExprVector f_init;
+    ExprVector f_invar;
+    ExprVector f_trans;
+
+    /* monitor variables are hidden state variables, owned by the
+       main module (cfr. Module::remove_var()) */
+    Expr_ptr add_var(const char* name, Type_ptr type, monitor_t monitor,
+                     bool frozen = false);
+
+    /* conjunction of (x = x') for all state variables x, and their
+       shadows x' */
+    Expr_ptr make_shadows();
+};
+
+#endif /* LTL_L2S_H */
@@ -21,13 +21,40 @@
  *
  **/
 
-#include <boost/thread.hpp>
+#include <algorithm>
 
 #include <algorithms/ltl/ltl.hh>
+#include <algorithms/ltl/witness.hh>
+
 #include <witness_mgr.hh>
 
+// reserved for witnesses
+static const char *ltl_trace_prfx ("ltl_");
+
+/* unit, binary and ternary clauses, into the engine clause arena */
+static void append_clause(Engine& engine, Lit a,
+                          Lit b = Minisat::lit_Undef,
+                          Lit c = Minisat::lit_Undef)
+{
+    engine.append_lit(a);
+
+    if (Minisat::lit_Undef != b)
+        engine.append_lit(b);
+
+    if (Minisat::lit_Undef != c)
+        engine.append_lit(c);
+
+    engine.close_clause();
+}
+
 LTL::LTL(Command& command, Model& model)
     : Algorithm(command, model)
+    , f_status(LTL_UNKNOWN)
+    , f_bound(0)
+    , f_phi(NULL)
+    , f_tableau(em())
+    , f_root(0)
+    , f_loop(VAR_UNDEF)
 {
     const void* instance(this);
     setup();
@@ -46,10 +73,481 @@ LTL::~LTL()
         << std::endl;
 }
 
-void LTL::process(const Expr_ptr phi)
+void LTL::process(const Expr_ptr phi, ExprVector constraints)
 {
+    f_phi = phi;
+    assert(f_phi);
+
     set_status( LTL_UNKNOWN );
-    assert(false); // XXX: TODO
+
+    Engine engine { "LTL" };
+    Expr_ptr ctx { em().make_empty() };
+
+    try {
+        unsigned nconstraints { 0 };
+        std::for_each(begin(constraints),
+                      end(constraints),
+                      [this, ctx, &nconstraints](Expr_ptr expr) {
+                          INFO
+                              << "Compiling constraint `"
+                              << expr
+                              << "` ..."
+                              << std::endl;
+
+                          CompilationUnit unit
+                              (mm().compile(ctx, expr));
+
+                          f_constraint_cus.push_back(unit);
+                          ++ nconstraints;
+                      });
+
+        INFO
+            << nconstraints
+            << " additional constraints found."
+            << std::endl;
+
+        /* counterexamples satisfy !phi */
+        f_root = f_tableau.process(f_phi, true);
+
+        const LTLNodes& nodes
+            (f_tableau.nodes());
+
+        /* operands come before nodes, the root is the last live one */
+        f_live.assign(nodes.size(), false);
+        f_live[f_root] = true;
+        for (unsigned i = f_root + 1; 0 < i --; ) {
+            if (! f_live[i])
+                continue;
+
+            const LTLNode& node
+                (nodes[i]);
+
+            if (LTL_ATOM == node.op)
+                continue;
+
+            f_live[node.lhs] = true;
+            if (LTL_AND == node.op || LTL_OR == node.op ||
+                LTL_U == node.op || LTL_R == node.op)
+                f_live[node.rhs] = true;
+        }
+
+        f_atom_index.assign(nodes.size(), UINT_MAX);
+        for (unsigned i = 0; i <= f_root; ++ i) {
+            if (! f_live[i] || LTL_ATOM != nodes[i].op)
+                continue;
+
+            INFO
+                << "Compiling atom `"
+                << nodes[i].expr
+                << "` ..."
+                << std::endl;
+
+            f_atom_index[i] = f_atom_cus.size();
+            f_atom_cus.push_back(mm().compile(ctx, nodes[i].expr));
+        }
+
+        unsigned natoms
+            (f_atom_cus.size());
+
+        INFO
+            << "Tableau of `"
+            << nodes[f_root].expr
+            << "` has "
+            << natoms
+            << " atoms."
+            << std::endl;
+
+        step_t k { 0 };
+
+        /* initial constraints */
+        assert_fsm_init(engine, k);
+        assert_fsm_invar(engine, k);
+        std::for_each(begin(f_constraint_cus),
+                      end(f_constraint_cus),
+                      [this, &engine, k](CompilationUnit& cu) {
+                          this->assert_formula(engine, k, cu);
+                      });
+
+        setup_encoding(engine);
+
+        do {
+            INFO
+                << "LTL: now looking for counterexample (k = " << k << ")..."
+                << std::endl ;
+
+            status_t status
+                (engine.solve());
+
+            if (STATUS_UNKNOWN == status)
+                break;
+
+            else if (STATUS_SAT == status) {
+                step_t loop
+                    (loop_time(engine));
+
+                INFO
+                    << "LTL: Counterexample exists (k = " << k << "), property `"
+                    << f_phi
+                    << "` is FALSE."
+                    << std::endl;
+
+                set_status( LTL_FALSE );
+
+                /* Extract counterexample */
+                WitnessMgr& wm
+                    (WitnessMgr::INSTANCE());
+
+                Witness& w
+                    (* new LTLCounterExample(f_phi, model(), engine, k));
+
+                if (UINT_MAX != loop)
+                    w.set_loop(loop);
+
+                /* witness identifier */
+                std::ostringstream oss_id;
+                oss_id
+                    << ltl_trace_prfx
+                    << wm.autoincrement();
+                w.set_id(oss_id.str());
+
+                /* witness description */
+                std::ostringstream oss_desc;
+                oss_desc
+                    << "Counterexample for LTL property `"
+                    << f_phi
+                    << "` in module `"
+                    << model().main_module().name()
+                    << "`" ;
+
+                if (UINT_MAX != loop)
+                    oss_desc
+                        << ", looping back to time "
+                        << loop ;
+                w.set_desc(oss_desc.str());
+
+                wm.record(w);
+                wm.set_current(w);
+                set_witness(w);
+
+                break;
+            }
+
+            else if (STATUS_UNSAT == status)
+                INFO
+                    << "LTL: no counterexample found (k = " << k << ")..."
+                    << std::endl ;
+
+            else assert(false); /* unreachable */
+
+            if (f_bound && k == f_bound)
+                break;
+
+            /* constraints on the last state no longer hold */
+            engine.invert_last_group();
+            engine.finalize_last_group();
+
+            /* unrolling next */
+            assert_fsm_trans(engine, k);
+            ++ k;
+            assert_fsm_invar(engine, k);
+            std::for_each(begin(f_constraint_cus),
+                          end(f_constraint_cus),
+                          [this, &engine, k](CompilationUnit& cu) {
+                              this->assert_formula(engine, k, cu);
+                          });
+
+            define_time(engine, k);
+            close_time(engine, k);
+
+            TRACE
+                << "LTL: done with k = " << k << "..."
+                << std::endl ;
+
+        } while (1);
+    }
+
+    catch (Exception& e) {
+        std::cerr
+            << e.what()
+            << std::endl;
+
+        set_status( LTL_ERROR );
+    }
+
+    INFO
+        << engine
+        << std::endl;
 
     TRACE << "Done." << std::endl;
 }
+
+void LTL::setup_encoding(Engine& engine)
+{
+    const LTLNodes& nodes
+        (f_tableau.nodes());
+
+    /* L vars, only L values of a looping path make sense */
+    f_loop = engine.new_sat_var(true);
+
+    f_loop_vars.assign(nodes.size(), VAR_UNDEF);
+    for (unsigned i = 0; i <= f_root; ++ i) {
+        if (! f_live[i])
+            continue;
+
+        f_loop_vars[i] = engine.new_sat_var(true);
+        append_clause(engine,
+                      mkLit( f_loop_vars[i], true),
+                      mkLit( f_loop, false));
+    }
+
+    /* a copy of the last state */
+    const IndexVector& state_bits
+        (this->state_bits());
+
+    for (unsigned i = 0; i < state_bits.size(); ++ i)
+        f_end.push_back(engine.new_sat_var(true));
+
+    /* no loop back to time 0 */
+    f_loops.push_back(VAR_UNDEF);
+    f_in_loop.push_back(engine.new_sat_var(true));
+
+    append_clause(engine, mkLit( f_in_loop[0], true));
+
+    /* time 0, the root holds */
+    alloc_time(engine);
+    define_time(engine, 0);
+
+    append_clause(engine, mkLit( f_vars[0][f_root], false));
+
+    close_time(engine, 0);
+}
+
+void LTL::alloc_time(Engine& engine)
+{
+    const LTLNodes& nodes
+        (f_tableau.nodes());
+
+    VarVector vars
+        (nodes.size(), VAR_UNDEF);
+
+    VarVector aux_vars
+        (nodes.size(), VAR_UNDEF);
+
+    for (unsigned i = 0; i <= f_root; ++ i) {
+        if (! f_live[i])
+            continue;
+
+        vars[i] = engine.new_sat_var(true);
+
+        if (LTL_F == nodes[i].op || LTL_U == nodes[i].op)
+            aux_vars[i] = engine.new_sat_var(true);
+    }
+
+    f_vars.push_back(vars);
+    f_aux_vars.push_back(aux_vars);
+}
+
+void LTL::define_time(Engine& engine, step_t time)
+{
+    const LTLNodes& nodes
+        (f_tableau.nodes());
+
+    const IndexVector& state_bits
+        (this->state_bits());
+
+    /* subformulas at time refer to subformulas at time + 1 */
+    assert(time + 1 == f_vars.size());
+    alloc_time(engine);
+
+    /* loop back to time: the state at time - 1 is the last one. At
+       most one loop back. */
+    if (0 < time) {
+        Var loop
+            (engine.new_sat_var(true));
+        f_loops.push_back(loop);
+
+        Var in_loop
+            (engine.new_sat_var(true));
+        f_in_loop.push_back(in_loop);
+
+        Var prev_in_loop
+            (f_in_loop[time - 1]);
+
+        for (unsigned j = 0; j < state_bits.size(); ++ j) {
+            Var x
+                (engine.find_dd_var(state_bits[j], time - 1));
+
+            append_clause(engine,
+                          mkLit( loop, true),
+                          mkLit( x, true),
+                          mkLit( f_end[j], false));
+
+            append_clause(engine,
+                          mkLit( loop, true),
+                          mkLit( x, false),
+                          mkLit( f_end[j], true));
+        }
+
+        append_clause(engine, mkLit( loop, true), mkLit( in_loop, false));
+        append_clause(engine, mkLit( prev_in_loop, true), mkLit( in_loop, false));
+        append_clause(engine, mkLit( prev_in_loop, true), mkLit( loop, true));
+        append_clause(engine,
+                      mkLit( in_loop, true),
+                      mkLit( prev_in_loop, false),
+                      mkLit( loop, false));
+    }
+
+    const VarVector& curr
+        (f_vars[time]);
+
+    const VarVector& next
+        (f_vars[time + 1]);
+
+    const VarVector& aux_curr
+        (f_aux_vars[time]);
+
+    const VarVector& aux_next
+        (f_aux_vars[time + 1]);
+
+    for (unsigned i = 0; i <= f_root; ++ i) {
+        if (! f_live[i])
+            continue;
+
+        const LTLNode& node
+            (nodes[i]);
+
+        Lit v
+            (mkLit( curr[i], true)); /* !v */
+
+        switch (node.op) {
+        case LTL_ATOM:
+            assert_formula(engine, time, f_atom_cus[f_atom_index[i]], curr[i]);
+            break;
+
+        case LTL_AND:
+            append_clause(engine, v, mkLit( curr[node.lhs], false));
+            append_clause(engine, v, mkLit( curr[node.rhs], false));
+            break;
+
+        case LTL_OR:
+            append_clause(engine, v,
+                          mkLit( curr[node.lhs], false),
+                          mkLit( curr[node.rhs], false));
+            break;
+
+        case LTL_X:
+            append_clause(engine, v, mkLit( next[node.lhs], false));
+            break;
+
+        case LTL_F:
+            append_clause(engine, v,
+                          mkLit( curr[node.lhs], false),
+                          mkLit( next[i], false));
+
+            append_clause(engine,
+                          mkLit( aux_curr[i], true),
+                          mkLit( curr[node.lhs], false),
+                          mkLit( aux_next[i], false));
+            break;
+
+        case LTL_G:
+            append_clause(engine, v, mkLit( curr[node.lhs], false));
+            append_clause(engine, v, mkLit( next[i], false));
+            break;
+
+        case LTL_U:
+            append_clause(engine, v,
+                          mkLit( curr[node.rhs], false),
+                          mkLit( curr[node.lhs], false));
+            append_clause(engine, v,
+                          mkLit( curr[node.rhs], false),
+                          mkLit( next[i], false));
+
+            append_clause(engine,
+                          mkLit( aux_curr[i], true),
+                          mkLit( curr[node.rhs], false),
+                          mkLit( curr[node.lhs], false));
+            append_clause(engine,
+                          mkLit( aux_curr[i], true),
+                          mkLit( curr[node.rhs], false),
+                          mkLit( aux_next[i], false));
+            break;
+
+        case LTL_R:
+            append_clause(engine, v, mkLit( curr[node.rhs], false));
+            append_clause(engine, v,
+                          mkLit( curr[node.lhs], false),
+                          mkLit( next[i], false));
+            break;
+
+        default: assert(false); /* unreachable */
+        } /* switch() */
+
+        /* L values, if the loop goes back to time */
+        if (0 < time)
+            append_clause(engine,
+                          mkLit( f_loop_vars[i], true),
+                          mkLit( f_loops[time], true),
+                          mkLit( (LTL_F == node.op || LTL_U == node.op)
+                                 ? aux_curr[i] : curr[i], false));
+    }
+}
+
+void LTL::close_time(Engine& engine, step_t time)
+{
+    const LTLNodes& nodes
+        (f_tableau.nodes());
+
+    const IndexVector& state_bits
+        (this->state_bits());
+
+    /* time is the last state, for the time being */
+    group_t group
+        (engine.new_group());
+
+    Lit g
+        (mkLit( group, true)); /* !group */
+
+    for (unsigned j = 0; j < state_bits.size(); ++ j) {
+        Var x
+            (engine.find_dd_var(state_bits[j], time));
+
+        append_clause(engine, g, mkLit( x, true), mkLit( f_end[j], false));
+        append_clause(engine, g, mkLit( x, false), mkLit( f_end[j], true));
+    }
+
+    append_clause(engine, g,
+                  mkLit( f_loop, true),
+                  mkLit( f_in_loop[time], false));
+
+    /* subformulas after the last state take their L values, F and U
+       must be fulfilled within the loop */
+    const VarVector& next
+        (f_vars[time + 1]);
+
+    const VarVector& aux_next
+        (f_aux_vars[time + 1]);
+
+    for (unsigned i = 0; i <= f_root; ++ i) {
+        if (! f_live[i])
+            continue;
+
+        append_clause(engine, g,
+                      mkLit( next[i], true),
+                      mkLit( f_loop_vars[i], false));
+
+        if (LTL_F == nodes[i].op || LTL_U == nodes[i].op)
+            append_clause(engine, g, mkLit( aux_next[i], true));
+    }
+
+    engine.flush_clauses();
+}
+
+step_t LTL::loop_time(Engine& engine)
+{
+    for (step_t time = 1; time < f_loops.size(); ++ time)
+        if (engine.value(f_loops[time]))
+            return time;
+
+    return UINT_MAX;
+}
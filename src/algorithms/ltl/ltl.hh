@@ -5,6 +5,20 @@
  * This header file contains the declarations required to implement
  * the LTL SAT-based SBMC model checking algorithm.
  *
+ * A counterexample to phi is a lasso path satisfying !phi: a path of
+ * k + 1 states, optionally followed by a loop back to one of them.
+ * The tableau of !phi (cfr. ltl/tableau.hh) is encoded with the
+ * linear encoding of Biere et al. (Linear Encodings of Bounded LTL
+ * Model Checking, LMCS 2006): one SAT var for each subformula at each
+ * time, one for its value at the loop back state (L), and one for
+ * each loop back time. As all subformulas occur positively in NNF,
+ * only one direction of each definition is required.
+ *
+ * The encoding is extended incrementally: only the constraints on the
+ * last state k (the loop closes on it, subformulas at time k + 1 take
+ * their L values) depend on k, they make a group that is disabled
+ * for good when moving on to k + 1.
+ *
  * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
  *
  * This library is free software; you can redistribute it and/or
@@ -27,9 +41,13 @@
 #ifndef LTL_ALGORITHM_H
 #define LTL_ALGORITHM_H
 
+#include <vector>
+
 #include <expr/expr.hh>
 
 #include <algorithms/base.hh>
+#include <algorithms/ltl/tableau.hh>
+
 #include <witness/witness.hh>
 
 typedef enum {
@@ -45,7 +63,13 @@ public:
     LTL(Command& command, Model& model);
     ~LTL();
 
-    void process(const Expr_ptr phi);
+    /* looks for counterexamples to phi of at most bound steps (cfr.
+       set_bound()), under additional constraints. */
+    void process(const Expr_ptr phi, ExprVector constraints);
+
+    /* 0 for no bound */
+    inline void set_bound(step_t bound)
+    { f_bound = bound; }
 
     inline ltl_status_t status() const
     { return f_status; }
@@ -55,13 +79,45 @@ public:
 
 private:
     ltl_status_t f_status;
-};
+    step_t f_bound;
 
-/* Specialized for LTL CEX */
-class LTLCounterExample : public Witness {
-public:
-    LTLCounterExample(Expr_ptr property, Model& model,
-                      Engine& engine, unsigned k);
+    Expr_ptr f_phi;
+    CompilationUnits f_constraint_cus;
+
+    /* tableau of !phi, nodes reachable from the root are live */
+    LTLTableau f_tableau;
+    unsigned f_root;
+    std::vector<bool> f_live;
+
+    /* node -> index in f_atom_cus, for live atoms */
+    std::vector<unsigned> f_atom_index;
+    CompilationUnits f_atom_cus;
+
+    /* per time vars of live nodes, and auxiliary vars of F and U
+       nodes (which may not be fulfilled through the loop back) */
+    std::vector<VarVector> f_vars;
+    std::vector<VarVector> f_aux_vars;
+
+    /* per node L vars, auxiliary ones for F and U nodes */
+    VarVector f_loop_vars;
+
+    /* loop back vars: l_i (i > 0) is the state at time i follows the
+       last state, i.e. the states at times i - 1 and k are equal */
+    VarVector f_loops;
+    VarVector f_in_loop;
+    Var f_loop;
+
+    /* a copy of the last state */
+    VarVector f_end;
+
+    /* encoding */
+    void setup_encoding(Engine& engine);
+    void alloc_time(Engine& engine);
+    void define_time(Engine& engine, step_t time);
+    void close_time(Engine& engine, step_t time);
+
+    /* the loop back time in the last model, UINT_MAX if none */
+    step_t loop_time(Engine& engine);
 };
 
 #endif /* LTL_ALGORITHM_H */
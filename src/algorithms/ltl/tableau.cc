@@ -0,0 +1,628 @@
+/**
+ * @file ltl/tableau.cc
+ * @brief SAT-based SBMC Algorithm for LTL properties checking, LTL tableau implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sstream>
+
+#include <algorithms/ltl/tableau.hh>
+
+static std::string build_unsupported_ltl_formula_error_message(Expr_ptr expr)
+{
+    std::ostringstream oss;
+
+    oss
+        << "Expression `"
+        << expr
+        << "` is not supported in LTL formulas.";
+
+    return oss.str();
+}
+
+UnsupportedLTLFormula::UnsupportedLTLFormula(Expr_ptr expr)
+    : AlgorithmException("UnsupportedLTLFormula",
+                         build_unsupported_ltl_formula_error_message(expr))
+{}
+
+LTLTableau::LTLTableau(ExprMgr& em)
+    : f_em(em)
+{}
+
+LTLTableau::~LTLTableau()
+{}
+
+unsigned LTLTableau::process(Expr_ptr expr, bool negated)
+{
+    f_term_stack.clear();
+
+    (*this)(expr);
+
+    assert(1 == f_term_stack.size());
+
+    unsigned res
+        (as_node(pop_term()));
+
+    return negated ? negate(res) : res;
+}
+
+void LTLTableau::pre_hook()
+{}
+void LTLTableau::post_hook()
+{}
+
+void LTLTableau::pre_node_hook(Expr_ptr expr)
+{}
+void LTLTableau::post_node_hook(Expr_ptr expr)
+{}
+
+unsigned LTLTableau::make_node(ltl_op_t op, Expr_ptr expr,
+                               unsigned lhs, unsigned rhs)
+{
+    boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq>::const_iterator eye
+        (f_node_map.find(expr));
+
+    if (f_node_map.end() != eye)
+        return eye->second;
+
+    unsigned res
+        (f_nodes.size());
+
+    f_nodes.push_back(LTLNode(op, expr, lhs, rhs));
+    f_node_map.insert(std::make_pair(expr, res));
+
+    return res;
+}
+
+unsigned LTLTableau::make_atom(Expr_ptr expr)
+{
+    return make_node(LTL_ATOM, expr);
+}
+
+unsigned LTLTableau::negate(unsigned node)
+{
+    boost::unordered_map<unsigned, unsigned>::const_iterator eye
+        (f_negations.find(node));
+
+    if (f_negations.end() != eye)
+        return eye->second;
+
+    /* a copy, f_nodes grows below */
+    const LTLNode n
+        (f_nodes[node]);
+
+    unsigned res;
+    switch (n.op) {
+    case LTL_ATOM:
+        res = make_atom(f_em.is_not(n.expr)
+                        ? n.expr->lhs()
+                        : f_em.make_not(n.expr));
+        break;
+
+    case LTL_AND:
+    case LTL_OR:
+        {
+            unsigned lhs
+                (negate(n.lhs));
+
+            unsigned rhs
+                (negate(n.rhs));
+
+            Expr_ptr a
+                (f_nodes[lhs].expr);
+
+            Expr_ptr b
+                (f_nodes[rhs].expr);
+
+            res = LTL_AND == n.op
+                ? make_node(LTL_OR, f_em.make_or(a, b), lhs, rhs)
+                : make_node(LTL_AND, f_em.make_and(a, b), lhs, rhs);
+        }
+        break;
+
+    case LTL_X:
+    case LTL_F:
+    case LTL_G:
+        {
+            unsigned lhs
+                (negate(n.lhs));
+
+            Expr_ptr a
+                (f_nodes[lhs].expr);
+
+            if (LTL_X == n.op)
+                res = make_node(LTL_X, f_em.make_X(a), lhs);
+            else if (LTL_F == n.op)
+                res = make_node(LTL_G, f_em.make_G(a), lhs);
+            else
+                res = make_node(LTL_F, f_em.make_F(a), lhs);
+        }
+        break;
+
+    case LTL_U:
+    case LTL_R:
+        {
+            unsigned lhs
+                (negate(n.lhs));
+
+            unsigned rhs
+                (negate(n.rhs));
+
+            Expr_ptr a
+                (f_nodes[lhs].expr);
+
+            Expr_ptr b
+                (f_nodes[rhs].expr);
+
+            res = LTL_U == n.op
+                ? make_node(LTL_R, f_em.make_R(a, b), lhs, rhs)
+                : make_node(LTL_U, f_em.make_U(a, b), lhs, rhs);
+        }
+        break;
+
+    default: assert(false); /* unreachable */
+    } /* switch() */
+
+    f_negations.insert(std::make_pair(node, res));
+    f_negations.insert(std::make_pair(res, node));
+
+    return res;
+}
+
+unsigned LTLTableau::as_node(const LTLTerm& term)
+{
+    return term.temporal
+        ? term.node
+        : make_atom(term.expr);
+}
+
+void LTLTableau::push_expr(Expr_ptr expr)
+{
+    LTLTerm term;
+    term.temporal = false;
+    term.expr = expr;
+    term.node = 0;
+
+    f_term_stack.push_back(term);
+}
+
+void LTLTableau::push_node(unsigned node)
+{
+    LTLTerm term;
+    term.temporal = true;
+    term.expr = f_nodes[node].expr;
+    term.node = node;
+
+    f_term_stack.push_back(term);
+}
+
+LTLTableau::LTLTerm LTLTableau::pop_term()
+{
+    assert(! f_term_stack.empty());
+
+    LTLTerm res
+        (f_term_stack.back());
+    f_term_stack.pop_back();
+
+    return res;
+}
+
+void LTLTableau::propositional(Expr_ptr expr, unsigned arity)
+{
+    for (unsigned i = 0; i < arity; ++ i)
+        if (pop_term().temporal)
+            throw UnsupportedLTLFormula(expr);
+
+    push_expr(expr);
+}
+
+void LTLTableau::boolean(Expr_ptr expr, ltl_op_t op)
+{
+    LTLTerm rhs
+        (pop_term());
+
+    LTLTerm lhs
+        (pop_term());
+
+    if (! lhs.temporal && ! rhs.temporal) {
+        push_expr(expr);
+        return;
+    }
+
+    unsigned a
+        (as_node(lhs));
+
+    unsigned b
+        (as_node(rhs));
+
+    Expr_ptr ea
+        (f_nodes[a].expr);
+
+    Expr_ptr eb
+        (f_nodes[b].expr);
+
+    push_node(LTL_AND == op
+              ? make_node(LTL_AND, f_em.make_and(ea, eb), a, b)
+              : make_node(LTL_OR, f_em.make_or(ea, eb), a, b));
+}
+
+bool LTLTableau::walk_F_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_F_postorder(const Expr_ptr expr)
+{
+    unsigned lhs
+        (as_node(pop_term()));
+
+    push_node(make_node(LTL_F, f_em.make_F(f_nodes[lhs].expr), lhs));
+}
+
+bool LTLTableau::walk_G_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_G_postorder(const Expr_ptr expr)
+{
+    unsigned lhs
+        (as_node(pop_term()));
+
+    push_node(make_node(LTL_G, f_em.make_G(f_nodes[lhs].expr), lhs));
+}
+
+bool LTLTableau::walk_X_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_X_postorder(const Expr_ptr expr)
+{
+    unsigned lhs
+        (as_node(pop_term()));
+
+    push_node(make_node(LTL_X, f_em.make_X(f_nodes[lhs].expr), lhs));
+}
+
+bool LTLTableau::walk_U_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_U_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_U_postorder(const Expr_ptr expr)
+{
+    unsigned rhs
+        (as_node(pop_term()));
+
+    unsigned lhs
+        (as_node(pop_term()));
+
+    push_node(make_node(LTL_U, f_em.make_U(f_nodes[lhs].expr,
+                                           f_nodes[rhs].expr), lhs, rhs));
+}
+
+bool LTLTableau::walk_R_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_R_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_R_postorder(const Expr_ptr expr)
+{
+    unsigned rhs
+        (as_node(pop_term()));
+
+    unsigned lhs
+        (as_node(pop_term()));
+
+    push_node(make_node(LTL_R, f_em.make_R(f_nodes[lhs].expr,
+                                           f_nodes[rhs].expr), lhs, rhs));
+}
+
+/* atoms are state formulas, time shifts are not supported */
+bool LTLTableau::walk_at_preorder(const Expr_ptr expr)
+{ throw UnsupportedLTLFormula(expr); }
+bool LTLTableau::walk_at_inorder(const Expr_ptr expr)
+{ return false; }
+void LTLTableau::walk_at_postorder(const Expr_ptr expr)
+{}
+
+bool LTLTableau::walk_next_preorder(const Expr_ptr expr)
+{ throw UnsupportedLTLFormula(expr); }
+void LTLTableau::walk_next_postorder(const Expr_ptr expr)
+{}
+
+bool LTLTableau::walk_neg_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_neg_postorder(const Expr_ptr expr)
+{ propositional(expr, 1); }
+
+bool LTLTableau::walk_not_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_not_postorder(const Expr_ptr expr)
+{
+    LTLTerm lhs
+        (pop_term());
+
+    if (lhs.temporal)
+        push_node(negate(lhs.node));
+    else
+        push_expr(expr);
+}
+
+bool LTLTableau::walk_bw_not_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_bw_not_postorder(const Expr_ptr expr)
+{
+    LTLTerm lhs
+        (pop_term());
+
+    if (lhs.temporal)
+        push_node(negate(lhs.node));
+    else
+        push_expr(expr);
+}
+
+bool LTLTableau::walk_add_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_add_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_add_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_sub_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_sub_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_sub_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_div_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_div_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_div_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_mod_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_mod_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_mod_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_mul_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_mul_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_mul_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_and_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_and_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_and_postorder(const Expr_ptr expr)
+{ boolean(expr, LTL_AND); }
+
+bool LTLTableau::walk_or_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_or_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_or_postorder(const Expr_ptr expr)
+{ boolean(expr, LTL_OR); }
+
+bool LTLTableau::walk_bw_and_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_bw_and_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_bw_and_postorder(const Expr_ptr expr)
+{ boolean(expr, LTL_AND); }
+
+bool LTLTableau::walk_bw_or_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_bw_or_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_bw_or_postorder(const Expr_ptr expr)
+{ boolean(expr, LTL_OR); }
+
+bool LTLTableau::walk_bw_xor_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_bw_xor_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_bw_xor_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_bw_xnor_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_bw_xnor_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_bw_xnor_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_implies_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_implies_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_implies_postorder(const Expr_ptr expr)
+{
+    LTLTerm rhs
+        (pop_term());
+
+    LTLTerm lhs
+        (pop_term());
+
+    if (! lhs.temporal && ! rhs.temporal) {
+        push_expr(expr);
+        return;
+    }
+
+    /* p -> q is !p | q */
+    unsigned a
+        (negate(as_node(lhs)));
+
+    unsigned b
+        (as_node(rhs));
+
+    push_node(make_node(LTL_OR, f_em.make_or(f_nodes[a].expr,
+                                             f_nodes[b].expr), a, b));
+}
+
+bool LTLTableau::walk_guard_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_guard_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_guard_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_lshift_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_lshift_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_lshift_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_rshift_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_rshift_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_rshift_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_type_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_type_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_type_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_cast_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_cast_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_cast_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_assignment_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_assignment_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_assignment_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_eq_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_eq_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_eq_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_ne_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_ne_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_ne_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_le_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_le_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_le_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_lt_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_lt_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_lt_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_ge_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_ge_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_ge_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_gt_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_gt_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_gt_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_ite_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_ite_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_ite_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_cond_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_cond_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_cond_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_dot_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_dot_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_dot_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_params_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_params_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_params_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_params_comma_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_params_comma_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_params_comma_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_subscript_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_subscript_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_subscript_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_set_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_set_postorder(const Expr_ptr expr)
+{ propositional(expr, 1); }
+
+bool LTLTableau::walk_set_comma_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_set_comma_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_set_comma_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+bool LTLTableau::walk_array_preorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_array_postorder(const Expr_ptr expr)
+{ propositional(expr, 1); }
+
+bool LTLTableau::walk_array_comma_preorder(const Expr_ptr expr)
+{ return true; }
+bool LTLTableau::walk_array_comma_inorder(const Expr_ptr expr)
+{ return true; }
+void LTLTableau::walk_array_comma_postorder(const Expr_ptr expr)
+{ propositional(expr, 2); }
+
+void LTLTableau::walk_leaf(const Expr_ptr expr)
+{ push_expr(expr); }
@@ -0,0 +1,153 @@
+/**
+ * @file ltl/tableau.hh
+ * @brief SAT-based SBMC Algorithm for LTL properties checking, LTL tableau declarations.
+ *
+ * The tableau of an LTL formula is the DAG of its subformulas, in
+ * negation normal form: negations are pushed down to the atoms, which
+ * are the maximal propositional subformulas, by means of the usual
+ * dualities (F/G, U/R, and/or). Nodes are shared, and each node comes
+ * after its operands.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef LTL_TABLEAU_H
+#define LTL_TABLEAU_H
+
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <expr/expr.hh>
+#include <expr/expr_mgr.hh>
+#include <expr/walker/walker.hh>
+
+#include <algorithms/exceptions.hh>
+
+#include <utils/pool.hh>
+
+/** Raised when an LTL formula can not be put in NNF, e.g. temporal
+    operators under arithmetics, or time shift operators */
+class UnsupportedLTLFormula : public AlgorithmException {
+public:
+    UnsupportedLTLFormula(Expr_ptr expr);
+};
+
+typedef enum {
+    LTL_ATOM,
+    LTL_AND,
+    LTL_OR,
+    LTL_X,
+    LTL_F,
+    LTL_G,
+    LTL_U,
+    LTL_R,
+} ltl_op_t;
+
+struct LTLNode {
+    ltl_op_t op;
+
+    /* the subformula (in NNF) */
+    Expr_ptr expr;
+
+    /* operand nodes, lhs only for unary operators, none for atoms */
+    unsigned lhs;
+    unsigned rhs;
+
+    LTLNode(ltl_op_t op_, Expr_ptr expr_, unsigned lhs_, unsigned rhs_)
+        : op(op_)
+        , expr(expr_)
+        , lhs(lhs_)
+        , rhs(rhs_)
+    {}
+};
+
+typedef std::vector<LTLNode> LTLNodes;
+
+class LTLTableau : public ExprWalker {
+public:
+    LTLTableau(ExprMgr& em);
+    ~LTLTableau();
+
+    /**
+     * @brief Adds the NNF of expr (or of its negation, if negated) to
+     * the tableau, returns its root node.
+     */
+    unsigned process(Expr_ptr expr, bool negated = false);
+
+    inline const LTLNodes& nodes() const
+    { return f_nodes; }
+
+    inline const LTLNode& node(unsigned i) const
+    { return f_nodes[i]; }
+
+protected:
+    void pre_hook();
+    void post_hook();
+
+    void pre_node_hook(Expr_ptr expr);
+    void post_node_hook(Expr_ptr expr);
+
+    LTL_HOOKS; OP_HOOKS;
+    void walk_leaf(const Expr_ptr expr);
+
+private:
+    ExprMgr& f_em;
+
+    LTLNodes f_nodes;
+
+    /* NNF subformula -> node */
+    boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq> f_node_map;
+
+    /* node -> node of its negation */
+    boost::unordered_map<unsigned, unsigned> f_negations;
+
+    /* walker stack: propositional subformulas are kept as
+       expressions, and become atoms only when a temporal operator is
+       found above them. */
+    struct LTLTerm {
+        bool temporal;
+        Expr_ptr expr;
+        unsigned node;
+    };
+    std::vector<LTLTerm> f_term_stack;
+
+    unsigned make_node(ltl_op_t op, Expr_ptr expr,
+                       unsigned lhs = 0, unsigned rhs = 0);
+
+    unsigned make_atom(Expr_ptr expr);
+
+    unsigned negate(unsigned node);
+
+    /* term as a node, making an atom if needed */
+    unsigned as_node(const LTLTerm& term);
+
+    void push_expr(Expr_ptr expr);
+    void push_node(unsigned node);
+    LTLTerm pop_term();
+
+    /* expr combines arity propositional terms, into a propositional
+       term */
+    void propositional(Expr_ptr expr, unsigned arity);
+
+    /* expr combines two terms with a boolean operator */
+    void boolean(Expr_ptr expr, ltl_op_t op);
+};
+
+#endif /* LTL_TABLEAU_H */
@@ -0,0 +1,58 @@
+/**
+ * @file ltl/witness.cc
+ * @brief SAT-based SBMC Algorithm for LTL properties checking, LTL CEX witness class implementation.
+ *
+ * This module contains definitions and services that implement the
+ * extraction of a lasso shaped CEX (CounterEXample) witness for
+ * SAT-based LTL model checking algorithm.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithms/base.hh>
+#include <algorithms/ltl/witness.hh>
+
+#include <witness/extractor.hh>
+#include <witness/witness.hh>
+#include <witness/witness_mgr.hh>
+
+LTLCounterExample::LTLCounterExample(Expr_ptr property, Model& model,
+                                     Engine& engine, unsigned k)
+    : Witness()
+{
+    /* raw values only, frames are decoded when first inspected */
+    WitnessSnapshot_ptr snapshot
+        (new WitnessSnapshot(model, true));
+
+    /* Collecting symbols for the witness' language */
+    f_lang = snapshot->extractor().language();
+
+    step_t step
+        (0);
+
+    do {
+
+        extend();
+        snapshot->push_row(engine, step);
+
+        ++ step;
+    } while (step <= k);
+
+    set_snapshot(snapshot);
+} /* LTLCounterExample::LTLCounterExample() */
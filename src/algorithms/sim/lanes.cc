@@ -0,0 +1,473 @@
+/**
+ * @file lanes.cc
+ * @brief Bit-parallel constraint network, implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+#include <cassert>
+
+#include <sim/lanes.hh>
+
+LaneRandom::LaneRandom(uint64_t seed)
+    : f_state(seed ? seed : 0x9e3779b97f4a7c15ULL)
+{}
+
+lanes_t LaneRandom::next()
+{
+    f_state ^= f_state >> 12;
+    f_state ^= f_state << 25;
+    f_state ^= f_state >> 27;
+
+    return f_state * 0x2545f4914f6cdd1dULL;
+}
+
+LaneNetwork::LaneNetwork()
+    : f_active(0)
+{
+    /* the true slot */
+    new_slot(0);
+    f_known[LANE_TRUE] = ALL_LANES;
+    f_value[LANE_TRUE] = ALL_LANES;
+
+    /* the leaves */
+    f_nodes.push_back(LaneNode(LANE_TRUE, LANE_ZERO, LANE_ZERO));
+    f_nodes.push_back(LaneNode(LANE_TRUE, LANE_ONE, LANE_ONE));
+
+    f_can1.push_back(0);
+    f_can0.push_back(ALL_LANES);
+
+    f_can1.push_back(ALL_LANES);
+    f_can0.push_back(0);
+}
+
+LaneNetwork::~LaneNetwork()
+{}
+
+slot_t LaneNetwork::new_slot(unsigned priority)
+{
+    slot_t res
+        (f_known.size());
+
+    f_known.push_back(0);
+    f_value.push_back(0);
+    f_priority.push_back(priority);
+    f_watches.push_back(std::vector<unsigned>());
+
+    /* decision order is rebuilt on next solve() */
+    f_order.clear();
+
+    return res;
+}
+
+void LaneNetwork::add_clause(const LaneClause& clause)
+{
+    unsigned id
+        (f_clauses.size());
+
+    f_clauses.push_back(clause);
+    f_clause_queued.push_back(false);
+
+    for (LaneClause::const_iterator i = clause.begin(); clause.end() != i; ++ i)
+        f_watches[*i / 2].push_back(2 * id);
+
+    if (f_falses.size() < clause.size() + 1) {
+        f_falses.resize(clause.size() + 1);
+        f_suffixes.resize(clause.size() + 1);
+    }
+}
+
+unsigned LaneNetwork::make_node(slot_t slot, unsigned then_node, unsigned else_node)
+{
+    unsigned res
+        (f_nodes.size());
+
+    assert(then_node < res && else_node < res);
+    f_nodes.push_back(LaneNode(slot, then_node, else_node));
+
+    f_can1.push_back(0);
+    f_can0.push_back(0);
+
+    return res;
+}
+
+void LaneNetwork::add_constraint(unsigned root, slot_t target)
+{
+    unsigned id
+        (f_constraints.size());
+
+    f_constraints.push_back(LaneConstraint());
+    f_constraint_queued.push_back(false);
+
+    LaneConstraint& constraint
+        (f_constraints.back());
+
+    constraint.root = root;
+    constraint.target = target;
+
+    /* inner nodes, children first (iterative post-order) */
+    std::vector<bool> seen
+        (f_nodes.size(), false);
+    std::vector<bool> support
+        (f_known.size(), false);
+
+    std::vector< std::pair<unsigned, bool> > stack;
+    stack.push_back(std::pair<unsigned, bool>(root, false));
+
+    while (! stack.empty()) {
+        std::pair<unsigned, bool> top
+            (stack.back());
+        stack.pop_back();
+
+        unsigned node
+            (top.first);
+
+        if (node <= LANE_ONE)
+            continue;
+
+        if (top.second) {
+            constraint.nodes.push_back(node);
+            continue;
+        }
+
+        if (seen[node])
+            continue;
+        seen[node] = true;
+
+        slot_t slot
+            (f_nodes[node].slot);
+
+        if (! support[slot]) {
+            support[slot] = true;
+            constraint.support.push_back(slot);
+        }
+
+        stack.push_back(std::pair<unsigned, bool>(node, true));
+        stack.push_back(std::pair<unsigned, bool>(f_nodes[node].then_node, false));
+        stack.push_back(std::pair<unsigned, bool>(f_nodes[node].else_node, false));
+    }
+
+    for (std::vector<slot_t>::const_iterator i = constraint.support.begin();
+         constraint.support.end() != i; ++ i)
+        f_watches[*i].push_back(2 * id + 1);
+
+    if (LANE_TRUE != target)
+        f_watches[target].push_back(2 * id + 1);
+}
+
+void LaneNetwork::clear()
+{
+    std::fill(f_known.begin() + 1, f_known.end(), 0);
+    std::fill(f_value.begin() + 1, f_value.end(), 0);
+}
+
+void LaneNetwork::assign(slot_t slot, lanes_t value, lanes_t lanes)
+{
+    assert(LANE_TRUE != slot);
+
+    f_known[slot] |= lanes;
+    f_value[slot] = (f_value[slot] & ~ lanes) | (value & lanes);
+}
+
+lanes_t LaneNetwork::solve(lanes_t lanes, LaneRandom& random)
+{
+    if (f_order.empty()) {
+        for (slot_t i = 1; i < f_known.size(); ++ i)
+            f_order.push_back(i);
+
+        std::stable_sort(f_order.begin(), f_order.end(),
+                         [this](slot_t a, slot_t b) {
+                             return f_priority[a] < f_priority[b];
+                         });
+    }
+
+    f_active = lanes;
+    f_trail.clear();
+
+    for (unsigned i = 0; i < f_clauses.size(); ++ i)
+        enqueue(2 * i);
+
+    for (unsigned i = 0; i < f_constraints.size(); ++ i)
+        enqueue(2 * i + 1);
+
+    propagate();
+
+    for (std::vector<slot_t>::const_iterator i = f_order.begin();
+         f_active && f_order.end() != i; ++ i) {
+
+        if (f_active & ~ f_known[*i])
+            decide(*i, random.next());
+    }
+
+    return f_active;
+}
+
+void LaneNetwork::decide(slot_t slot, lanes_t value)
+{
+    lanes_t lanes
+        (f_active & ~ f_known[slot]);
+
+    ++ f_stats.decisions;
+
+    f_trail.clear();
+    set(slot, value, lanes);
+    propagate();
+
+    /* conflicts can only arise in the lanes of the decision */
+    lanes_t failed
+        (lanes & ~ f_active);
+
+    if (failed) {
+        ++ f_stats.flips;
+
+        undo(failed);
+        f_active |= failed;
+
+        f_trail.clear();
+        set(slot, ~ value, failed);
+        propagate();
+    }
+}
+
+void LaneNetwork::set(slot_t slot, lanes_t value, lanes_t lanes)
+{
+    lanes &= ~ f_known[slot];
+    if (! lanes)
+        return;
+
+    f_trail.push_back(LaneUndo(slot, f_known[slot], f_value[slot]));
+
+    f_known[slot] |= lanes;
+    f_value[slot] = (f_value[slot] & ~ lanes) | (value & lanes);
+
+    const std::vector<unsigned>& watches
+        (f_watches[slot]);
+
+    for (std::vector<unsigned>::const_iterator i = watches.begin();
+         watches.end() != i; ++ i)
+        enqueue(*i);
+}
+
+void LaneNetwork::conflict(lanes_t lanes)
+{
+    lanes &= f_active;
+    if (! lanes)
+        return;
+
+    ++ f_stats.conflicts;
+    f_active &= ~ lanes;
+}
+
+void LaneNetwork::undo(lanes_t lanes)
+{
+    for (std::vector<LaneUndo>::const_reverse_iterator i = f_trail.rbegin();
+         f_trail.rend() != i; ++ i) {
+
+        slot_t slot
+            (i->slot);
+
+        f_known[slot] = (f_known[slot] & ~ lanes) | (i->known & lanes);
+        f_value[slot] = (f_value[slot] & ~ lanes) | (i->value & lanes);
+    }
+
+    f_trail.clear();
+}
+
+void LaneNetwork::enqueue(unsigned watch)
+{
+    std::vector<bool>::reference queued
+        (watch & 1
+         ? f_constraint_queued[watch / 2]
+         : f_clause_queued[watch / 2]);
+
+    if (queued)
+        return;
+
+    queued = true;
+    f_queue.push_back(watch);
+}
+
+void LaneNetwork::propagate()
+{
+    for (unsigned head = 0; head < f_queue.size(); ++ head) {
+        unsigned watch
+            (f_queue[head]);
+
+        if (watch & 1) {
+            f_constraint_queued[watch / 2] = false;
+            if (f_active)
+                propagate_constraint(watch / 2);
+        }
+        else {
+            f_clause_queued[watch / 2] = false;
+            if (f_active)
+                propagate_clause(watch / 2);
+        }
+    }
+
+    f_queue.clear();
+}
+
+void LaneNetwork::propagate_clause(unsigned id)
+{
+    const LaneClause& clause
+        (f_clauses[id]);
+
+    unsigned size
+        (clause.size());
+
+    ++ f_stats.propagations;
+
+    lanes_t satisfied
+        (0);
+
+    for (unsigned i = 0; i < size; ++ i) {
+        slot_t slot
+            (clause[i] / 2);
+
+        lanes_t positive
+            (clause[i] & 1 ? ~ f_value[slot] : f_value[slot]);
+
+        satisfied |= f_known[slot] & positive;
+        f_falses[i] = f_known[slot] & ~ positive;
+    }
+
+    lanes_t open
+        (f_active & ~ satisfied);
+
+    if (! open)
+        return;
+
+    f_suffixes[size] = ALL_LANES;
+    for (unsigned i = size; 0 < i; -- i)
+        f_suffixes[i - 1] = f_suffixes[i] & f_falses[i - 1];
+
+    conflict(open & f_suffixes[0]);
+
+    /* units: all the other literals false */
+    lanes_t prefix
+        (ALL_LANES);
+
+    for (unsigned i = 0; i < size; ++ i) {
+        lanes_t unit
+            (f_active & open & prefix & f_suffixes[i + 1]);
+
+        if (unit)
+            set(clause[i] / 2, clause[i] & 1 ? 0 : ALL_LANES, unit);
+
+        prefix &= f_falses[i];
+    }
+}
+
+void LaneNetwork::propagate_constraint(unsigned id)
+{
+    const LaneConstraint& constraint
+        (f_constraints[id]);
+
+    ++ f_stats.propagations;
+
+    eval(constraint, LANE_TRUE, 0);
+
+    unsigned root
+        (constraint.root);
+
+    lanes_t can1
+        (f_can1[root]);
+
+    lanes_t can0
+        (f_can0[root]);
+
+    slot_t target
+        (constraint.target);
+
+    lanes_t need1
+        (f_known[target] & f_value[target]);
+
+    lanes_t need0
+        (f_known[target] & ~ f_value[target]);
+
+    conflict((need1 & ~ can1) | (need0 & ~ can0));
+
+    /* forward: the diagram takes one value only */
+    set(target, can1, f_active & (can1 ^ can0));
+
+    /* backward: some slot of the support can take one value only */
+    lanes_t open
+        (f_active & f_known[target] & can1 & can0);
+
+    for (std::vector<slot_t>::const_iterator i = constraint.support.begin();
+         open && constraint.support.end() != i; ++ i) {
+
+        slot_t slot
+            (*i);
+
+        lanes_t unknown
+            (open & ~ f_known[slot]);
+
+        if (! unknown)
+            continue;
+
+        eval(constraint, slot, ALL_LANES);
+        lanes_t ok1
+            ((need1 & f_can1[root]) | (need0 & f_can0[root]));
+
+        eval(constraint, slot, 0);
+        lanes_t ok0
+            ((need1 & f_can1[root]) | (need0 & f_can0[root]));
+
+        set(slot, ALL_LANES, unknown & ok1 & ~ ok0);
+        set(slot, 0, unknown & ok0 & ~ ok1);
+    }
+}
+
+void LaneNetwork::eval(const LaneConstraint& constraint, slot_t forced, lanes_t value)
+{
+    for (std::vector<unsigned>::const_iterator i = constraint.nodes.begin();
+         constraint.nodes.end() != i; ++ i) {
+
+        const LaneNode& node
+            (f_nodes[*i]);
+
+        lanes_t known
+            (f_known[node.slot]);
+
+        lanes_t v
+            (f_value[node.slot]);
+
+        if (forced == node.slot) {
+            known = ALL_LANES;
+            v = value;
+        }
+
+        unsigned t
+            (node.then_node);
+
+        unsigned e
+            (node.else_node);
+
+        f_can1[*i] =
+            (known & ((v & f_can1[t]) | (~ v & f_can1[e]))) |
+            (~ known & (f_can1[t] | f_can1[e]));
+
+        f_can0[*i] =
+            (known & ((v & f_can0[t]) | (~ v & f_can0[e]))) |
+            (~ known & (f_can0[t] | f_can0[e]));
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file lanes.hh
+ * @brief Bit-parallel constraint network, declarations.
+ *
+ * A network of boolean slots, constrained by clauses and by decision
+ * diagrams, solved for 64 independent assignments at once: each slot
+ * holds one bit per lane in a machine word, a second word tells in
+ * which lanes the value is known.
+ *
+ * Solving alternates propagation and decisions. Clauses propagate
+ * units, diagrams propagate their target in the lanes where it is
+ * determined by the known slots, and any slot of the support that
+ * can only take one value in a lane. Decisions pick random values,
+ * in the order of slot priorities; lanes in conflict after a decision
+ * are restored and take the opposite value, lanes still in conflict
+ * are given up.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef LANES_H
+#define LANES_H
+
+#include <stdint.h>
+#include <vector>
+
+/* one bit per lane */
+typedef uint64_t lanes_t;
+
+const unsigned LANES (64);
+const lanes_t ALL_LANES (~ (lanes_t) 0);
+
+inline unsigned lanes_count(lanes_t lanes)
+{ return __builtin_popcountll(lanes); }
+
+typedef unsigned slot_t;
+
+/* slot 0 is true in all lanes */
+const slot_t LANE_TRUE (0);
+
+/* literals are 2 * slot + negated */
+typedef unsigned lane_lit_t;
+typedef std::vector<lane_lit_t> LaneClause;
+
+inline lane_lit_t make_lane_lit(slot_t slot, bool negated)
+{ return 2 * slot + (negated ? 1 : 0); }
+
+/* leaf nodes */
+const unsigned LANE_ZERO (0);
+const unsigned LANE_ONE (1);
+
+struct LaneNode {
+    slot_t slot;
+    unsigned then_node;
+    unsigned else_node;
+
+    LaneNode(slot_t slot_, unsigned then_node_, unsigned else_node_)
+        : slot(slot_)
+        , then_node(then_node_)
+        , else_node(else_node_)
+    {}
+};
+
+/* target <-> diagram rooted at root */
+struct LaneConstraint {
+    unsigned root;
+    slot_t target;
+
+    /* inner nodes, children first */
+    std::vector<unsigned> nodes;
+    std::vector<slot_t> support;
+};
+
+struct LaneStats {
+    unsigned long decisions;
+    unsigned long flips;
+    unsigned long conflicts;
+    unsigned long propagations;
+
+    LaneStats()
+        : decisions(0)
+        , flips(0)
+        , conflicts(0)
+        , propagations(0)
+    {}
+};
+
+/* xorshift64*, one word of random bits at a time */
+class LaneRandom {
+public:
+    LaneRandom(uint64_t seed);
+
+    lanes_t next();
+
+private:
+    uint64_t f_state;
+};
+
+class LaneNetwork {
+public:
+    LaneNetwork();
+    ~LaneNetwork();
+
+    /* -- construction --------------------------------------------------- */
+
+    /* slots are decided in order of priority, then of creation */
+    slot_t new_slot(unsigned priority);
+
+    inline unsigned nslots() const
+    { return f_known.size(); }
+
+    void add_clause(const LaneClause& clause);
+
+    /* children must be created first */
+    unsigned make_node(slot_t slot, unsigned then_node, unsigned else_node);
+
+    void add_constraint(unsigned root, slot_t target = LANE_TRUE);
+
+    inline unsigned nclauses() const
+    { return f_clauses.size(); }
+
+    inline unsigned nconstraints() const
+    { return f_constraints.size(); }
+
+    /* -- solving -------------------------------------------------------- */
+
+    /* all slots unknown, in all lanes */
+    void clear();
+
+    /* to be called after clear(), before solve() */
+    void assign(slot_t slot, lanes_t value, lanes_t lanes);
+
+    /* completes the assignment in lanes, returns the lanes where it
+       satisfies all the constraints. The search is incomplete: it may
+       fail in a lane which has a solution. */
+    lanes_t solve(lanes_t lanes, LaneRandom& random);
+
+    inline lanes_t value(slot_t slot) const
+    { return f_value[slot]; }
+
+    inline lanes_t known(slot_t slot) const
+    { return f_known[slot]; }
+
+    inline const LaneStats& stats() const
+    { return f_stats; }
+
+private:
+    std::vector<lanes_t> f_known;
+    std::vector<lanes_t> f_value;
+    std::vector<unsigned> f_priority;
+
+    std::vector<LaneClause> f_clauses;
+    std::vector<LaneNode> f_nodes;
+    std::vector<LaneConstraint> f_constraints;
+
+    /* per slot, 2 * clause or 2 * constraint + 1 */
+    std::vector< std::vector<unsigned> > f_watches;
+
+    std::vector<unsigned> f_queue;
+    std::vector<bool> f_clause_queued;
+    std::vector<bool> f_constraint_queued;
+
+    /* decision order, cfr. new_slot() */
+    std::vector<slot_t> f_order;
+
+    /* previous contents of the slots changed since last decision */
+    struct LaneUndo {
+        slot_t slot;
+        lanes_t known;
+        lanes_t value;
+
+        LaneUndo(slot_t slot_, lanes_t known_, lanes_t value_)
+            : slot(slot_)
+            , known(known_)
+            , value(value_)
+        {}
+    };
+    std::vector<LaneUndo> f_trail;
+
+    /* per node, lanes where the diagram can evaluate to 1 (0) */
+    std::vector<lanes_t> f_can1;
+    std::vector<lanes_t> f_can0;
+
+    /* clause scratch: lanes where each literal is false, and the
+       conjunctions of the suffixes */
+    std::vector<lanes_t> f_falses;
+    std::vector<lanes_t> f_suffixes;
+
+    /* lanes being solved, not in conflict */
+    lanes_t f_active;
+
+    LaneStats f_stats;
+
+    void set(slot_t slot, lanes_t value, lanes_t lanes);
+    void conflict(lanes_t lanes);
+    void undo(lanes_t lanes);
+
+    void enqueue(unsigned watch);
+    void propagate();
+    void propagate_clause(unsigned id);
+    void propagate_constraint(unsigned id);
+
+    /* fills f_can1, f_can0 for the nodes of constraint, slot forced
+       to value unless LANE_TRUE */
+    void eval(const LaneConstraint& constraint, slot_t forced, lanes_t value);
+
+    void decide(slot_t slot, lanes_t value);
+};
+
+#endif /* LANES_H */
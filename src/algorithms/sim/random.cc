@@ -0,0 +1,726 @@
+/**
+ * @file random.cc
+ * @brief Bit-parallel random simulation algorithm implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <climits>
+#include <sstream>
+
+#include <boost/unordered_map.hpp>
+
+#include <sim/random.hh>
+
+#include <sat/inlining.hh>
+
+#include <symb/classes.hh>
+#include <symb/symb_iter.hh>
+
+/* decision priorities: state bits first, then the bits which are
+   functions of them */
+typedef enum {
+    RANDOM_PRIORITY_STATE,
+    RANDOM_PRIORITY_AUX,
+    RANDOM_PRIORITY_SCRATCH,
+    RANDOM_PRIORITY_TARGET,
+} random_priority_t;
+
+typedef boost::unordered_map<Expr_ptr, bool, PtrHash, PtrEq> RandomStateVarsMap;
+
+UnsupportedRandomSimulationModel::UnsupportedRandomSimulationModel(const std::string& message)
+    : AlgorithmException("UnsupportedRandomSimulationModel", message)
+{}
+
+/* Translates compiled units into the slots of a network. The same DD
+   index is a different slot depending on the time the unit is pushed
+   at (the offset): slots are identified by the UCBI of the bit, timed
+   within the network horizon (0 for the initial states, 1 for a
+   step). */
+class LaneTranslator {
+public:
+    LaneTranslator(LaneNetwork& net, const RandomStateVarsMap& state_vars,
+                   step_t horizon)
+        : f_net(net)
+        , f_enc(EncodingMgr::INSTANCE())
+        , f_state_vars(state_vars)
+        , f_horizon(horizon)
+        , f_memo(1 + horizon)
+    {}
+
+    void bind(Expr_ptr expr, step_t time, unsigned bitno, slot_t slot)
+    { f_slots.insert(std::pair<UCBI, slot_t>(UCBI(expr, time, bitno), slot)); }
+
+    /* all the constraints of cu hold */
+    void assert_unit(const CompilationUnit& cu, step_t offset);
+
+    /* a new slot for the formula of cu, its auxiliary constraints
+       hold */
+    slot_t observe_unit(const CompilationUnit& cu, step_t offset);
+
+private:
+    LaneNetwork& f_net;
+    EncodingMgr& f_enc;
+    const RandomStateVarsMap& f_state_vars;
+    step_t f_horizon;
+
+    boost::unordered_map<UCBI, slot_t, UCBIHash, UCBIEq> f_slots;
+
+    /* shared node -> network node, by offset */
+    std::vector< boost::unordered_map<DdNode*, unsigned, PtrHash, PtrEq> > f_memo;
+
+    slot_t slot(int index, step_t offset);
+    unsigned node(DdNode* node, step_t offset);
+
+    /* DD bits of descriptors are projections or constants */
+    lane_lit_t lit(const ADD& add, step_t offset);
+
+    void add_clause(LaneClause& clause);
+
+    void descriptors(const CompilationUnit& cu, step_t offset);
+    void inlined_operator(const InlinedOperatorDescriptor& md, step_t offset);
+};
+
+slot_t LaneTranslator::slot(int index, step_t offset)
+{
+    const UCBI& ucbi
+        (f_enc.find_ucbi(index));
+
+    step_t time
+        (UINT_MAX == ucbi.time() ? UINT_MAX : ucbi.time() + offset);
+
+    bool state
+        (f_state_vars.end() != f_state_vars.find(ucbi.expr()));
+
+    if (UINT_MAX != time && f_horizon < time) {
+        std::ostringstream oss;
+        oss
+            << (state ? "State bit " : "Bit ")
+            << ucbi
+            << " is more than one step apart";
+
+        throw UnsupportedRandomSimulationModel(oss.str());
+    }
+
+    UCBI key
+        (ucbi.expr(), time, ucbi.bitno());
+
+    boost::unordered_map<UCBI, slot_t, UCBIHash, UCBIEq>::const_iterator eye
+        (f_slots.find(key));
+
+    if (f_slots.end() != eye)
+        return eye->second;
+
+    /* state bits are all laid out in advance */
+    if (state) {
+        std::ostringstream oss;
+        oss
+            << "State bit "
+            << ucbi
+            << " has no encoding";
+
+        throw UnsupportedRandomSimulationModel(oss.str());
+    }
+
+    slot_t res
+        (f_net.new_slot(RANDOM_PRIORITY_AUX));
+
+    f_slots.insert(std::pair<UCBI, slot_t>(key, res));
+
+    return res;
+}
+
+/* shared nodes are only read */
+unsigned LaneTranslator::node(DdNode* node, step_t offset)
+{
+    if (cuddIsConstant(node))
+        return cuddV(node) ? LANE_ONE : LANE_ZERO;
+
+    boost::unordered_map<DdNode*, unsigned, PtrHash, PtrEq>& memo
+        (f_memo[offset]);
+
+    boost::unordered_map<DdNode*, unsigned, PtrHash, PtrEq>::const_iterator eye
+        (memo.find(node));
+
+    if (memo.end() != eye)
+        return eye->second;
+
+    unsigned then_node
+        (this->node(cuddT(node), offset));
+
+    unsigned else_node
+        (this->node(cuddE(node), offset));
+
+    unsigned res
+        (f_net.make_node(slot(node->index, offset), then_node, else_node));
+
+    memo.insert(std::pair<DdNode*, unsigned>(node, res));
+
+    return res;
+}
+
+lane_lit_t LaneTranslator::lit(const ADD& add, step_t offset)
+{
+    DdNode* node
+        (add.getNode());
+
+    if (Cudd_IsConstant(node))
+        return make_lane_lit(LANE_TRUE, ! cuddV(node));
+
+    return make_lane_lit(slot(node->index, offset), false);
+}
+
+/* satisfied clauses and false literals are dropped */
+void LaneTranslator::add_clause(LaneClause& clause)
+{
+    LaneClause res;
+
+    for (LaneClause::const_iterator i = clause.begin(); clause.end() != i; ++ i) {
+        if (make_lane_lit(LANE_TRUE, false) == *i)
+            return;
+
+        if (make_lane_lit(LANE_TRUE, true) != *i)
+            res.push_back(*i);
+    }
+
+    f_net.add_clause(res);
+    clause.clear();
+}
+
+void LaneTranslator::assert_unit(const CompilationUnit& cu, step_t offset)
+{
+    const DDVector& dds
+        (cu.dds());
+
+    for (DDVector::const_iterator i = dds.begin(); dds.end() != i; ++ i)
+        f_net.add_constraint(node((*i).getNode(), offset));
+
+    descriptors(cu, offset);
+}
+
+slot_t LaneTranslator::observe_unit(const CompilationUnit& cu, step_t offset)
+{
+    const DDVector& dds
+        (cu.dds());
+
+    /* the formula comes first, ITE and array MUXes activations follow
+       (cfr. Compiler::process()) */
+    slot_t res
+        (f_net.new_slot(RANDOM_PRIORITY_TARGET));
+
+    DDVector::const_iterator i
+        (dds.begin());
+
+    f_net.add_constraint(node((*i).getNode(), offset), res);
+
+    for (++ i; dds.end() != i; ++ i)
+        f_net.add_constraint(node((*i).getNode(), offset));
+
+    descriptors(cu, offset);
+
+    return res;
+}
+
+void LaneTranslator::descriptors(const CompilationUnit& cu, step_t offset)
+{
+    const InlinedOperatorDescriptors& inlined_operator_descriptors
+        (cu.inlined_operator_descriptors());
+
+    for (InlinedOperatorDescriptors::const_iterator i = inlined_operator_descriptors.begin();
+         inlined_operator_descriptors.end() != i; ++ i)
+        inlined_operator(*i, offset);
+
+    LaneClause clause;
+
+    /* ITE muxes: act ? z = x : z = y, cfr. CNFBinarySelectionInliner */
+    const Expr2BinarySelectionDescriptorsMap& binary_selection_descriptors_map
+        (cu.binary_selection_descriptors_map());
+
+    for (Expr2BinarySelectionDescriptorsMap::const_iterator i = binary_selection_descriptors_map.begin();
+         binary_selection_descriptors_map.end() != i; ++ i) {
+
+        const BinarySelectionDescriptors& descriptors
+            (i->second);
+
+        for (BinarySelectionDescriptors::const_iterator j = descriptors.begin();
+             descriptors.end() != j; ++ j) {
+
+            lane_lit_t act
+                (lit(j->aux(), offset));
+
+            for (unsigned k = 0; k < j->width(); ++ k) {
+                lane_lit_t z
+                    (lit(j->z()[k], offset));
+
+                lane_lit_t x
+                    (lit(j->x()[k], offset));
+
+                lane_lit_t y
+                    (lit(j->y()[k], offset));
+
+                for (unsigned pol = 0; pol < 2; ++ pol) {
+                    clause.push_back(act ^ 1);
+                    clause.push_back(z ^ (1 - pol));
+                    clause.push_back(x ^ pol);
+                    add_clause(clause);
+
+                    clause.push_back(act);
+                    clause.push_back(z ^ (1 - pol));
+                    clause.push_back(y ^ pol);
+                    add_clause(clause);
+                }
+            }
+        }
+    }
+
+    /* array muxes: act_j -> z = x_j, cfr. CNFMultiwaySelectionInliner */
+    const MultiwaySelectionDescriptors& array_mux_descriptors
+        (cu.array_mux_descriptors());
+
+    for (MultiwaySelectionDescriptors::const_iterator i = array_mux_descriptors.begin();
+         array_mux_descriptors.end() != i; ++ i) {
+
+        unsigned width
+            (i->elem_width());
+
+        for (unsigned j = 0; j < i->elem_count(); ++ j) {
+            lane_lit_t act
+                (lit(i->acts()[j], offset));
+
+            for (unsigned k = 0; k < width; ++ k) {
+                lane_lit_t z
+                    (lit(i->z()[k], offset));
+
+                lane_lit_t x
+                    (lit(i->x()[k + j * width], offset));
+
+                for (unsigned pol = 0; pol < 2; ++ pol) {
+                    clause.push_back(act ^ 1);
+                    clause.push_back(z ^ (1 - pol));
+                    clause.push_back(x ^ pol);
+                    add_clause(clause);
+                }
+            }
+        }
+    }
+}
+
+void LaneTranslator::inlined_operator(const InlinedOperatorDescriptor& md, step_t offset)
+{
+    const LitsVector& clauses
+        (InlinedOperatorMgr::INSTANCE()
+         .require(md.ios())
+         .clauses());
+
+    int width
+        (ios_width(md.ios()));
+
+    /* operand bits, cfr. CNFOperatorInliner::inject() */
+    std::vector<lane_lit_t> bits;
+    for (int i = 0; i < width; ++ i)
+        bits.push_back(lit(md.is_relational()
+                           ? md.z()[0]
+                           : md.z()[width - i - 1], offset));
+
+    for (int i = 0; i < width; ++ i)
+        bits.push_back(lit(md.x()[width - i - 1], offset));
+
+    if (md.is_binary())
+        for (int i = 0; i < width; ++ i)
+            bits.push_back(lit(md.y()[width - i - 1], offset));
+
+    /* microcode vars, distinct for each injection */
+    std::vector<slot_t> scratch;
+
+    LaneClause clause;
+    for (LitsVector::const_iterator i = clauses.begin(); clauses.end() != i; ++ i) {
+
+        for (Lits::const_iterator j = i->begin(); i->end() != j; ++ j) {
+            int lit_var
+                (Minisat::var(*j));
+
+            bool lit_sign
+                (Minisat::sign(*j));
+
+            if (lit_var < 3 * width) {
+                assert(lit_var < (int) bits.size());
+                clause.push_back(bits[lit_var] ^ (lit_sign ? 1 : 0));
+                continue;
+            }
+
+            unsigned ndx
+                (lit_var - 3 * width);
+
+            while (scratch.size() <= ndx)
+                scratch.push_back(f_net.new_slot(RANDOM_PRIORITY_SCRATCH));
+
+            clause.push_back(make_lane_lit(scratch[ndx], lit_sign));
+        }
+
+        add_clause(clause);
+    }
+}
+
+RandomSimulation::RandomSimulation(Command& command, Model& model)
+    : Algorithm(command, model)
+    , f_status(RANDOM_SIMULATION_DONE)
+    , f_traces(0)
+    , f_states(0)
+    , f_abandoned(0)
+    , f_offsets(LANES, 0)
+{}
+
+RandomSimulation::~RandomSimulation()
+{}
+
+void RandomSimulation::process(const ExprVector& targets,
+                               const ExprVector& constraints,
+                               step_t steps, unsigned traces,
+                               unsigned seed)
+{
+    Expr_ptr ctx { em().make_empty() };
+
+    try {
+        /* only the cone of influence of targets and constraints is
+           relevant */
+        ExprVector roots
+            (constraints);
+        roots.insert(roots.end(), targets.begin(), targets.end());
+
+        if (roots.empty())
+            setup();
+        else
+            setup(roots);
+
+        if (! ok())
+            throw FailedSetup();
+
+        CompilationUnits constraint_cus;
+        std::for_each(begin(constraints),
+                      end(constraints),
+                      [this, ctx, &constraint_cus](Expr_ptr expr) {
+                          INFO
+                              << "Compiling constraint `"
+                              << expr
+                              << "` ..."
+                              << std::endl;
+
+                          constraint_cus.push_back(mm().compile(ctx, expr));
+                      });
+
+        CompilationUnits target_cus;
+        std::for_each(begin(targets),
+                      end(targets),
+                      [this, ctx, &target_cus](Expr_ptr expr) {
+                          INFO
+                              << "Compiling target `"
+                              << expr
+                              << "` ..."
+                              << std::endl;
+
+                          target_cus.push_back(mm().compile(ctx, expr));
+                          f_target_stats.push_back(RandomTargetStats(expr));
+                      });
+
+        setup_layout();
+        setup_networks(target_cus, constraint_cus);
+    }
+
+    catch (Exception& e) {
+        std::cerr
+            << e.what()
+            << std::endl;
+
+        f_status = RANDOM_SIMULATION_ERROR;
+        return;
+    }
+
+    clock_t t0 = clock(), t1;
+    double secs;
+
+    LaneRandom random
+        (seed);
+
+    unsigned ntargets
+        (f_target_stats.size());
+
+    for (unsigned base = 0; base < traces; base += LANES) {
+
+        unsigned n
+            (std::min(LANES, traces - base));
+
+        lanes_t lanes
+            (LANES == n ? ALL_LANES : ((lanes_t) 1 << n) - 1);
+
+        f_hits.assign(ntargets, 0);
+
+        lanes_t live
+            (restart(lanes, random, 0));
+
+        for (step_t k = 1; live && k <= steps; ++ k) {
+
+            f_step_net.clear();
+            for (std::vector<RandomStateBit>::const_iterator i = f_layout.begin();
+                 f_layout.end() != i; ++ i)
+                f_step_net.assign(i->curr, f_state[i - f_layout.begin()], live);
+
+            lanes_t ok
+                (f_step_net.solve(live, random));
+
+            for (unsigned i = 0; i < f_layout.size(); ++ i)
+                f_state[i] = (f_state[i] & ~ ok) | (f_step_net.value(f_layout[i].next) & ok);
+
+            f_states += lanes_count(ok);
+            observe(f_step_net, f_step_targets, ok, k);
+
+            lanes_t dead
+                (live & ~ ok);
+
+            if (dead) {
+                f_abandoned += lanes_count(dead);
+                live = ok | restart(dead, random, k);
+            }
+        }
+
+        flush(lanes);
+    }
+
+    t1 = clock(); secs = (double) (t1 - t0) / (double) CLOCKS_PER_SEC;
+
+    unsigned long nstates
+        (f_states);
+
+    INFO
+        << "Random simulation: "
+        << nstates << " states, took "
+        << secs << " seconds"
+        << std::endl;
+}
+
+lanes_t RandomSimulation::restart(lanes_t lanes, LaneRandom& random, step_t k)
+{
+    flush(lanes);
+
+    f_init_net.clear();
+
+    lanes_t res
+        (f_init_net.solve(lanes, random));
+
+    for (unsigned i = 0; i < f_layout.size(); ++ i)
+        f_state[i] = (f_state[i] & ~ res) | (f_init_net.value(f_layout[i].init) & res);
+
+    for (unsigned lane = 0; lane < LANES; ++ lane)
+        if (res & ((lanes_t) 1 << lane))
+            f_offsets[lane] = k;
+
+    f_traces += lanes_count(res);
+    f_states += lanes_count(res);
+    observe(f_init_net, f_init_targets, res, k);
+
+    unsigned failed
+        (lanes_count(lanes & ~ res));
+
+    if (failed)
+        WARN
+            << "Random simulation: no initial state found for "
+            << failed
+            << " traces"
+            << std::endl;
+
+    return res;
+}
+
+void RandomSimulation::flush(lanes_t lanes)
+{
+    for (unsigned i = 0; i < f_hits.size(); ++ i) {
+        f_target_stats[i].traces += lanes_count(f_hits[i] & lanes);
+        f_hits[i] &= ~ lanes;
+    }
+}
+
+void RandomSimulation::observe(const LaneNetwork& net,
+                               const std::vector<slot_t>& targets,
+                               lanes_t lanes, step_t k)
+{
+    for (unsigned i = 0; i < targets.size(); ++ i) {
+        lanes_t hit
+            (net.value(targets[i]) & lanes);
+
+        if (! hit)
+            continue;
+
+        RandomTargetStats& stats
+            (f_target_stats[i]);
+
+        stats.states += lanes_count(hit);
+
+        /* steps are counted from the start of each trace */
+        for (lanes_t rest = hit; rest; rest &= rest - 1) {
+            step_t step
+                (k - f_offsets[__builtin_ctzll(rest)]);
+
+            if (step < stats.first)
+                stats.first = step;
+        }
+
+        f_hits[i] |= hit;
+    }
+}
+
+void RandomSimulation::setup_layout()
+{
+    EncodingMgr& enc
+        (EncodingMgr::INSTANCE());
+
+    SymbIter symbs
+        (model());
+
+    while (symbs.has_next()) {
+
+        std::pair< Expr_ptr, Symbol_ptr> pair
+            (symbs.next());
+
+        Symbol_ptr symb
+            (pair.second);
+
+        if (! symb->is_variable())
+            continue;
+
+        Variable& var
+            (symb->as_variable());
+
+        /* INPUT vars are compiled as their values */
+        if (var.is_input() ||
+            var.is_temp() ||
+            var.type()->is_instance())
+            continue;
+
+        Expr_ptr full
+            (em().make_dot(pair.first, var.name()));
+
+        Encoding_ptr encoding
+            (var.is_frozen()
+             ? enc.find_encoding(TimedExpr(full, UINT_MAX))
+             : enc.find_encoding(TimedExpr(full, 0)));
+
+        if (! encoding && ! var.is_frozen())
+            encoding = enc.find_encoding(TimedExpr(full, 1));
+
+        /* not in COI */
+        if (! encoding)
+            continue;
+
+        unsigned width
+            (encoding->bits().size());
+
+        for (unsigned i = 0; i < width; ++ i)
+            f_layout.push_back(RandomStateBit(full, i, var.is_frozen()));
+    }
+
+    f_state.assign(f_layout.size(), 0);
+
+    unsigned nbits
+        (f_layout.size());
+
+    DEBUG
+        << "Random simulation: "
+        << nbits
+        << " state bits"
+        << std::endl;
+}
+
+void RandomSimulation::setup_networks(const CompilationUnits& targets,
+                                      const CompilationUnits& constraints)
+{
+    RandomStateVarsMap state_vars;
+    for (std::vector<RandomStateBit>::const_iterator i = f_layout.begin();
+         f_layout.end() != i; ++ i)
+        state_vars.insert(std::pair<Expr_ptr, bool>(i->expr, true));
+
+    LaneTranslator initial
+        (f_init_net, state_vars, 0);
+
+    LaneTranslator step
+        (f_step_net, state_vars, 1);
+
+    /* state slots first */
+    for (std::vector<RandomStateBit>::iterator i = f_layout.begin();
+         f_layout.end() != i; ++ i) {
+
+        i->init = f_init_net.new_slot(RANDOM_PRIORITY_STATE);
+        i->curr = f_step_net.new_slot(RANDOM_PRIORITY_STATE);
+
+        if (i->frozen) {
+            i->next = i->curr;
+
+            initial.bind(i->expr, UINT_MAX, i->bitno, i->init);
+            step.bind(i->expr, UINT_MAX, i->bitno, i->curr);
+        }
+        else {
+            i->next = f_step_net.new_slot(RANDOM_PRIORITY_STATE);
+
+            initial.bind(i->expr, 0, i->bitno, i->init);
+            step.bind(i->expr, 0, i->bitno, i->curr);
+            step.bind(i->expr, 1, i->bitno, i->next);
+        }
+    }
+
+    for (CompilationUnits::const_iterator i = init().begin(); init().end() != i; ++ i)
+        initial.assert_unit(*i, 0);
+
+    /* INVARs and constraints hold in the initial state, and in the
+       next state of a step (current state is known to satisfy them) */
+    for (CompilationUnits::const_iterator i = invar().begin(); invar().end() != i; ++ i) {
+        initial.assert_unit(*i, 0);
+        step.assert_unit(*i, 1);
+    }
+
+    for (CompilationUnits::const_iterator i = constraints.begin(); constraints.end() != i; ++ i) {
+        initial.assert_unit(*i, 0);
+        step.assert_unit(*i, 1);
+    }
+
+    for (CompilationUnits::const_iterator i = trans().begin(); trans().end() != i; ++ i)
+        step.assert_unit(*i, 0);
+
+    for (CompilationUnits::const_iterator i = targets.begin(); targets.end() != i; ++ i) {
+        f_init_targets.push_back(initial.observe_unit(*i, 0));
+        f_step_targets.push_back(step.observe_unit(*i, 1));
+    }
+
+    unsigned init_slots
+        (f_init_net.nslots());
+
+    unsigned step_slots
+        (f_step_net.nslots());
+
+    unsigned step_clauses
+        (f_step_net.nclauses());
+
+    unsigned step_constraints
+        (f_step_net.nconstraints());
+
+    DEBUG
+        << "Random simulation: "
+        << init_slots << " initial state slots, "
+        << step_slots << " step slots, "
+        << step_clauses << " clauses, "
+        << step_constraints << " DD constraints"
+        << std::endl;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file random.hh
+ * @brief Bit-parallel random simulation algorithm, declarations.
+ *
+ * Random traces are simulated 64 at a time, one per lane of a
+ * bit-parallel constraint network (cfr. lanes.hh). The compiled
+ * INIT, INVAR and TRANS units are translated as they are: their DDs
+ * are evaluated on the lanes, inlined operators by the clauses of
+ * their microcode, selections by the same clauses pushed to the SAT
+ * engine. Two networks are built: one for the initial states, and one
+ * for a step, from current to next state. State bits are laid out
+ * after the encodings of the state variables; the current state of
+ * all the lanes is a vector of words, one per state bit.
+ *
+ * Targets are observed in each state reached, lanes where no
+ * successor could be found are abandoned, and restarted from an initial
+ * state. The lane solver is incomplete: an abandoned trace is not
+ * necessarily a deadlock.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef RANDOM_SIMULATION_ALGORITHM_H
+#define RANDOM_SIMULATION_ALGORITHM_H
+
+#include <vector>
+
+#include <algorithms/base.hh>
+
+#include <sim/lanes.hh>
+
+#include <cmd/command.hh>
+
+/** Raised when the model can not be simulated by lanes, e.g. states
+    more than one step apart in a TRANS */
+class UnsupportedRandomSimulationModel : public AlgorithmException {
+public:
+    UnsupportedRandomSimulationModel(const std::string& message);
+};
+
+typedef enum {
+    RANDOM_SIMULATION_DONE,
+    RANDOM_SIMULATION_ERROR,
+} random_simulation_status_t;
+
+struct RandomTargetStats {
+    Expr_ptr target;
+
+    /* traces where the target holds at least once, restarted traces
+       count as new ones */
+    unsigned long traces;
+
+    /* states where the target holds */
+    unsigned long states;
+
+    /* earliest step the target holds at, from the start of its
+       trace, UINT_MAX if none */
+    step_t first;
+
+    RandomTargetStats(Expr_ptr target_)
+        : target(target_)
+        , traces(0)
+        , states(0)
+        , first(UINT_MAX)
+    {}
+};
+
+typedef std::vector<RandomTargetStats> RandomTargetStatsVector;
+
+/* a state bit, and its slots. Frozen bits have the same slot for
+   current and next state */
+struct RandomStateBit {
+    Expr_ptr expr;
+    unsigned bitno;
+    bool frozen;
+
+    slot_t init;
+    slot_t curr;
+    slot_t next;
+
+    RandomStateBit(Expr_ptr expr_, unsigned bitno_, bool frozen_)
+        : expr(expr_)
+        , bitno(bitno_)
+        , frozen(frozen_)
+        , init(LANE_TRUE)
+        , curr(LANE_TRUE)
+        , next(LANE_TRUE)
+    {}
+};
+
+class RandomSimulation : public Algorithm {
+public:
+    RandomSimulation(Command& command, Model& model);
+    ~RandomSimulation();
+
+    /**
+     * @brief Simulates traces random traces of steps steps each,
+     * observing targets. Constraints hold in all states.
+     */
+    void process(const ExprVector& targets, const ExprVector& constraints,
+                 step_t steps, unsigned traces, unsigned seed);
+
+    inline random_simulation_status_t status() const
+    { return f_status; }
+
+    inline const RandomTargetStatsVector& target_stats() const
+    { return f_target_stats; }
+
+    /* traces started, restarted traces included */
+    inline unsigned long traces() const
+    { return f_traces; }
+
+    /* states reached, initial states included */
+    inline unsigned long states() const
+    { return f_states; }
+
+    /* lanes restarted as no successor was found for them */
+    inline unsigned long abandoned() const
+    { return f_abandoned; }
+
+    inline const LaneStats& init_stats() const
+    { return f_init_net.stats(); }
+
+    inline const LaneStats& step_stats() const
+    { return f_step_net.stats(); }
+
+private:
+    random_simulation_status_t f_status;
+
+    std::vector<RandomStateBit> f_layout;
+
+    /* INIT, INVAR, constraints and targets */
+    LaneNetwork f_init_net;
+    std::vector<slot_t> f_init_targets;
+
+    /* TRANS, and next state INVAR, constraints and targets */
+    LaneNetwork f_step_net;
+    std::vector<slot_t> f_step_targets;
+
+    /* current state of all the lanes, one word per state bit */
+    std::vector<lanes_t> f_state;
+
+    RandomTargetStatsVector f_target_stats;
+    unsigned long f_traces;
+    unsigned long f_states;
+    unsigned long f_abandoned;
+
+    /* per lane: the step its current trace started at, and whether
+       each target was hit in it */
+    std::vector<step_t> f_offsets;
+    std::vector<lanes_t> f_hits;
+
+    void setup_layout();
+    void setup_networks(const CompilationUnits& targets,
+                        const CompilationUnits& constraints);
+
+    /* new initial states for lanes at step k, returns the lanes
+       where one was found. The traces lanes were running are over. */
+    lanes_t restart(lanes_t lanes, LaneRandom& random, step_t k);
+
+    /* ends the traces running in lanes, cfr. f_hits */
+    void flush(lanes_t lanes);
+
+    void observe(const LaneNetwork& net, const std::vector<slot_t>& targets,
+                 lanes_t lanes, step_t k);
+};
+
+#endif /* RANDOM_SIMULATION_ALGORITHM_H */
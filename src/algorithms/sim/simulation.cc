@@ -25,6 +25,8 @@
 
 #include <sim/simulation.hh>
 
+#include <env/environment.hh>
+
 #include <symb/typedefs.hh>
 #include <symb/classes.hh>
 #include <symb/symb_iter.hh>
@@ -35,6 +37,10 @@
 static unsigned progressive = 0;
 static const char *simulation_trace_prfx = "sim_";
 
+static const char* SIM_WINDOW_IDENTIFIER = "sim_window";
+
+static const unsigned DEFAULT_SIM_WINDOW (10);
+
 Simulation::Simulation(Command& command, Model& model)
     : Algorithm(command, model)
 {
@@ -86,7 +92,7 @@ void Simulation::pick_state(bool allsat,
                           << std::endl;
 
                       CompilationUnit unit
-                          (compiler().process(ctx, expr));
+                          (mm().compile(ctx, expr));
 
                       constraint_cus.push_back(unit);
                       ++ nconstraints;
@@ -201,7 +207,10 @@ void Simulation::pick_state(bool allsat,
                 << "simulation initialized, took " << secs
                 << " seconds" << std::endl;
 
-            w = new SimulationWitness( model(), engine, 0);;
+            WitnessExtractor extractor
+                (model());
+
+            w = new SimulationWitness( extractor, engine, 0);
 
             {
                 std::ostringstream oss;
@@ -247,14 +256,11 @@ void Simulation::simulate(Expr_ptr invar_condition,
                           step_t steps,
                           pconst_char trace_name)
 {
-    status_t last_sat;
+    status_t last_sat { STATUS_UNKNOWN };
 
     clock_t t0 = clock(), t1;
     double secs;
 
-    Engine engine
-        ("simulation");
-
     ExprMgr& em
         (ExprMgr::INSTANCE());
 
@@ -269,27 +275,16 @@ void Simulation::simulate(Expr_ptr invar_condition,
 
     set_witness(trace);
 
-    // here we need to push all the values for variables in the last
-    // state of resuming witness. A complete assignment to *all* state
-    // variables guarantees full deterministic behavior.
-    step_t init_time
-        (trace.last_time());
-
     step_t k
-        (init_time);
-
-    TimeFrame& last
-        (trace.last());
-
-    assert_time_frame(engine, k, last);
+        (trace.last_time());
 
-    /* inject full transition relation, trace may not be compatible
-       with current state's INVARs */
-    assert_fsm_invar(engine, k );
-    assert_fsm_trans(engine, k );
-    assert_fsm_invar(engine, 1 + k);
+    /* 0 disables restarts */
+    unsigned window
+        (env_unsigned(SIM_WINDOW_IDENTIFIER, 0, DEFAULT_SIM_WINDOW));
 
-    /* assert additional constraints */
+    /* additional constraints, compiled once and asserted in each
+       simulated step */
+    CompilationUnits conditions;
     if (invar_condition) {
 
         Compiler& cmpl
@@ -299,10 +294,7 @@ void Simulation::simulate(Expr_ptr invar_condition,
             (em.make_empty());
 
         try {
-            CompilationUnit term
-                (cmpl.process(ctx, invar_condition));
-
-            assert_formula( engine, 1 + k, term, 0);
+            conditions.push_back(cmpl.process(ctx, invar_condition));
         }
         catch (Exception& ae) {
             pconst_char what
@@ -324,41 +316,81 @@ void Simulation::simulate(Expr_ptr invar_condition,
         << "Resuming simulation..."
         << std::endl;
 
-    while (STATUS_SAT == (last_sat = engine.solve())) {
+    /* symbols and encoding bits, collected once for all the steps */
+    WitnessExtractor extractor
+        (model());
+
+    bool done
+        (false);
+
+    while (! done) {
 
-        ++ k;
+        /* a fresh engine every `window` steps, so that only the time
+           frames of the current window are live. Here we need to push
+           all the values for variables in the last state of the
+           witness. A complete assignment to *all* state variables
+           guarantees full deterministic behavior. */
+        Engine engine
+            ("simulation");
 
-        t1 = clock(); secs = (double) (t1 - t0) / (double) CLOCKS_PER_SEC;
+        step_t base
+            (k);
 
-        TRACE
-            << "simulation completed step " << k
-            << ", took " << secs << " seconds"
+        assert_time_frame(engine, k, witness().last());
+
+        /* trace may not be compatible with current state's INVARs */
+        assert_fsm_invar(engine, k);
+
+        DEBUG
+            << "Simulation window starts at step " << base
             << std::endl;
 
-        t0 = t1; // resetting clock
+        do {
+            assert_fsm_trans(engine, k);
+            assert_fsm_invar(engine, 1 + k);
 
-        Witness& w
-            (*new SimulationWitness( model(), engine, k));
-        witness().extend(w);
+            std::for_each(begin(conditions),
+                          end(conditions),
+                          [this, &engine, k](CompilationUnit& cu) {
+                              this->assert_formula(engine, 1 + k, cu, 0);
+                          });
 
-        /* no more steps? */
-        if (! -- steps) {
-            f_status = SIMULATION_INTERRUPTED;
-            break;
-        }
+            if (STATUS_SAT != (last_sat = engine.solve())) {
+                done = true;
+                break;
+            }
 
-        /* until condition reached? */
-        if (NULL != until_condition && wm.eval (witness(),
-                                                em.make_empty(),
-                                                until_condition, k)) {
-            f_status = SIMULATION_HALTED;
-            break;
-        }
+            ++ k;
 
-        // TODO: SAT restart after a given number of steps (e.g. 10) would help
-        // preventing performance degradation as k grows larger.
-        assert_fsm_trans(engine, k);
-        assert_fsm_invar(engine, k);
+            t1 = clock(); secs = (double) (t1 - t0) / (double) CLOCKS_PER_SEC;
+
+            TRACE
+                << "simulation completed step " << k
+                << ", took " << secs << " seconds"
+                << std::endl;
+
+            t0 = t1; // resetting clock
+
+            SimulationWitness w
+                (extractor, engine, k);
+            witness().extend(w);
+
+            /* no more steps? */
+            if (! -- steps) {
+                f_status = SIMULATION_INTERRUPTED;
+                done = true;
+                break;
+            }
+
+            /* until condition reached? */
+            if (NULL != until_condition && wm.eval (witness(),
+                                                    em.make_empty(),
+                                                    until_condition, k)) {
+                f_status = SIMULATION_HALTED;
+                done = true;
+                break;
+            }
+        } while (! window || k - base < window);
     }
 
     if (last_sat == STATUS_UNKNOWN)
@@ -372,5 +404,3 @@ void Simulation::simulate(Expr_ptr invar_condition,
         f_status = SIMULATION_DEADLOCKED;
     }
 }
-
-
@@ -29,6 +29,7 @@
 
 #include <algorithms/base.hh>
 
+#include <witness/extractor.hh>
 #include <witness/witness.hh>
 #include <witness/witness_mgr.hh>
 
@@ -52,6 +53,9 @@ public:
                     value_t limit,
                     ExprVector constraints);
 
+    /* Extends the witness by k steps. The SAT engine is restarted
+       every `sim_window` steps from the last state of the witness, so
+       that time and memory per step do not grow with k. */
     void simulate(Expr_ptr invar_condition,
                   Expr_ptr until_condition,
                   ExprVector constraints,
@@ -74,7 +78,8 @@ private:
 class SimulationWitness : public Witness {
 
 public:
-    SimulationWitness(Model& model, Engine& engine, step_t k);
+    /* Step k of the SAT model, extractor is shared among steps */
+    SimulationWitness(WitnessExtractor& extractor, Engine& engine, step_t k);
 };
 
 #endif /* SIMULATION_ALGORITHM_H */
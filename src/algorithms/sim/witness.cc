@@ -25,6 +25,7 @@
 
 #include <env/environment.hh>
 
+#include <witness/extractor.hh>
 #include <witness/witness.hh>
 #include <witness/witness_mgr.hh>
 
@@ -32,149 +33,70 @@
 
 #include <symb/typedefs.hh>
 #include <symb/classes.hh>
-#include <symb/symb_iter.hh>
 
-SimulationWitness::SimulationWitness(Model& model, Engine& engine, step_t k)
+SimulationWitness::SimulationWitness(WitnessExtractor& extractor,
+                                     Engine& engine, step_t k)
     : Witness(&engine)
 {
-    EncodingMgr& bm
-        (EncodingMgr::INSTANCE());
-
-    ExprMgr& em
-        (ExprMgr::INSTANCE());
-
-    int inputs[bm.nbits()];
-
     /* Collecting symbols for the witness' language */
-    SymbIter si (model);
-    while (si.has_next()) {
-
-        std::pair <Expr_ptr, Symbol_ptr> pair
-            (si.next());
-
-        Expr_ptr ctx
-            (pair.first);
-
-        Symbol_ptr symb
-            (pair.second);
-
-        Expr_ptr full_name
-            ( em.make_dot( ctx, symb->name()));
-
-        f_lang.push_back( full_name );
-    }
+    f_lang = extractor.language();
 
     /* just step `k` */
     TimeFrame& tf
         (extend());
 
-    SymbIter symbols
-        (model);
-
-    while (symbols.has_next()) {
-
-        std::pair <Expr_ptr, Symbol_ptr> pair
-            (symbols.next());
-
-        Expr_ptr ctx
-            (pair.first);
-
-        Symbol_ptr symb
-            (pair.second);
+    const WitnessSymbols& variables
+        (extractor.variables());
 
-        Expr_ptr symb_name
-                (symb->name());
+    for (WitnessSymbols::const_iterator i = variables.begin();
+         variables.end() != i; ++ i) {
 
-        Expr_ptr key
-            (em.make_dot( ctx, symb_name));
+        Expr_ptr value
+            (extractor.value(engine, *i, k));
 
-        if (symb->is_variable()) {
-
-            const Variable& var
-                (symb->as_variable());
-
-            /* INPUT vars are in fact bodyless, typed DEFINEs */
-            if (var.is_input()) {
-                Expr_ptr value
-                    (Environment::INSTANCE().get(symb_name));
-
-                if (value)
-                    tf.set_value( key, value, symb->format());
-            }
-
-            else {
-
-                /* time it, and fetch encoding for enc mgr */
-                Encoding_ptr enc
-                    (bm.find_encoding( TimedExpr(key, 0)) );
+        if (value)
+            tf.set_value( i->key, value, i->symb->format());
+    }
 
-                /* not in COI, skipping... */
-                if ( ! enc )
-                    continue;
+    const WitnessSymbols& inputs
+        (extractor.inputs());
 
-                /* 1. for each bit int the encoding, fetch UCBI, time
-                   it into TCBI, fetch its value in solver model and
-                   set the corresponding entry in inputs array. */
-                DDVector::const_iterator di;
-                unsigned ndx;
-                for (ndx = 0, di = enc->bits().begin();
-                     enc->bits().end() != di; ++ ndx, ++ di) {
+    for (WitnessSymbols::const_iterator i = inputs.begin();
+         inputs.end() != i; ++ i) {
 
-                    unsigned bit
-                        ((*di).getNode()->index);
+        Expr_ptr value
+            (Environment::INSTANCE().get(i->symb->name()));
 
-                    const UCBI& ucbi
-                        (bm.find_ucbi(bit));
+        if (value)
+            tf.set_value( i->key, value, i->symb->format());
+    }
 
-                    const TCBI tcbi
-                        (TCBI(ucbi, k));
+    WitnessMgr& wm
+        (WitnessMgr::INSTANCE());
 
-                    Var var
-                        (engine.tcbi_to_var(tcbi));
+    const WitnessSymbols& defines
+        (extractor.defines());
 
-                    int value
-                        (engine.value(var)); /* Don't care is assigned
-                                                to 0 */
+    for (WitnessSymbols::const_iterator i = defines.begin();
+         defines.end() != i; ++ i) {
 
-                    inputs[bit] = value;
-                }
+        const Define& define
+            (i->symb->as_define());
 
-                /* 2. eval the encoding DDs with inputs and put
-                   resulting value into time frame container. */
-                Expr_ptr value
-                    (enc->expr(inputs));
+        try {
+            Expr_ptr value
+                (wm.eval( *this, i->ctx, define.body(), 0));
 
-                if (value)
-                    tf.set_value( key, value, symb->format());
-            }
+            if (value)
+                tf.set_value( i->key, value);
         }
 
-        else if (symb->is_define()) {
-
-            WitnessMgr& wm
-                (WitnessMgr::INSTANCE());
-
-            const Define& define
-                (symb->as_define());
-
-            Expr_ptr body
-                (define.body());
-
-            try {
-                Expr_ptr value
-                    (wm.eval( *this, ctx, body, 0));
-
-                if (value)
-                    tf.set_value( key, value);
-            }
-
-            catch (NoValue nv) {
-                WARN
-                    << "Cannot evaluate define `"
-                    << key
-                    << " `"
-                    << std::endl;
-            }
+        catch (NoValue nv) {
+            WARN
+                << "Cannot evaluate define `"
+                << i->key
+                << " `"
+                << std::endl;
         }
     }
 }
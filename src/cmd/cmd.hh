@@ -37,11 +37,13 @@
 #include <cmd/commands/dump_model.hh>
 
 #include <cmd/commands/check_init.hh>
+#include <cmd/commands/check_ltl.hh>
 #include <cmd/commands/check_trans.hh>
 #include <cmd/commands/reach.hh>
 
 #include <cmd/commands/pick_state.hh>
 #include <cmd/commands/simulate.hh>
+#include <cmd/commands/random_simulate.hh>
 
 #include <cmd/commands/list_traces.hh>
 #include <cmd/commands/dump_trace.hh>
@@ -95,12 +97,18 @@ public:
     inline Command_ptr make_check_trans()
     { return new CheckTrans(f_interpreter); }
 
+    inline Command_ptr make_check_ltl()
+    { return new CheckLTL(f_interpreter); }
+
     inline Command_ptr make_pick_state()
     { return new PickState(f_interpreter); }
 
     inline Command_ptr make_simulate()
     { return new Simulate(f_interpreter); }
 
+    inline Command_ptr make_random_simulate()
+    { return new RandomSimulate(f_interpreter); }
+
     inline Command_ptr make_list_traces()
     { return new ListTraces(f_interpreter); }
 
@@ -153,6 +161,9 @@ public:
     inline CommandTopic_ptr topic_check_trans()
     { return new CheckTransTopic(f_interpreter); }
 
+    inline CommandTopic_ptr topic_check_ltl()
+    { return new CheckLTLTopic(f_interpreter); }
+
     inline CommandTopic_ptr topic_reach()
     { return new ReachTopic(f_interpreter); }
 
@@ -162,6 +173,9 @@ public:
     inline CommandTopic_ptr topic_simulate()
     { return new SimulateTopic(f_interpreter); }
 
+    inline CommandTopic_ptr topic_random_simulate()
+    { return new RandomSimulateTopic(f_interpreter); }
+
     inline CommandTopic_ptr topic_list_traces()
     { return new ListTracesTopic(f_interpreter); }
 
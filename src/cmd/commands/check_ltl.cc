@@ -0,0 +1,313 @@
+/**
+ * @file check_ltl.cc
+ * @brief Command `check-ltl` class implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <cstdlib>
+#include <cstring>
+
+#include <cmd/commands/commands.hh>
+#include <cmd/commands/check_ltl.hh>
+#include <cmd/commands/reach.hh>
+
+#include <algorithms/ltl/l2s.hh>
+
+CheckLTL::CheckLTL(Interpreter& owner)
+    : Command(owner)
+    , f_out(std::cout)
+    , f_property(NULL)
+    , f_constraints()
+    , f_bound(0)
+    , f_strategies()
+{}
+
+CheckLTL::~CheckLTL()
+{
+    f_constraints.clear();
+}
+
+void CheckLTL::set_property(Expr_ptr property)
+{
+    f_property = property;
+}
+
+void CheckLTL::add_constraint(Expr_ptr constraint)
+{
+    f_constraints.push_back(constraint);
+}
+
+void CheckLTL::set_bound(step_t bound)
+{
+    f_bound = bound;
+}
+
+void CheckLTL::add_strategy(pconst_char strategy)
+{
+    bmc_strategy_t value;
+
+    if (! bmc_strategy_from_name(strategy, value))
+        throw UnsupportedStrategy(strategy);
+
+    f_strategies.push_back(BMCStrategy(value));
+}
+
+bool CheckLTL::check_requirements()
+{
+    ModelMgr& mm
+        (ModelMgr::INSTANCE());
+
+    Model& model
+        (mm.model());
+
+    if (! f_property) {
+        f_out
+            << wrnPrefix
+            << "No property given. Aborting..."
+            << std::endl;
+
+        return false;
+    }
+
+    if (0 == model.modules().size()) {
+        f_out
+            << wrnPrefix
+            << "Model not loaded."
+            << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+Variant CheckLTL::operator()()
+{
+    if (! check_requirements())
+        return Variant(errMessage);
+
+    bool res
+        (f_strategies.empty() ? check_ltl() : check_l2s());
+
+    return Variant(res ? okMessage : errMessage);
+}
+
+bool CheckLTL::check_ltl()
+{
+    OptsMgr& om
+        (OptsMgr::INSTANCE());
+
+    bool res { false };
+
+    LTL ltl { *this, ModelMgr::INSTANCE().model() };
+    ltl.set_bound(f_bound);
+    ltl.process(f_property, f_constraints);
+
+    switch (ltl.status()) {
+    case LTL_FALSE:
+        if (! om.quiet())
+            f_out
+                << outPrefix;
+        f_out
+            << "Property is FALSE";
+
+        if (ltl.has_witness()) {
+            Witness& w
+                (ltl.witness());
+
+            f_out
+                << ", registered witness `"
+                << w.id()
+                << "`, "
+                << w.size()
+                << " steps";
+
+            if (w.has_loop())
+                f_out
+                    << ", loop back to time "
+                    << w.loop_time();
+        }
+
+        f_out
+            << "."
+            << std::endl;
+        res = true;
+        break;
+
+    case LTL_TRUE:
+        if (! om.quiet())
+            f_out
+                << outPrefix;
+        f_out
+            << "Property is TRUE."
+            << std::endl;
+        res = true;
+        break;
+
+    case LTL_UNKNOWN:
+        if (! om.quiet())
+            f_out
+                << wrnPrefix;
+        f_out
+            << "No counterexample found";
+
+        if (f_bound)
+            f_out
+                << " within "
+                << f_bound
+                << " steps";
+
+        f_out
+            << "."
+            << std::endl;
+        break;
+
+    case LTL_ERROR:
+        f_out
+            << "Unexpected error."
+            << std::endl;
+        break;
+
+    default: assert(false); /* unexpected */
+    } /* switch */
+
+    return res;
+}
+
+bool CheckLTL::check_l2s()
+{
+    OptsMgr& om
+        (OptsMgr::INSTANCE());
+
+    bool res { false };
+
+    Model& model
+        (ModelMgr::INSTANCE().model());
+
+    /* the monitor lives as long as l2s does */
+    LivenessToSafety l2s { model };
+    Expr_ptr target;
+
+    /* as in LTL::process(), the formula is reported as an error */
+    try {
+        target = l2s.process(f_property);
+    }
+
+    catch (UnsupportedLTLFormula& e) {
+        std::cerr
+            << e.what()
+            << std::endl;
+
+        f_out
+            << "Unexpected error."
+            << std::endl;
+
+        return false;
+    }
+
+    BMC bmc { *this, model };
+    std::for_each(begin(f_strategies),
+                  end(f_strategies),
+                  [&bmc](const BMCStrategy& strategy) {
+                      bmc.add_strategy(strategy);
+                  });
+    bmc.process(target, f_constraints);
+
+    switch (bmc.status()) {
+    case BMC_REACHABLE:
+        if (! om.quiet())
+            f_out
+                << outPrefix;
+        f_out
+            << "Property is FALSE";
+
+        if (bmc.has_witness()) {
+            Witness& w
+                (bmc.witness());
+
+            std::ostringstream oss_desc;
+            oss_desc
+                << "Counterexample for LTL property `"
+                << f_property
+                << "` in module `"
+                << model.main_module().name()
+                << "`" ;
+            w.set_desc(oss_desc.str());
+
+            f_out
+                << ", registered witness `"
+                << w.id()
+                << "`, "
+                << w.size()
+                << " steps";
+
+            if (w.has_loop())
+                f_out
+                    << ", loop back to time "
+                    << w.loop_time();
+        }
+
+        f_out
+            << "."
+            << std::endl;
+        res = true;
+        break;
+
+    case BMC_UNREACHABLE:
+        if (! om.quiet())
+            f_out
+                << outPrefix;
+        f_out
+            << "Property is TRUE."
+            << std::endl;
+        res = true;
+        break;
+
+    case BMC_UNKNOWN:
+        f_out
+            << "Property could not be decided."
+            << std::endl;
+        break;
+
+    case BMC_ERROR:
+        f_out
+            << "Unexpected error."
+            << std::endl;
+        break;
+
+    default: assert(false); /* unexpected */
+    } /* switch */
+
+    return res;
+}
+
+CheckLTLTopic::CheckLTLTopic(Interpreter& owner)
+    : CommandTopic(owner)
+{}
+
+CheckLTLTopic::~CheckLTLTopic()
+{
+    TRACE
+        << "Destroyed check-ltl topic"
+        << std::endl;
+}
+
+void CheckLTLTopic::usage()
+{ display_manpage("check-ltl"); }
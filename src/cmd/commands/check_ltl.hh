@@ -0,0 +1,83 @@
+/**
+ * @file check_ltl.hh
+ * @brief Command-interpreter subsystem related classes and definitions.
+ *
+ * This header file contains the handler inteface for the `check-ltl`
+ * command.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef CHECK_LTL_CMD_H
+#define CHECK_LTL_CMD_H
+
+#include <cmd/command.hh>
+#include <algorithms/bmc/bmc.hh>
+#include <algorithms/ltl/ltl.hh>
+
+class CheckLTL : public Command {
+public:
+    CheckLTL(Interpreter& owner);
+    virtual ~CheckLTL();
+
+    /** cmd params */
+    void set_property(Expr_ptr property);
+    void add_constraint(Expr_ptr constraint);
+    void set_bound(step_t bound);
+    void add_strategy(pconst_char strategy);
+
+    /* run() */
+    Variant virtual operator()();
+
+private:
+    std::ostream& f_out;
+
+    /* the LTL property to be verified */
+    Expr_ptr f_property;
+
+    /* (optional) additional constraints */
+    ExprVector f_constraints;
+
+    /* (optional) max counterexample length, 0 for no bound */
+    step_t f_bound;
+
+    /* (optional) reachability strategies, for liveness to safety */
+    BMCStrategies f_strategies;
+
+    // -- helpers -------------------------------------------------------------
+    bool check_requirements();
+
+    /* check by bounded LTL model checking */
+    bool check_ltl();
+
+    /* check by liveness to safety and reachability */
+    bool check_l2s();
+};
+
+typedef CheckLTL* CheckLTL_ptr;
+
+class CheckLTLTopic : public CommandTopic {
+public:
+    CheckLTLTopic(Interpreter& owner);
+    virtual ~CheckLTLTopic();
+
+    void virtual usage();
+};
+
+#endif /* CHECK_LTL_CMD_H */
@@ -155,7 +155,13 @@ void DumpTrace::dump_plain(std::ostream& os, Witness& w)
 
         os
             << ":: @"
-            << time
+            << time;
+
+        if (w.has_loop() && w.loop_time() == time)
+            os
+                << " (loop)";
+
+        os
             << std::endl;
 
         ExprVector state_vars_assignments;
@@ -228,6 +234,10 @@ void DumpTrace::dump_json(std::ostream& os, Witness& w)
         << std::endl << FIRST_LVL << "\"id\": " << "\"" << w.id() << "\"" << ","
         << std::endl << FIRST_LVL << "\"description\": " << "\"" << w.desc() << "\"" << "," ;
 
+    if (w.has_loop())
+        os
+            << std::endl << FIRST_LVL << "\"loop\": " << w.loop_time() << "," ;
+
     ExprVector input_vars_assignments;
     process_input(w, input_vars_assignments);
 
@@ -321,7 +331,14 @@ void DumpTrace::dump_yaml(std::ostream& os, Witness& w)
         << YAML::Key << "id"
         << YAML::Value << w.id()
         << YAML::Key << "description"
-        << YAML::Value << w.desc()
+        << YAML::Value << w.desc();
+
+    if (w.has_loop())
+        out
+            << YAML::Key << "loop"
+            << YAML::Value << w.loop_time();
+
+    out
         << YAML::EndMap;
 
     ExprVector input_assignments;
@@ -563,7 +580,13 @@ void DumpTrace::dump_xml(std::ostream& os, Witness& w)
         << std::endl
         << "<witness"
         << " id=\"" << w.id() << "\""
-        << " description=\"" << w.desc() << "\""
+        << " description=\"" << w.desc() << "\"" ;
+
+    if (w.has_loop())
+        os
+            << " loop=\"" << w.loop_time() << "\"" ;
+
+    os
         << ">"
         << std::endl;
 
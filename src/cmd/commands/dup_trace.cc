@@ -23,6 +23,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <sstream>
 
 #include <cmd/commands/commands.hh>
 #include <cmd/commands/dup_trace.hh>
@@ -62,13 +63,54 @@ void DupTrace::set_duplicate_id(pconst_char duplicate_id)
 
 Variant DupTrace::operator()()
 {
+    WitnessMgr& wm
+        (WitnessMgr::INSTANCE());
+
     /* FIXME: implement stream redirection for std{out,err} */
     std::ostream& out
         (std::cout);
 
+    Atom wid = { f_trace_id
+                 ? Atom(f_trace_id)
+                 : wm.current().id() };
+    Witness& w
+        (wm.witness(wid));
+
+    /* the duplicate shares the layout of the original, only the
+       packed values are copied */
+    Witness_ptr dup
+        (new Witness(w));
+
+    if (f_duplicate_id)
+        dup->set_id(f_duplicate_id);
+
+    else {
+        std::ostringstream oss_id;
+        oss_id
+            << "dup_"
+            << wm.autoincrement();
+        dup->set_id(oss_id.str());
+    }
+
+    std::ostringstream oss_desc;
+    oss_desc
+        << "Duplicate of witness `"
+        << wid
+        << "`";
+    dup->set_desc(oss_desc.str());
+
+    wm.record(*dup);
+    wm.set_current(*dup);
+
     out
         << outPrefix
-        << "WARNING: this commands currently does nothing!"
+        << "Registered witness `"
+        << dup->id()
+        << "`, duplicate of `"
+        << wid
+        << "`, "
+        << dup->size()
+        << " steps."
         << std::endl;
 
     return Variant(okMessage);
@@ -132,6 +132,7 @@ Variant Help::operator()()
     std::cout
       << "Available topics: " << std::endl
       << "- check-init" << std::endl
+      << "- check-ltl" << std::endl
       << "- check-trans" << std::endl
       << "- clear" << std::endl
       << "- do" << std::endl
@@ -146,6 +147,7 @@ Variant Help::operator()()
       << "- on" << std::endl
       << "- pick-state" << std::endl
       << "- quit" << std::endl
+      << "- random-simulate" << std::endl
       << "- reach" << std::endl
       << "- read-model" << std::endl
       << "- set" << std::endl
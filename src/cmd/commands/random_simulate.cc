@@ -0,0 +1,179 @@
+/**
+ * @file random_simulate.cc
+ * @brief Command `random-simulate` class implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <cmd/commands/commands.hh>
+#include <cmd/commands/random_simulate.hh>
+
+InvalidTracesNumber::InvalidTracesNumber()
+    : CommandException("CommandError: number of traces must be positive.")
+{}
+
+RandomSimulate::RandomSimulate(Interpreter& owner)
+    : Command(owner)
+    , f_out(std::cout)
+    , f_targets()
+    , f_constraints()
+    , f_k(100)
+    , f_traces(LANES)
+    , f_seed(1)
+{}
+
+RandomSimulate::~RandomSimulate()
+{
+    f_targets.clear();
+    f_constraints.clear();
+}
+
+void RandomSimulate::add_target(Expr_ptr target)
+{
+    f_targets.push_back(target);
+}
+
+void RandomSimulate::add_constraint(Expr_ptr constraint)
+{
+    f_constraints.push_back(constraint);
+}
+
+void RandomSimulate::set_k(step_t k)
+{
+    f_k = k;
+}
+
+void RandomSimulate::set_traces(unsigned traces)
+{
+    if (! traces)
+        throw InvalidTracesNumber();
+
+    f_traces = traces;
+}
+
+void RandomSimulate::set_seed(unsigned seed)
+{
+    f_seed = seed;
+}
+
+bool RandomSimulate::check_requirements()
+{
+    ModelMgr& mm
+        (ModelMgr::INSTANCE());
+
+    Model& model
+        (mm.model());
+
+    if (0 == model.modules().size()) {
+        f_out
+            << wrnPrefix
+            << "Model not loaded."
+            << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+Variant RandomSimulate::operator()()
+{
+    OptsMgr& om
+        (OptsMgr::INSTANCE());
+
+    if (! check_requirements())
+        return Variant(errMessage);
+
+    RandomSimulation sim
+        (*this, ModelMgr::INSTANCE().model());
+
+    sim.process(f_targets, f_constraints, f_k, f_traces, f_seed);
+
+    if (RANDOM_SIMULATION_ERROR == sim.status()) {
+        f_out
+            << "Unexpected error."
+            << std::endl;
+
+        return Variant(errMessage);
+    }
+
+    if (! om.quiet())
+        f_out
+            << outPrefix;
+    f_out
+        << "Random simulation done, "
+        << sim.traces()
+        << " traces, "
+        << sim.states()
+        << " states, "
+        << sim.abandoned()
+        << " abandoned traces."
+        << std::endl;
+
+    const RandomTargetStatsVector& stats
+        (sim.target_stats());
+
+    for (RandomTargetStatsVector::const_iterator i = stats.begin();
+         stats.end() != i; ++ i) {
+
+        if (! i->traces) {
+            if (! om.quiet())
+                f_out
+                    << wrnPrefix;
+            f_out
+                << "Target `"
+                << i->target
+                << "` never hit."
+                << std::endl;
+
+            continue;
+        }
+
+        if (! om.quiet())
+            f_out
+                << outPrefix;
+        f_out
+            << "Target `"
+            << i->target
+            << "` hit in "
+            << i->traces
+            << " traces, "
+            << i->states
+            << " states, first at step "
+            << i->first
+            << "."
+            << std::endl;
+    }
+
+    return Variant(okMessage);
+}
+
+RandomSimulateTopic::RandomSimulateTopic(Interpreter& owner)
+    : CommandTopic(owner)
+{}
+
+RandomSimulateTopic::~RandomSimulateTopic()
+{
+    TRACE
+        << "Destroyed random-simulate topic"
+        << std::endl;
+}
+
+void RandomSimulateTopic::usage()
+{ display_manpage("random-simulate"); }
@@ -0,0 +1,84 @@
+/**
+ * @file random_simulate.hh
+ * @brief Command-interpreter subsystem related classes and definitions.
+ *
+ * This header file contains the handler inteface for the
+ * `random-simulate` command.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef RANDOM_SIMULATE_H_CMD
+#define RANDOM_SIMULATE_H_CMD
+
+#include <cmd/command.hh>
+#include <algorithms/sim/random.hh>
+
+/** Raised when no traces are requested */
+class InvalidTracesNumber : public CommandException {
+public:
+    InvalidTracesNumber();
+};
+
+class RandomSimulate : public Command {
+public:
+    RandomSimulate(Interpreter& owner);
+    virtual ~RandomSimulate();
+
+    Variant virtual operator()();
+
+    /** cmd params */
+    void add_target(Expr_ptr target);
+    void add_constraint(Expr_ptr constraint);
+    void set_k(step_t k);
+    void set_traces(unsigned traces);
+    void set_seed(unsigned seed);
+
+private:
+    std::ostream& f_out;
+
+    /* (optional) targets to be observed */
+    ExprVector f_targets;
+
+    /* (optional) additional constraints */
+    ExprVector f_constraints;
+
+    /* Number of steps of each trace */
+    step_t f_k;
+
+    /* Number of traces */
+    unsigned f_traces;
+
+    unsigned f_seed;
+
+    // -- helpers -------------------------------------------------------------
+    bool check_requirements();
+};
+
+typedef RandomSimulate* RandomSimulate_ptr;
+
+class RandomSimulateTopic : public CommandTopic {
+public:
+    RandomSimulateTopic(Interpreter& owner);
+    virtual ~RandomSimulateTopic();
+
+    void virtual usage();
+};
+
+#endif /* RANDOM_SIMULATE_H_CMD */
@@ -27,16 +27,60 @@
 #include <cmd/commands/commands.hh>
 #include <cmd/commands/reach.hh>
 
+static std::string build_unsupported_uniqueness_mode_error_message(pconst_char mode)
+{
+    std::ostringstream oss;
+
+    oss
+        << "CommandError: uniqueness mode `"
+        << mode
+        << "` is not supported.";
+
+    return oss.str();
+}
+
+UnsupportedUniquenessMode::UnsupportedUniquenessMode(pconst_char mode)
+    : CommandException(build_unsupported_uniqueness_mode_error_message(mode))
+{}
+
+static std::string build_unsupported_strategy_error_message(pconst_char strategy)
+{
+    std::ostringstream oss;
+
+    oss
+        << "CommandError: strategy `"
+        << strategy
+        << "` is not supported.";
+
+    return oss.str();
+}
+
+UnsupportedStrategy::UnsupportedStrategy(pconst_char strategy)
+    : CommandException(build_unsupported_strategy_error_message(strategy))
+{}
+
+InvalidInductionStep::InvalidInductionStep()
+    : CommandException("CommandError: k-induction step must be positive.")
+{}
+
 Reach::Reach(Interpreter& owner)
     : Command(owner)
     , f_out(std::cout)
     , f_target(NULL)
     , f_constraints()
+    , f_uniqueness(BMC_UNIQUENESS_EAGER)
+    , f_strategies()
+    , f_threads(0)
+    , f_threads_set(false)
+    , f_sharing(false)
+    , f_induction_step(1)
+    , f_lemmas()
 {}
 
 Reach::~Reach()
 {
     f_constraints.clear();
+    f_lemmas.clear();
 }
 
 void Reach::set_target(Expr_ptr target)
@@ -49,6 +93,58 @@ void Reach::add_constraint(Expr_ptr constraint)
     f_constraints.push_back(constraint);
 }
 
+void Reach::set_uniqueness(pconst_char mode)
+{
+    if (! strcmp(mode, "eager"))
+        f_uniqueness = BMC_UNIQUENESS_EAGER;
+
+    else if (! strcmp(mode, "lazy"))
+        f_uniqueness = BMC_UNIQUENESS_LAZY;
+
+    else if (! strcmp(mode, "sorting"))
+        f_uniqueness = BMC_UNIQUENESS_SORTING;
+
+    else if (! strcmp(mode, "none"))
+        f_uniqueness = BMC_UNIQUENESS_NONE;
+
+    else throw UnsupportedUniquenessMode(mode);
+}
+
+void Reach::add_strategy(pconst_char strategy, unsigned seed,
+                         pconst_char backend)
+{
+    bmc_strategy_t value;
+
+    if (! bmc_strategy_from_name(strategy, value))
+        throw UnsupportedStrategy(strategy);
+
+    f_strategies.push_back(BMCStrategy(value, seed, backend ? backend : ""));
+}
+
+void Reach::set_threads(unsigned threads)
+{
+    f_threads = threads;
+    f_threads_set = true;
+}
+
+void Reach::set_sharing(bool sharing)
+{
+    f_sharing = sharing;
+}
+
+void Reach::set_induction_step(unsigned step)
+{
+    if (! step)
+        throw InvalidInductionStep();
+
+    f_induction_step = step;
+}
+
+void Reach::add_lemma(Expr_ptr lemma)
+{
+    f_lemmas.push_back(lemma);
+}
+
 bool Reach::check_requirements()
 {
     ModelMgr& mm
@@ -89,6 +185,21 @@ Variant Reach::operator()()
         return Variant(errMessage);
 
     BMC bmc { *this, ModelMgr::INSTANCE().model() };
+    bmc.set_uniqueness(f_uniqueness);
+    std::for_each(begin(f_strategies),
+                  end(f_strategies),
+                  [&bmc](const BMCStrategy& strategy) {
+                      bmc.add_strategy(strategy);
+                  });
+    if (f_threads_set)
+        bmc.set_threads(f_threads);
+    bmc.set_sharing(f_sharing);
+    bmc.set_induction_step(f_induction_step);
+    std::for_each(begin(f_lemmas),
+                  end(f_lemmas),
+                  [&bmc](Expr_ptr lemma) {
+                      bmc.add_lemma(lemma);
+                  });
     bmc.process(f_target, f_constraints);
 
     switch (bmc.status()) {
@@ -29,6 +29,24 @@
 #include <cmd/command.hh>
 #include <algorithms/bmc/bmc.hh>
 
+/** Raised when an unknown uniqueness mode is requested */
+class UnsupportedUniquenessMode : public CommandException {
+public:
+    UnsupportedUniquenessMode(pconst_char mode);
+};
+
+/** Raised when an unknown BMC strategy is requested */
+class UnsupportedStrategy : public CommandException {
+public:
+    UnsupportedStrategy(pconst_char strategy);
+};
+
+/** Raised when a zero k-induction step is requested */
+class InvalidInductionStep : public CommandException {
+public:
+    InvalidInductionStep();
+};
+
 class Reach : public Command {
 public:
     Reach(Interpreter& owner);
@@ -37,6 +55,13 @@ public:
     /** cmd params */
     void set_target(Expr_ptr target);
     void add_constraint(Expr_ptr constraint);
+    void set_uniqueness(pconst_char mode);
+    void add_strategy(pconst_char strategy, unsigned seed = 0,
+                      pconst_char backend = NULL);
+    void set_threads(unsigned threads);
+    void set_sharing(bool sharing);
+    void set_induction_step(unsigned step);
+    void add_lemma(Expr_ptr lemma);
 
     /* run() */
     Variant virtual operator()();
@@ -50,6 +75,19 @@ private:
     /* (optional) additional constraints */
     ExprVector f_constraints;
 
+    /* simple path constraints */
+    uniqueness_mode_t f_uniqueness;
+
+    /* (optional) portfolio */
+    BMCStrategies f_strategies;
+    unsigned f_threads;
+    bool f_threads_set;
+    bool f_sharing;
+
+    /* (optional) k-induction step, and candidate invariants */
+    unsigned f_induction_step;
+    ExprVector f_lemmas;
+
     // -- helpers -------------------------------------------------------------
     bool check_requirements();
 };
@@ -22,6 +22,7 @@
  **/
 
 #include <cudd_mgr.hh>
+#include <opts/opts_mgr.hh>
 
 CuddMgr_ptr CuddMgr::f_instance = NULL;
 
@@ -53,11 +54,15 @@ CuddMgr::~CuddMgr()
 
 Cudd& CuddMgr::dd()
 {
-    Cudd* res = new Cudd();
+    OptsMgr& om
+        (OptsMgr::INSTANCE());
+
+    Cudd* res = new Cudd(0, 0, om.dd_unique_slots(), om.dd_cache_slots());
     assert (NULL != res);
 
     /* Common setup for all dd instances */
-    res -> AutodynEnable(CUDD_REORDER_GROUP_SIFT_CONV);
+    if (om.dd_reorder())
+        res -> AutodynEnable(CUDD_REORDER_GROUP_SIFT_CONV);
     f_cudd_instances.push_back(res);
 
     return *res;
@@ -31,7 +31,7 @@ ADDWalker::ADDWalker()
 ADDWalker::~ADDWalker()
 {}
 
-ADDWalker& ADDWalker::operator() (ADD dd)
+ADDWalker& ADDWalker::operator() (const ADD& dd)
 {
     /* setup toplevel act. record and perform walk. */
     add_activation_record call
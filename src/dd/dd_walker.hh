@@ -58,7 +58,7 @@ public:
     ADDWalker();
     virtual ~ADDWalker();
 
-    virtual ADDWalker& operator() (ADD dd);
+    virtual ADDWalker& operator() (const ADD& dd);
 
 protected:
     virtual void walk();
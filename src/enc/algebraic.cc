@@ -57,7 +57,6 @@ AlgebraicEncoding::AlgebraicEncoding(unsigned width, bool is_signed, ADD *dds)
 
 Expr_ptr AlgebraicEncoding::expr(int *assignment)
 {
-    ExprMgr& em = f_mgr.em();
     unsigned i, base = 2;
 
     value_t res = 0;
@@ -73,11 +72,34 @@ Expr_ptr AlgebraicEncoding::expr(int *assignment)
         } else break;
     } while (true);
 
+    return make_value(res);
+}
+
+Expr_ptr AlgebraicEncoding::bits_expr(const int* bits)
+{
+    /* one bit per digit, msb first */
+    assert(! f_temporary);
+    assert(f_bits.size() == f_width);
+
+    value_t res = 0;
+    for (unsigned i = 0; i < f_width; ++ i) {
+        res <<= 1;
+        if (bits[i])
+            res |= 1;
+    }
+
+    return make_value(res);
+}
+
+Expr_ptr AlgebraicEncoding::make_value(value_t res)
+{
+    ExprMgr& em = f_mgr.em();
+
     if (is_signed()) {
         // REVIEW this for non-exact types
-        value_t msb = pow2(i - 1);
+        value_t msb = pow2(f_width - 1);
         if (res & msb) {
-            value_t cmpl = 1 + (~res & (pow2(i) - 1));
+            value_t cmpl = 1 + (~res & (pow2(f_width) - 1));
             return em.make_neg( em.make_const(cmpl));
         }
     }
@@ -64,3 +64,39 @@ Expr_ptr ArrayEncoding::expr(int* assignment)
     assert(NULL != acc);
     return em.make_array( acc );
 }
+
+Expr_ptr ArrayEncoding::bits_expr(const int* bits)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+    Expr_ptr acc
+        (NULL);
+
+    /* elements bits are laid out one after the other */
+    unsigned ofs
+        (f_bits.size());
+
+    for (Encodings::const_reverse_iterator i = f_elements.rbegin();
+         f_elements.rend() != i; ++ i) {
+
+        Encoding_ptr enc
+            (*i);
+
+        ofs -= enc->bits().size();
+
+        Expr_ptr value
+            (enc->bits_expr(bits + ofs));
+
+        if (! value)
+            return NULL;
+
+        acc = (NULL == acc)
+            ? value
+            : em.make_array_comma(value, acc)
+        ;
+    }
+
+    assert(0 == ofs);
+    assert(NULL != acc);
+    return em.make_array( acc );
+}
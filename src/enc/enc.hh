@@ -63,6 +63,10 @@ public:
     /* vector of DD leaves (consts) -> expr */
     virtual Expr_ptr expr(int* assignment) =0;
 
+    /* values of the bits, in the order of bits() -> expr. No DD
+       traversal, NULL if the bits do not encode a value */
+    virtual Expr_ptr bits_expr(const int* bits) =0;
+
 protected:
     Encoding()
         : f_mgr(EncodingMgr::INSTANCE())
@@ -93,6 +97,8 @@ public:
     // here assignment *must* have size 1
     Expr_ptr expr(int* assignment);
 
+    Expr_ptr bits_expr(const int* bits);
+
     ADD bit();
 
 protected:
@@ -114,6 +120,8 @@ public:
     // here assignment *must* have size 1
     virtual Expr_ptr expr(int* assignment);
 
+    virtual Expr_ptr bits_expr(const int* bits);
+
     inline bool is_signed() const
     { return f_signed; }
 
@@ -130,6 +138,9 @@ protected:
     // width is number of *digits* here, dds is reserved for temporary encodings
     AlgebraicEncoding(unsigned width, bool is_signed, ADD *dds = NULL);
 
+    // digits value -> (signed) constant
+    Expr_ptr make_value(value_t res);
+
     unsigned f_width;
     bool f_signed;
     bool f_temporary;
@@ -163,6 +174,8 @@ public:
     // here assignment *must* have size 1
     virtual Expr_ptr expr(int* assignment);
 
+    virtual Expr_ptr bits_expr(const int* bits);
+
     virtual value_t value(Expr_ptr literal);
 
 protected:
@@ -185,6 +198,8 @@ class ArrayEncoding : public Encoding {
 public:
     virtual Expr_ptr expr(int* assignment);
 
+    virtual Expr_ptr bits_expr(const int* bits);
+
 protected:
     ArrayEncoding(Encodings elements);
 
@@ -67,7 +67,8 @@ Encoding_ptr EncodingMgr::make_encoding(Type_ptr tp)
     else assert(false); /* unexpected or unsupported */
 
     /* enable DD reordering */
-    f_cudd.AutodynEnable(CUDD_REORDER_SAME);
+    if (f_reorder)
+        f_cudd.AutodynEnable(CUDD_REORDER_SAME);
 
     assert (NULL != res);
     return res;
@@ -120,10 +121,48 @@ void EncodingMgr::register_encoding(const TimedExpr& key, Encoding_ptr enc)
         << std::endl;
 }
 
+void EncodingMgr::shuffle(const IndexVector& order)
+{
+    unsigned nvars
+        (nbits());
+
+    /* vars not in order keep their relative position, below */
+    std::vector<bool> placed
+        (nvars, false);
+
+    IndexVector permutation;
+    for (IndexVector::const_iterator i = order.begin(); order.end() != i; ++ i) {
+        assert(0 <= *i && *i < (int) nvars);
+        if (! placed[*i]) {
+            placed[*i] = true;
+            permutation.push_back(*i);
+        }
+    }
+
+    for (unsigned level = 0; level < nvars; ++ level) {
+        int index
+            (f_cudd.ReadInvPerm(level));
+
+        if (! placed[index])
+            permutation.push_back(index);
+    }
+    assert(permutation.size() == nvars);
+
+    if (0 < nvars)
+        f_cudd.ShuffleHeap(&permutation[0]);
+
+    DEBUG
+        << "Shuffled DD variables, "
+        << nvars
+        << " levels"
+        << std::endl;
+}
+
 EncodingMgr::EncodingMgr()
     : f_cudd(CuddMgr::INSTANCE().dd()) // this is a fresh instance
     , f_em(ExprMgr::INSTANCE())
     , f_word_width ((OptsMgr::INSTANCE().word_width()))
+    , f_reorder (OptsMgr::INSTANCE().dd_reorder())
 {
     const void* instance
         (this);
@@ -107,6 +107,10 @@ public:
     // Registers an encoding. Used by the compiler
     void register_encoding(const TimedExpr& key, Encoding_ptr enc);
 
+    // Sets the DD variable order: variables in order go first (top
+    // to bottom), all the others follow in their current order.
+    void shuffle(const IndexVector& order);
+
     // Retrieves Untimed Canonical Bit Id for index
     inline const UCBI& find_ucbi(int index)
     { return f_index2ucbi_map.at(index); }
@@ -145,6 +149,9 @@ private:
     Index2UCBIMap f_index2ucbi_map;
 
     unsigned f_word_width;
+
+    /* dynamic reordering enabled? (cfr. OptsMgr::dd_reorder()) */
+    bool f_reorder;
 };
 
 #endif /* ENCODING_MGR_H */
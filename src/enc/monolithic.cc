@@ -40,6 +40,12 @@ Expr_ptr BooleanEncoding::expr(int *assignment)
     return res == 0 ? em.make_false() : em.make_true();
 }
 
+Expr_ptr BooleanEncoding::bits_expr(const int* bits)
+{
+    ExprMgr& em = f_mgr.em();
+    return bits[0] ? em.make_true() : em.make_false();
+}
+
 ADD BooleanEncoding::bit()
 {
     assert( 1 == f_dv.size() );
@@ -93,3 +99,20 @@ Expr_ptr EnumEncoding::expr(int *assignment)
 
     return f_v2e_map [lindex];
 }
+
+Expr_ptr EnumEncoding::bits_expr(const int* bits)
+{
+    /* literal index, msb first */
+    value_t lindex = 0;
+    for (unsigned i = 0; i < f_bits.size(); ++ i) {
+        lindex <<= 1;
+        if (bits[i])
+            lindex |= 1;
+    }
+
+    ValueExprMap::const_iterator eye = f_v2e_map.find( lindex );
+    if (eye == f_v2e_map.end())
+        return NULL;
+
+    return (*eye).second;
+}
@@ -21,6 +21,7 @@
  **/
 
 #include <environment.hh>
+#include <expr/expr_mgr.hh>
 
 #include <string>
 #include <sstream>
@@ -46,6 +47,10 @@ Environment& Environment::INSTANCE()
     return *f_instance;
 }
 
+Environment::Environment()
+    : f_revision(0)
+{}
+
 Expr_ptr Environment::get(Expr_ptr id) const
 {
     Expr2ExprMap::const_iterator eye
@@ -61,8 +66,16 @@ Expr_ptr Environment::get(Expr_ptr id) const
     return eye -> second; /* non-NULL */
 }
 
+void Environment::watch(Expr_ptr id)
+{
+    f_watched.insert(id);
+}
+
 void Environment::set(Expr_ptr id, Expr_ptr value)
 {
+    if (f_watched.end() != f_watched.find(id))
+        ++ f_revision;
+
     if (value)
         f_identifiers.insert(id);
     else
@@ -79,6 +92,7 @@ void Environment::set(Expr_ptr id, Expr_ptr value)
 
 void Environment::clear()
 {
+    ++ f_revision;
     f_identifiers.clear();
     f_env.clear();
 }
@@ -86,17 +100,61 @@ void Environment::clear()
 void Environment::add_extra_init(Expr_ptr constraint)
 {
     assert(constraint);
+    ++ f_revision;
     f_extra_inits.push_back(constraint);
 }
 
 void Environment::add_extra_invar(Expr_ptr constraint)
 {
     assert(constraint);
+    ++ f_revision;
     f_extra_invars.push_back(constraint);
 }
 
 void Environment::add_extra_trans(Expr_ptr constraint)
 {
     assert(constraint);
+    ++ f_revision;
     f_extra_transes.push_back(constraint);
 }
+
+Expr_ptr env_value(const char* id)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Environment& env
+        (Environment::INSTANCE());
+
+    try {
+        return env.get(em.make_identifier(id));
+    }
+    catch (NoSuchIdentifier& nsi) {
+        return NULL;
+    }
+}
+
+unsigned env_unsigned(const char* id, unsigned min_value,
+                      unsigned default_value)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr value
+        (env_value(id));
+
+    if (! value)
+        return default_value;
+
+    if (em.is_constant(value) && min_value <= value->value())
+        return value->value();
+
+    WARN
+        << "Unsupported " << id
+        << " `" << value << "`, "
+        << "falling back to "
+        << default_value
+        << std::endl;
+
+    return default_value;
+}
@@ -86,19 +86,44 @@ public:
     inline const ExprVector& extra_trans() const
     { return f_extra_transes; }
 
+    /* Identifiers whose values are compiled into the model, i.e.
+       INPUT vars (cfr. revision()) */
+    void watch(Expr_ptr id);
+
+    /* Incremented on each change affecting compilation: values of
+       watched identifiers and extra constraints. Other identifiers
+       (e.g. tuning knobs) can be set freely, cfr. ModelMgr::compile() */
+    inline unsigned revision() const
+    { return f_revision; }
+
 private:
+    Environment();
 
     /* input vars */
     Expr2ExprMap f_env;
     ExprSet f_identifiers;
     Expr2ExprMap::iterator f_env_iter;
 
+    /* cfr. watch() */
+    ExprSet f_watched;
+
     /* additional INIT, INVAR and TRANS constraints */
     ExprVector f_extra_inits;
     ExprVector f_extra_invars;
     ExprVector f_extra_transes;
 
+    unsigned f_revision;
+
     static Environment_ptr f_instance;
 };
 
+/* Value of identifier id, NULL if id is not set */
+Expr_ptr env_value(const char* id);
+
+/* Unsigned value of identifier id, default_value if id is not set
+   or if its value is not a constant of at least min_value (a warning
+   is issued in the latter case) */
+unsigned env_unsigned(const char* id, unsigned min_value,
+                      unsigned default_value);
+
 #endif /* ENVIRONMENT_H */
@@ -171,11 +171,11 @@ void Compiler::algebraic_lshift(const Expr_ptr expr)
 
     ADD res[width];
     for (unsigned i = 0; i < width; ++ i) {
-        res[i] = f_enc.zero();
+        res[i] = zero();
     }
 
     ADD mask
-        (f_enc.constant(1));
+        (constant(1));
     ADD carry;
 
     for (unsigned k = 0; k < width; ++ k) {
@@ -190,13 +190,13 @@ void Compiler::algebraic_lshift(const Expr_ptr expr)
         f_type_stack.pop_back(); /* adjust type stack */
 
         if (! cond.IsZero()) {
-            carry = f_enc.zero(); /* lsh always introduces 0 as LSB */
+            carry = zero(); /* lsh always introduces 0 as LSB */
             for (unsigned i = 0; i < width; ++ i) {
                 unsigned ndx = width - i - 1;
 
                 /* c' = (0 < D & MSB_MASK); */
                 ADD next_carry
-                    (f_enc.zero().LT( tmp[ndx].BWTimes( mask )));
+                    (zero().LT( tmp[ndx].BWTimes( mask )));
 
                 /* x[i] = ( x[i] << 1 ) | carry */
                 tmp[ndx] = tmp[ndx].BWLShift().BWOr(carry);
@@ -246,11 +246,11 @@ void Compiler::algebraic_rshift(const Expr_ptr expr)
 
     ADD res[width];
     for (unsigned i = 0; i < width; ++ i) {
-        res[i] = f_enc.zero();
+        res[i] = zero();
     }
 
     ADD weight
-        (f_enc.constant(0));
+        (constant(0));
 
     ADD carry;
     for (unsigned k = 0; k < width; ++ k) {
@@ -262,14 +262,14 @@ void Compiler::algebraic_rshift(const Expr_ptr expr)
 
         if (! cond.IsZero()) {
             /* FIXME: rsh should *not* always introduce 0 as LSB */
-            carry = f_enc.zero();
+            carry = zero();
 
             for (unsigned i = 0; i < width; ++ i) {
                 unsigned ndx = i; /* left-to-right */
 
                 /* c' = ( 0 < ( D[i] & 0x1 ) << 3 */
-                ADD next_carry = f_enc.zero().
-                    LT(tmp[ndx].BWTimes(f_enc.one())).LShift(weight);
+                ADD next_carry = zero().
+                    LT(tmp[ndx].BWTimes(one())).LShift(weight);
 
                 /* x[i] = ( x[i] >> 1 ) | c */
                 tmp[ndx] = tmp[ndx].BWRShift().BWOr(carry);
@@ -468,11 +468,11 @@ void Compiler::algebraic_subscript(const Expr_ptr expr)
 
         unsigned i;
         ADD cnd
-            (bm.one());
+            (one());
 
         i = 0; j_ = j; while (i < iwidth) {
             ADD bit
-                ((j_ & 1) ? bm.one() : bm.zero());
+                ((j_ & 1) ? one() : zero());
             unsigned ndx
                 (iwidth - i - 1);
             j_ >>= 1;
@@ -508,7 +508,7 @@ void Compiler::algebraic_cast_from_boolean(const Expr_ptr expr)
                                 f_ctx_stack.back());
 
     for (unsigned i = 0; i < tp->width() -1; ++ i) {
-        PUSH_DD(f_enc.zero());
+        PUSH_DD(zero());
     }
 }
 
@@ -522,7 +522,7 @@ void Compiler::boolean_cast_from_algebraic(const Expr_ptr expr)
     POP_DV(rhs, tp -> width());
 
     ADD res
-        (f_enc.zero());
+        (zero());
 
     for (unsigned i = 0; i < tp -> width(); ++ i)
         res = res.Or( rhs[i]);
@@ -555,7 +555,7 @@ void Compiler::algebraic_cast_from_algebraic(const Expr_ptr expr)
             assert( tgt_type -> is_unsigned_algebraic());
             /* unsigned, pad with zeroes */
             for (unsigned i = src_type -> width(); i < tgt_type -> width(); ++ i) {
-                PUSH_DD( f_enc.zero());
+                PUSH_DD( zero());
             }
         }
     }
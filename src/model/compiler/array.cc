@@ -50,7 +50,7 @@ void Compiler::array_equals(const Expr_ptr expr)
     POP_DV(lhs, width * elems);
 
     ADD res
-        (f_enc.one());
+        (one());
 
     for (unsigned j = 0; j < elems; ++ j) {
 
@@ -0,0 +1,318 @@
+/**
+ * @file batch.cc
+ * @brief Model compiler subsystem, parallel compilation of a batch of
+ * items.
+ *
+ * CUDD managers are not thread safe, so the items of a batch are
+ * compiled by workers each with a DD manager of its own, in three
+ * steps:
+ *
+ * 1. the encodings of all the items are built, in order, by the
+ *    shared compiler. Workers never create encodings, they only read
+ *    them;
+ *
+ * 2. workers compile the items (passes 2-5, cfr. process()). The DD
+ *    manager of a worker has the same variables as the shared one, in
+ *    the same order, so that the encoding DDs are transferred with
+ *    the same indexes. Inner variables (e.g. ITE MUXes) are allocated
+ *    in the worker only, as AutoBits;
+ *
+ * 3. the units are transferred back to the shared DD manager, in the
+ *    order of the items. Inner variables are registered there, in the
+ *    order they were allocated in.
+ *
+ * ADDs are canonical, thus the units only depend on the order of the
+ * items, not on the number of workers nor on how items are scheduled.
+ *
+ * Copyright (C) 2011-2015 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <boost/thread.hpp>
+
+#include <opts/opts_mgr.hh>
+
+#include <model/compiler/compiler.hh>
+
+typedef boost::unordered_map<DdNode*, ADD, PtrHash, PtrEq> DDTransferMap;
+
+/* node, rebuilt in dest. Variable i of node is index[i] in dest. Only
+   nodes are read, the DD manager node belongs to is not touched. */
+static ADD transfer(Cudd& dest, DdNode* node, const IndexVector& index,
+                    DDTransferMap& cache)
+{
+    const DDTransferMap::const_iterator eye
+        (cache.find(node));
+
+    if (cache.end() != eye)
+        return eye->second;
+
+    ADD res;
+    if (Cudd_IsConstant(node))
+        res = dest.constant(Cudd_V(node));
+
+    else {
+        assert(node->index < index.size() && 0 <= index[node->index]);
+
+        ADD then_
+            (transfer(dest, cuddT(node), index, cache));
+        ADD else_
+            (transfer(dest, cuddE(node), index, cache));
+
+        res = dest.addVar(index[node->index]).Ite(then_, else_);
+    }
+
+    cache.insert(std::pair<DdNode*, ADD>(node, res));
+    return res;
+}
+
+/* a DD manager with the variables of shared, in the same order */
+static Cudd* make_worker_dd(Cudd& shared)
+{
+    OptsMgr& om
+        (OptsMgr::INSTANCE());
+
+    int nvars
+        (shared.ReadSize());
+
+    Cudd* res
+        (new Cudd(nvars, 0, om.dd_unique_slots(), om.dd_cache_slots()));
+
+    if (0 < nvars) {
+        IndexVector order;
+        for (int level = 0; level < nvars; ++ level)
+            order.push_back(shared.ReadInvPerm(level));
+
+        res->ShuffleHeap(&order[0]);
+    }
+
+    return res;
+}
+
+/* an item compiled by a worker */
+struct WorkerUnit {
+    unsigned item;
+    CompilationUnit unit;
+    AutoBits autos;
+
+    WorkerUnit(unsigned item_, const CompilationUnit& unit_,
+               const AutoBits& autos_)
+        : item(item_)
+        , unit(unit_)
+        , autos(autos_)
+    {}
+};
+typedef std::vector<WorkerUnit> WorkerUnits;
+
+void Compiler::process(const CompilationKeys& keys, unsigned nworkers,
+                       CompilationUnitMap& res)
+{
+    boost::mutex::scoped_lock lock { f_process_mutex };
+
+    /* 1. encodings */
+    CompilationKeys items;
+    for (CompilationKeys::const_iterator i = keys.begin(); keys.end() != i; ++ i) {
+        Expr_ptr ctx
+            (i->first);
+        Expr_ptr body
+            (i->second);
+
+        try {
+            f_status = READY;
+            build_encodings(ctx, body);
+            items.push_back(*i);
+        }
+        catch (Exception& e) {
+            std::string tmp
+                (e.what());
+
+            DEBUG
+                << "Skipping " << ctx << "::" << body
+                << ": " << tmp
+                << std::endl;
+        }
+    }
+    f_status = READY;
+
+    unsigned nitems
+        (items.size());
+
+    if (! nitems)
+        return;
+
+    if (nworkers > nitems)
+        nworkers = nitems;
+    if (! nworkers)
+        nworkers = 1;
+
+    /* 2. compilation */
+    unsigned nbits
+        (f_enc.nbits());
+
+    std::vector<Cudd*> dds;
+    std::vector<Compiler*> workers;
+    for (unsigned w = 0; w < nworkers; ++ w) {
+        dds.push_back(make_worker_dd(f_cudd));
+        workers.push_back(new Compiler(*dds.back(), nbits));
+    }
+
+    std::vector<WorkerUnits> units
+        (nworkers);
+
+    boost::mutex next_mutex;
+    unsigned next
+        (0);
+
+    auto work = [&](unsigned w) {
+        Compiler& worker
+            (*workers[w]);
+
+        while (true) {
+            unsigned item;
+            {
+                boost::mutex::scoped_lock next_lock
+                    (next_mutex);
+
+                if (nitems == next)
+                    return;
+
+                item = next ++;
+            }
+
+            Expr_ptr ctx
+                (items[item].first);
+            Expr_ptr body
+                (items[item].second);
+
+            try {
+                CompilationUnit unit
+                    (worker.process_item(ctx, body));
+
+                units[w].push_back(WorkerUnit(item, unit, worker.f_auto_bits));
+            }
+            catch (std::exception& e) {
+                std::string tmp
+                    (e.what());
+
+                DEBUG
+                    << "Skipping " << ctx << "::" << body
+                    << ": " << tmp
+                    << std::endl;
+            }
+        }
+    };
+
+    if (1 == nworkers)
+        work(0);
+
+    else {
+        boost::thread_group threads;
+        for (unsigned w = 0; w < nworkers; ++ w)
+            threads.create_thread([&work, w]() { work(w); });
+
+        /* wait for termination */
+        threads.join_all();
+    }
+
+    /* 3. transfer, in the order of the items */
+    std::vector<const WorkerUnit*> compiled
+        (nitems, NULL);
+    for (unsigned w = 0; w < nworkers; ++ w)
+        for (WorkerUnits::const_iterator i = units[w].begin();
+             units[w].end() != i; ++ i)
+            compiled[i->item] = &(*i);
+
+    for (unsigned item = 0; item < nitems; ++ item)
+        if (compiled[item])
+            res.insert(std::pair<CompilationKey, CompilationUnit>
+                       (items[item], import(compiled[item]->unit, nbits,
+                                            compiled[item]->autos)));
+
+    /* worker DDs first, then their managers */
+    compiled.clear();
+    units.clear();
+
+    for (unsigned w = 0; w < nworkers; ++ w) {
+        delete workers[w];
+        delete dds[w];
+    }
+}
+
+CompilationUnit Compiler::process_item(Expr_ptr ctx, Expr_ptr body)
+{
+    assert(f_worker);
+
+    /* units do not depend on the items compiled before */
+    f_compilation_cache.clear();
+    f_auto_bits.clear();
+
+    /* encodings are built already (cfr. process()) */
+    f_status = ENCODING;
+
+    return process_encoded(ctx, body);
+}
+
+const DDVector& Compiler::worker_dv(Encoding_ptr enc)
+{
+    assert(f_worker);
+
+    EncodingDDMap::const_iterator eye
+        (f_encoding_dds.find(enc));
+
+    if (f_encoding_dds.end() != eye)
+        return eye->second;
+
+    DDVector& res
+        (f_encoding_dds[enc]);
+
+    DDTransferMap cache;
+    const DDVector& dv
+        (enc->dv());
+    for (DDVector::const_iterator i = dv.begin(); dv.end() != i; ++ i)
+        res.push_back(transfer(f_cudd, i->getNode(), f_index, cache));
+
+    return res;
+}
+
+CompilationUnit Compiler::import(const CompilationUnit& unit, unsigned nbits,
+                                 const AutoBits& autos)
+{
+    assert(! f_worker);
+
+    IndexVector index;
+    for (unsigned i = 0; i < nbits; ++ i)
+        index.push_back(i);
+
+    for (AutoBits::const_iterator i = autos.begin(); autos.end() != i; ++ i) {
+        ADD bit
+            (make_auto_dd(i->ctx, i->time));
+
+        if (index.size() <= (unsigned) i->index)
+            index.resize(1 + i->index, -1);
+
+        index[i->index] = bit.getNode()->index;
+    }
+
+    Cudd& dd
+        (f_cudd);
+
+    DDTransferMap cache;
+    return unit.transform([&dd, &index, &cache](const ADD& x) {
+            return transfer(dd, x.getNode(), index, cache);
+        });
+}
@@ -38,6 +38,11 @@ CompilationUnit Compiler::process(Expr_ptr ctx, Expr_ptr body)
     /* Pass 1: build encodings */
     build_encodings(ctx, body);
 
+    return process_encoded(ctx, body);
+}
+
+CompilationUnit Compiler::process_encoded(Expr_ptr ctx, Expr_ptr body)
+{
     /* Pass 2: perform boolean compilation using DDs */
     compile(ctx, body);
 
@@ -56,6 +61,13 @@ CompilationUnit Compiler::process(Expr_ptr ctx, Expr_ptr body)
                            f_expr2bsd_map, f_multiway_selection_descriptors);
 }
 
+void Compiler::clear_cache()
+{
+    boost::mutex::scoped_lock lock { f_process_mutex };
+
+    f_compilation_cache.clear();
+}
+
 Compiler::Compiler()
     : f_compilation_cache()
     , f_inlined_operator_descriptors()
@@ -67,6 +79,8 @@ Compiler::Compiler()
     , f_time_stack()
     , f_owner(ModelMgr::INSTANCE())
     , f_enc(EncodingMgr::INSTANCE())
+    , f_cudd(f_enc.dd())
+    , f_worker(false)
     , f_temp_auto_index(0)
 {
     const void* instance { this };
@@ -76,6 +90,31 @@ Compiler::Compiler()
         << std::endl;
 }
 
+Compiler::Compiler(Cudd& dd, unsigned nbits)
+    : f_compilation_cache()
+    , f_inlined_operator_descriptors()
+    , f_expr2bsd_map()
+    , f_bsuf_map()
+    , f_type_stack()
+    , f_add_stack()
+    , f_ctx_stack()
+    , f_time_stack()
+    , f_owner(ModelMgr::INSTANCE())
+    , f_enc(EncodingMgr::INSTANCE())
+    , f_cudd(dd)
+    , f_worker(true)
+    , f_temp_auto_index(0)
+{
+    for (unsigned i = 0; i < nbits; ++ i)
+        f_index.push_back(i);
+
+    const void* instance { this };
+    DRIVEL
+        << "Initialized Compiler worker @"
+        << instance
+        << std::endl;
+}
+
 Compiler::~Compiler()
 {
     const void* instance { this };
@@ -75,6 +75,27 @@ typedef boost::unordered_map<Expr_ptr, Expr_ptr,
 
 #include <boost/thread/mutex.hpp>
 
+/* Encoding -> DDs, in the DD manager of a worker */
+typedef boost::unordered_map<Encoding_ptr, DDVector,
+                             PtrHash, PtrEq> EncodingDDMap;
+
+/* Inner variable allocated by a worker, cfr. Compiler::process() */
+struct AutoBit {
+    /* index in the DD manager of the worker */
+    int index;
+
+    /* where it was allocated */
+    Expr_ptr ctx;
+    step_t time;
+
+    AutoBit(int index_, Expr_ptr ctx_, step_t time_)
+        : index(index_)
+        , ctx(ctx_)
+        , time(time_)
+    {}
+};
+typedef std::vector<AutoBit> AutoBits;
+
 enum ECompilerStatus {
     READY,
     ENCODING,
@@ -94,7 +115,28 @@ public:
 
     CompilationUnit process(Expr_ptr ctx, Expr_ptr body);
 
+    /* Compiles the ctx::body items in keys with nworkers workers, each
+       with a DD manager of its own, the units are added to res. They
+       are the same for any number of workers. Items that fail to
+       compile are left out of res, cfr. ModelMgr::precompile(). */
+    void process(const CompilationKeys& keys, unsigned nworkers,
+                 CompilationUnitMap& res);
+
+    /* Drops all memoized results, cfr. ModelMgr::compile() */
+    void clear_cache();
+
+    /* Instantiates templ, the unit compiled for from::body, in
+       context to (another instance of the same module) by remapping
+       its bits. The instance is appended to res. False if templ can
+       not be remapped, i.e. it depends on bits outside of from. */
+    bool instantiate(const CompilationUnit& templ, Expr_ptr from,
+                     Expr_ptr to, Expr_ptr body, CompilationUnits& res);
+
 private:
+    /* worker, DDs are built in dd, whose first nbits variables are the
+       ones of the shared DD manager (cfr. process()) */
+    Compiler(Cudd& dd, unsigned nbits);
+
     /* Remark: the compiler does NOT support LTL ops. To enable
        verification of temporal properties, the LTL operators needs to
        be rewritten by the checking algorithm before feeding the
@@ -199,6 +241,17 @@ private:
     Expr_ptr make_auto_id();
     void make_auto_ddvect(DDVector& dv, unsigned width);
     ADD  make_auto_dd();
+    ADD  make_auto_dd(Expr_ptr ctx, step_t time);
+
+    /* constants, in the DD manager of this compiler */
+    inline ADD one()
+    { return f_cudd.addOne(); }
+
+    inline ADD zero()
+    { return f_cudd.addZero(); }
+
+    inline ADD constant(value_t value)
+    { assert (error_value != value); return f_cudd.constant(value); }
 
     void pre_hook();
     void post_hook();
@@ -215,6 +268,18 @@ private:
     void activate_ite_muxes();
     void activate_array_muxes();
 
+    /* passes 2 to 5, encodings must be built already */
+    CompilationUnit process_encoded(Expr_ptr ctx, Expr_ptr body);
+
+    /* workers, cfr. process() */
+    CompilationUnit process_item(Expr_ptr ctx, Expr_ptr body);
+    const DDVector& worker_dv(Encoding_ptr enc);
+
+    /* unit, compiled by a worker, transferred to this compiler's DD
+       manager. autos are the inner variables of the unit. */
+    CompilationUnit import(const CompilationUnit& unit, unsigned nbits,
+                           const AutoBits& autos);
+
     /* -- data -------------------------------------------------------------- */
 
     /* TimedExpr -> Compilation Unit cache */
@@ -248,6 +313,17 @@ private:
     ModelMgr& f_owner;
     EncodingMgr& f_enc;
 
+    /* DDs are built here, the shared DD manager unless this is a
+       worker */
+    Cudd& f_cudd;
+
+    /* workers only, cfr. process(). Shared variables have the same
+       index in the worker (f_index is the identity map for them). */
+    bool f_worker;
+    IndexVector f_index;
+    EncodingDDMap f_encoding_dds;
+    AutoBits f_auto_bits;
+
     /* Auto expressions and DDs */
     unsigned f_temp_auto_index;
 
@@ -115,11 +115,11 @@ void Compiler::enumerative_subscript(const Expr_ptr expr)
 
         unsigned i;
         ADD cnd
-            (bm.one());
+            (one());
 
         i = 0; j_ = j; while (i < iwidth) {
             ADD bit
-                ((j_ & 1) ? bm.one() : bm.zero());
+                ((j_ & 1) ? one() : zero());
             unsigned ndx
                 (iwidth - i - 1);
             j_ >>= 1;
@@ -54,3 +54,17 @@ UnexpectedExpression::UnexpectedExpression(Expr_ptr expr)
     : CompilerException("UnexpectedExpression",
                         format_unexpected_expression(expr))
 {}
+
+static std::string format_missing_encoding(const TimedExpr& key)
+{
+    std::ostringstream oss;
+
+    oss
+        << key;
+
+    return oss.str();
+}
+MissingEncoding::MissingEncoding(const TimedExpr& key)
+    : CompilerException("MissingEncoding",
+                        format_missing_encoding(key))
+{}
@@ -30,6 +30,8 @@
 #include <common/common.hh>
 #include <model/exceptions.hh>
 
+#include <expr/timed_expr.hh>
+
 /** Exception classes */
 class CompilerException : public Exception {
 public:
@@ -50,4 +52,10 @@ public:
     UnexpectedExpression(Expr_ptr expr);
 };
 
+/** Raised by compiler workers when a symbol has no encoding yet */
+class MissingEncoding : public CompilerException {
+public:
+    MissingEncoding(const TimedExpr& key);
+};
+
 #endif /* COMPILER_EXCEPTIONS_H */
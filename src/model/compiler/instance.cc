@@ -0,0 +1,197 @@
+/**
+ * @file instance.cc
+ * @brief Model compiler subsystem, module instance templates
+ * implementation.
+ *
+ * A unit compiled for a constraint of a module instance is a template
+ * for the same constraint in all the other instances of that module:
+ * the DDs only differ by the encoding bits they are built on. Each bit
+ * of the template is identified by its UCBI (the fully qualified name
+ * of the encoded symbol, a time and a bit position), rebasing the name
+ * on the other instance yields the bit to be used instead.
+ *
+ * Copyright (C) 2011-2015 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <set>
+
+#include <model/compiler/compiler.hh>
+
+typedef std::set<unsigned> IndexSet;
+
+/* expr, with prefix from replaced by to. NULL if expr is not in from */
+static Expr_ptr rebase(ExprMgr& em, Expr_ptr expr, Expr_ptr from, Expr_ptr to)
+{
+    ExprVector fragments;
+
+    while (expr != from) {
+        if (! em.is_dot(expr))
+            return NULL;
+
+        fragments.push_back(expr->rhs());
+        expr = expr->lhs();
+    }
+
+    Expr_ptr res
+        (to);
+
+    for (ExprVector::const_reverse_iterator i = fragments.rbegin();
+         fragments.rend() != i; ++ i)
+        res = em.make_dot(res, *i);
+
+    return res;
+}
+
+static void collect_support(const ADD& add, IndexSet& res)
+{
+    std::vector<unsigned> indices
+        (add.SupportIndices());
+
+    res.insert(indices.begin(), indices.end());
+}
+
+static void collect_support(const DDVector& dv, IndexSet& res)
+{
+    for (DDVector::const_iterator i = dv.begin(); dv.end() != i; ++ i)
+        collect_support(*i, res);
+}
+
+bool Compiler::instantiate(const CompilationUnit& templ, Expr_ptr from,
+                           Expr_ptr to, Expr_ptr body, CompilationUnits& res)
+{
+    boost::mutex::scoped_lock lock { f_process_mutex };
+
+    ExprMgr& em
+        (f_owner.em());
+
+    /* 1. bits of the template */
+    IndexSet support;
+    collect_support(templ.dds(), support);
+
+    const InlinedOperatorDescriptors& inlined_operator_descriptors
+        (templ.inlined_operator_descriptors());
+
+    for (InlinedOperatorDescriptors::const_iterator i = inlined_operator_descriptors.begin();
+         inlined_operator_descriptors.end() != i; ++ i) {
+        collect_support(i->z(), support);
+        collect_support(i->x(), support);
+        collect_support(i->y(), support);
+    }
+
+    const Expr2BinarySelectionDescriptorsMap& binary_selection_descriptors_map
+        (templ.binary_selection_descriptors_map());
+
+    for (Expr2BinarySelectionDescriptorsMap::const_iterator i = binary_selection_descriptors_map.begin();
+         binary_selection_descriptors_map.end() != i; ++ i) {
+
+        const BinarySelectionDescriptors& descriptors
+            (i->second);
+
+        for (BinarySelectionDescriptors::const_iterator j = descriptors.begin();
+             descriptors.end() != j; ++ j) {
+            collect_support(j->z(), support);
+            collect_support(j->cnd(), support);
+            collect_support(j->aux(), support);
+            collect_support(j->x(), support);
+            collect_support(j->y(), support);
+        }
+    }
+
+    const MultiwaySelectionDescriptors& array_mux_descriptors
+        (templ.array_mux_descriptors());
+
+    for (MultiwaySelectionDescriptors::const_iterator i = array_mux_descriptors.begin();
+         array_mux_descriptors.end() != i; ++ i) {
+        collect_support(i->z(), support);
+        collect_support(i->cnds(), support);
+        collect_support(i->acts(), support);
+        collect_support(i->x(), support);
+    }
+
+    /* 2. all the bits must belong to the template instance, anything
+       else (e.g. symbols of an enclosing module) can not be remapped */
+    std::vector< std::pair<unsigned, TimedExpr> > keys;
+    for (IndexSet::const_iterator i = support.begin(); support.end() != i; ++ i) {
+
+        const UCBI& ucbi
+            (f_enc.find_ucbi(*i));
+
+        Expr_ptr expr
+            (rebase(em, ucbi.expr(), from, to));
+
+        if (! expr) {
+            DEBUG
+                << "Can not instantiate `"
+                << from << "::" << body
+                << "` in `"
+                << to
+                << "`, depends on "
+                << ucbi
+                << std::endl;
+
+            return false;
+        }
+
+        keys.push_back(std::pair<unsigned, TimedExpr>
+                       (*i, TimedExpr(expr, ucbi.time())));
+    }
+
+    /* 3. encodings for the instance, symbols first (in the same order
+       as a regular compilation), then the inner variables */
+    f_status = READY;
+    build_encodings(to, body);
+    f_status = READY;
+
+    std::vector<int> targets;
+    for (unsigned i = 0; i < keys.size(); ++ i) {
+
+        const TimedExpr& key
+            (keys[i].second);
+
+        Encoding_ptr enc
+            (f_enc.find_encoding(key));
+
+        if (! enc) {
+            /* auxiliary variables (muxes, operators) are boolean */
+            enc = f_enc.make_encoding(f_owner.tm().find_boolean());
+            f_enc.register_encoding(key, enc);
+        }
+
+        const UCBI& ucbi
+            (f_enc.find_ucbi(keys[i].first));
+
+        assert(ucbi.bitno() < enc->bits().size());
+        targets.push_back(enc->bits()[ucbi.bitno()].getNode()->index);
+    }
+
+    std::vector<int> permut
+        (f_enc.nbits());
+    for (unsigned i = 0; i < permut.size(); ++ i)
+        permut[i] = i;
+
+    for (unsigned i = 0; i < keys.size(); ++ i)
+        permut[keys[i].first] = targets[i];
+
+    /* 4. the instance */
+    res.push_back(templ.transform([&permut](const ADD& dd) {
+                return dd.Permute(&permut[0]);
+            }));
+
+    return true;
+}
@@ -37,6 +37,27 @@ Expr_ptr Compiler::make_auto_id()
 
 /* build an auto fresh ADD variable and register its encoding */
 ADD Compiler::make_auto_dd()
+{
+    Expr_ptr ctx
+        (f_ctx_stack.back());
+    step_t time
+        (f_time_stack.back());
+
+    /* workers can not register encodings, the variable is registered
+       when the unit is transferred to the shared DD manager (cfr.
+       import()) */
+    if (f_worker) {
+        ADD res
+            (f_cudd.addVar());
+
+        f_auto_bits.push_back(AutoBit(res.getNode()->index, ctx, time));
+        return res;
+    }
+
+    return make_auto_dd(ctx, time);
+}
+
+ADD Compiler::make_auto_dd(Expr_ptr ctx, step_t time)
 {
     ExprMgr& em
         (f_owner.em());
@@ -52,10 +73,6 @@ ADD Compiler::make_auto_dd()
     // register encoding, a FQExpr is needed for UCBI booking
     Expr_ptr aid
         (make_auto_id());
-    Expr_ptr ctx
-        (f_ctx_stack.back());
-    step_t time
-        (f_time_stack.back());
 
     TimedExpr key
         (em.make_dot( ctx, aid), time);
@@ -287,8 +304,8 @@ void Compiler::check_internals()
     /* Exactly one 0-1 ADD expected here */
     ADD res { f_add_stack.back() };
 
-    assert(res.FindMin().Equals(f_enc.zero()));
-    assert(res.FindMax().Equals(f_enc.one()));
+    assert(res.FindMin().Equals(zero()));
+    assert(res.FindMax().Equals(one()));
 }
 
 void Compiler::activate_ite_muxes()
@@ -308,7 +325,7 @@ void Compiler::activate_ite_muxes()
             << toplevel << "`"
             << std::endl;
 
-        ADD prev { f_enc.zero() };
+        ADD prev { zero() };
 
         BinarySelectionDescriptors::const_reverse_iterator j;
         for (j = descriptors.rbegin(); descriptors.rend() != j; ++ j) {
@@ -352,6 +369,9 @@ Encoding_ptr Compiler::find_encoding( const TimedExpr& key, const Type_ptr type
     /* build a new encoding for this symbol if none is available. */
     res = f_enc.find_encoding(key);
     if (! res) {
+        if (f_worker)
+            throw MissingEncoding(key);
+
         DEBUG
             << "Registering new encoding of type "
             << type << " for " << key
@@ -48,12 +48,12 @@ void Compiler::walk_leaf(const Expr_ptr expr)
     /* 0. Explicit boolean consts (TRUE, FALSE) */
     if (em.is_false(expr)) {
         f_type_stack.push_back(tm.find_boolean());
-        f_add_stack.push_back(f_enc.zero());
+        f_add_stack.push_back(zero());
         return;
     }
     if (em.is_true(expr)) {
         f_type_stack.push_back(tm.find_boolean());
-        f_add_stack.push_back(f_enc.one());
+        f_add_stack.push_back(one());
         return;
     }
 
@@ -83,7 +83,7 @@ void Compiler::walk_leaf(const Expr_ptr expr)
         Constant& konst (symb->as_const());
 
         f_type_stack.push_back(konst.type());
-        f_add_stack.push_back(f_enc.constant(konst.value()));
+        f_add_stack.push_back(constant(konst.value()));
         return;
     }
 
@@ -105,6 +105,9 @@ void Compiler::walk_leaf(const Expr_ptr expr)
 
         /* build a new encoding for this symbol if none is available. */
         if (!enc) {
+            if (f_worker)
+                throw MissingEncoding(key);
+
             enc = f_enc.make_encoding(type);
             f_enc.register_encoding(key, enc);
         }
@@ -114,7 +117,7 @@ void Compiler::walk_leaf(const Expr_ptr expr)
         assert( NULL != eenc );
 
         f_type_stack.push_back(type);
-        f_add_stack.push_back(f_enc.constant(eenc -> value(expr)));
+        f_add_stack.push_back(constant(eenc -> value(expr)));
         return;
     }
 
@@ -187,8 +190,8 @@ void Compiler::walk_leaf(const Expr_ptr expr)
 void Compiler::push_dds(Encoding_ptr enc, Type_ptr type)
 {
     assert (NULL != enc);
-    DDVector& dds
-        (enc->dv());
+    const DDVector& dds
+        (f_worker ? worker_dv(enc) : enc->dv());
     unsigned width
         (dds.size());
     assert( 0 < width );
@@ -204,7 +207,7 @@ void Compiler::push_dds(Encoding_ptr enc, Type_ptr type)
     else if (type->is_algebraic()) {
         // type and enc width info has to match
         assert( type -> as_algebraic()-> width() == width );
-        for (DDVector::reverse_iterator ri = dds.rbegin(); ri != dds.rend(); ++ ri)
+        for (DDVector::const_reverse_iterator ri = dds.rbegin(); ri != dds.rend(); ++ ri)
             f_add_stack.push_back(*ri);
     }
 
@@ -221,7 +224,7 @@ void Compiler::push_dds(Encoding_ptr enc, Type_ptr type)
             assert( type -> as_array() -> of() -> as_algebraic()-> width() ==
                     width / type -> as_array() -> nelems());
 
-        for (DDVector::reverse_iterator ri = dds.rbegin(); ri != dds.rend(); ++ ri)
+        for (DDVector::const_reverse_iterator ri = dds.rbegin(); ri != dds.rend(); ++ ri)
             f_add_stack.push_back(*ri);
     }
 
@@ -256,7 +259,7 @@ void Compiler::algebraic_constant(Expr_ptr konst, unsigned width)
 
     for (unsigned i = 0; i < width; ++ i) {
         ADD digit
-            (f_enc.constant(value % base));
+            (constant(value % base));
 
         f_add_stack.push_back(digit);
         value /= base;
@@ -0,0 +1,424 @@
+/**
+ * @file ordering.cc
+ * @brief Model compiler subsystem, static DD variable ordering
+ * implementation.
+ *
+ * Copyright (C) 2011-2015 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <algorithm>
+#include <stack>
+
+#include <model/compiler/ordering.hh>
+
+#include <model/module.hh>
+
+#include <enc/enc.hh>
+
+#include <env/environment.hh>
+
+#include <symb/classes.hh>
+#include <symb/proxy.hh>
+
+#include <type/type.hh>
+
+StaticOrdering::StaticOrdering(ModelMgr& owner)
+    : f_owner(owner)
+    , f_em(owner.em())
+    , f_enc(EncodingMgr::INSTANCE())
+{}
+
+StaticOrdering::~StaticOrdering()
+{}
+
+void StaticOrdering::process()
+{
+    Model& model
+        (f_owner.model());
+
+    Environment& env
+        (Environment::INSTANCE());
+
+    std::stack< std::pair<Expr_ptr, Module_ptr> > stack;
+    stack.push( std::pair< Expr_ptr, Module_ptr >
+                (f_em.make_empty(), &model.main_module()));
+
+    /* 1. walk of var decls, starting from main module */
+    while (0 < stack.size()) {
+
+        const std::pair< Expr_ptr, Module_ptr > top
+            (stack.top());
+        stack.pop();
+
+        Expr_ptr ctx
+            (top.first);
+
+        Module& module
+            (* top.second);
+
+        collect_constraints(ctx, module.init());
+        collect_constraints(ctx, module.invar());
+        collect_constraints(ctx, module.trans());
+
+        Variables attrs
+            (module.vars());
+        Variables::const_iterator vi;
+        for (vi = attrs.begin(); attrs.end() != vi; ++ vi) {
+
+            Type_ptr vtype
+                (vi->second->type());
+
+            if (vtype->is_instance()) {
+
+                InstanceType_ptr instance
+                    (vtype->as_instance());
+
+                stack.push( std::pair< Expr_ptr, Module_ptr >
+                            (f_em.make_dot( ctx, vi->first),
+                             &model.module(instance->name())));
+            }
+        }
+    } /* while() */
+
+    collect_constraints(f_em.make_empty(), env.extra_init());
+    collect_constraints(f_em.make_empty(), env.extra_invar());
+    collect_constraints(f_em.make_empty(), env.extra_trans());
+
+    /* 2. groups, in order of first occurrence of their members */
+    unsigned nsymbols
+        (f_symbols.size());
+
+    std::vector<OrderingSupport> groups;
+    std::vector<bool> frozen;
+    boost::unordered_map<unsigned, unsigned> group_map;
+
+    for (unsigned i = 0; i < nsymbols; ++ i) {
+        unsigned root
+            (find(i));
+
+        boost::unordered_map<unsigned, unsigned>::const_iterator eye
+            (group_map.find(root));
+
+        unsigned group;
+        if (group_map.end() == eye) {
+            group = groups.size();
+            group_map.insert(std::pair<unsigned, unsigned>(root, group));
+            groups.push_back(OrderingSupport());
+            frozen.push_back(true);
+        }
+        else group = eye->second;
+
+        groups[group].push_back(i);
+        if (*f_times[i].begin() != UINT_MAX)
+            frozen[group] = false;
+    }
+
+    /* 3. the order, frozen groups first */
+    IndexVector order;
+    for (unsigned pass = 0; pass < 2; ++ pass)
+        for (unsigned i = 0; i < groups.size(); ++ i)
+            if (frozen[i] == (0 == pass))
+                order_group(groups[i], order);
+
+    unsigned ngroups
+        (groups.size());
+
+    unsigned nbits
+        (order.size());
+
+    INFO
+        << "Static DD ordering: "
+        << nsymbols << " variables, "
+        << ngroups << " groups, "
+        << nbits << " bits"
+        << std::endl;
+
+    f_enc.shuffle(order);
+}
+
+void StaticOrdering::collect_constraints(Expr_ptr ctx, const ExprVector& constraints)
+{
+    for (ExprVector::const_iterator i = constraints.begin();
+         constraints.end() != i; ++ i) {
+        OrderingSupport support;
+        collect(ctx, *i, 0, support);
+    }
+}
+
+unsigned StaticOrdering::find(unsigned index)
+{
+    unsigned root
+        (index);
+
+    while (f_parents[root] != root)
+        root = f_parents[root];
+
+    /* path compression */
+    while (f_parents[index] != root) {
+        unsigned next
+            (f_parents[index]);
+
+        f_parents[index] = root;
+        index = next;
+    }
+
+    return root;
+}
+
+void StaticOrdering::merge(const OrderingSupport& support)
+{
+    if (support.empty())
+        return;
+
+    unsigned root
+        (find(support[0]));
+
+    for (OrderingSupport::const_iterator i = support.begin() + 1;
+         support.end() != i; ++ i) {
+        unsigned other
+            (find(*i));
+
+        /* earliest symbol as root, to keep groups in order */
+        if (other < root)
+            std::swap(root, other);
+
+        f_parents[other] = root;
+    }
+}
+
+void StaticOrdering::collect(Expr_ptr ctx, Expr_ptr expr, step_t time,
+                             OrderingSupport& res)
+{
+    if (! expr)
+        return;
+
+    switch (expr->symb()) {
+
+    /* leaves */
+    case IDENT:
+        collect_symbol(f_em.make_dot(ctx, expr), time, res);
+        return;
+
+    case ICONST:
+    case HCONST:
+    case OCONST:
+    case BCONST:
+    case QSTRING:
+    case UNDEF:
+    case TYPE:
+    case BOOL:
+    case SIGNED:
+    case UNSIGNED:
+        return;
+
+    case CAST:
+        collect(ctx, expr->rhs(), time, res);
+        return;
+
+    case DOT:
+        collect(f_em.make_dot(ctx, expr->lhs()), expr->rhs(), time, res);
+        return;
+
+    case NEXT:
+        collect(ctx, expr->lhs(), time + 1, res);
+        return;
+
+    /* `x := <expr>` is `NEXT(x) = <expr>` */
+    case ASSIGNMENT:
+        {
+            OrderingSupport support;
+            collect(ctx, expr->lhs(), time + 1, support);
+            collect(ctx, expr->rhs(), time, support);
+            merge(support);
+
+            res.insert(res.end(), support.begin(), support.end());
+        }
+        return;
+
+    /* ITE(COND(c, t), e): the condition is not part of the word,
+       both branches are */
+    case ITE:
+        {
+            assert(COND == expr->lhs()->symb());
+
+            OrderingSupport condition;
+            collect(ctx, expr->lhs()->lhs(), time, condition);
+            collect(ctx, expr->lhs()->rhs(), time, res);
+            collect(ctx, expr->rhs(), time, res);
+        }
+        return;
+
+    case PARAMS:
+        collect(ctx, f_owner.preprocess(expr, ctx), time, res);
+        return;
+
+    /* word-level operators */
+    case PLUS: case SUB: case MUL: case DIV: case MOD:
+    case BW_AND: case BW_OR: case BW_XOR: case BW_XNOR:
+    case LSHIFT: case RSHIFT:
+    case EQ: case NE: case GE: case GT: case LE: case LT:
+        {
+            OrderingSupport support;
+            collect(ctx, expr->lhs(), time, support);
+            collect(ctx, expr->rhs(), time, support);
+            merge(support);
+
+            res.insert(res.end(), support.begin(), support.end());
+        }
+        return;
+
+    /* temporal operators, absolute time: no grouping */
+    case AT:
+        {
+            OrderingSupport support;
+            collect(ctx, expr->rhs(), time, support);
+        }
+        return;
+
+    default:
+        collect(ctx, expr->lhs(), time, res);
+        collect(ctx, expr->rhs(), time, res);
+        return;
+    }
+}
+
+void StaticOrdering::collect_symbol(Expr_ptr full, step_t time, OrderingSupport& res)
+{
+    ResolverProxy resolver;
+
+    Symbol_ptr symb
+        (resolver.symbol(full));
+
+    if (symb->is_variable()) {
+        Variable& var
+            (symb->as_variable());
+
+        /* INPUT vars are compiled as their values, temporaries live
+           outside of the model */
+        if (var.is_input() ||
+            var.is_temp() ||
+            var.type()->is_instance())
+            return;
+
+        unsigned index;
+
+        boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq>::const_iterator eye
+            (f_symbol_map.find(full));
+
+        if (f_symbol_map.end() == eye) {
+            index = f_symbols.size();
+            f_symbol_map.insert(std::pair<Expr_ptr, unsigned>(full, index));
+            f_symbols.push_back(full);
+            f_times.push_back(std::set<step_t>());
+            f_parents.push_back(index);
+        }
+        else index = eye->second;
+
+        f_times[index].insert(var.is_frozen() ? UINT_MAX : time);
+        res.push_back(index);
+    }
+
+    else if (symb->is_parameter()) {
+        Expr_ptr rewrite
+            (f_owner.rewrite_parameter(full));
+
+        collect(rewrite->lhs(), rewrite->rhs(), time, res);
+    }
+
+    else if (symb->is_define()) {
+        TimedExpr key
+            (full, time);
+
+        boost::unordered_map<TimedExpr, OrderingSupport,
+                             TimedExprHash, TimedExprEq>::const_iterator eye
+            (f_define_supports.find(key));
+
+        if (f_define_supports.end() == eye) {
+            OrderingSupport support;
+            collect(full->lhs(), symb->as_define().body(), time, support);
+
+            eye = f_define_supports.insert(std::pair<TimedExpr, OrderingSupport>
+                                           (key, support)).first;
+        }
+
+        res.insert(res.end(), eye->second.begin(), eye->second.end());
+    }
+
+    /* constants and literals have no support */
+}
+
+void StaticOrdering::order_group(const OrderingSupport& group, IndexVector& res)
+{
+    /* words of the group, current state first, then next */
+    std::vector<DDVector*> words;
+    unsigned width
+        (0);
+
+    for (OrderingSupport::const_iterator i = group.begin(); group.end() != i; ++ i) {
+        Expr_ptr full
+            (f_symbols[*i]);
+
+        ResolverProxy resolver;
+
+        Type_ptr type
+            (resolver.symbol(full)->as_variable().type());
+
+        const std::set<step_t>& times
+            (f_times[*i]);
+
+        for (std::set<step_t>::const_iterator j = times.begin(); times.end() != j; ++ j) {
+            TimedExpr key
+                (full, *j);
+
+            Encoding_ptr enc
+                (f_enc.find_encoding(key));
+
+            if (! enc) {
+                DEBUG
+                    << "Registering new encoding of type "
+                    << type << " for " << key
+                    << std::endl;
+
+                enc = f_enc.make_encoding(type);
+                f_enc.register_encoding(key, enc);
+            }
+
+            DDVector& bits
+                (enc->bits());
+
+            words.push_back(&bits);
+            width = std::max<unsigned>(width, bits.size());
+        }
+    }
+
+    /* interleaved, MSB first, aligned on LSB */
+    for (unsigned significance = width; 0 < significance; -- significance)
+        for (std::vector<DDVector*>::const_iterator i = words.begin();
+             words.end() != i; ++ i) {
+
+            const DDVector& bits
+                (** i);
+
+            unsigned nbits
+                (bits.size());
+
+            if (significance <= nbits)
+                res.push_back(bits[nbits - significance].getNode()->index);
+        }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file ordering.hh
+ * @brief Model compiler subsystem, static DD variable ordering.
+ *
+ * Bits are allocated in the DD manager in the order encodings are
+ * first needed by the compiler, which is seldom a good variable
+ * order. This pass walks the model constraints before any of them is
+ * compiled, allocates the encodings of the state variables they use
+ * and sets the initial variable order from the structure of the
+ * model:
+ *
+ * - variables combined by word-level operators (arithmetics,
+ *   bitwise, shifts and relational operators) are grouped together;
+ *
+ * - within a group, the bits of all the words (current and next
+ *   state) are interleaved, most significant bits first, aligned on
+ *   the least significant ones;
+ *
+ * - groups of frozen variables go first, all the other groups follow
+ *   in the order of first occurrence in the model.
+ *
+ * Copyright (C) 2011-2015 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include <set>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <expr/expr.hh>
+#include <expr/expr_mgr.hh>
+#include <expr/timed_expr.hh>
+
+#include <enc/enc_mgr.hh>
+
+#include <model/model.hh>
+#include <model/model_mgr.hh>
+
+#include <utils/pool.hh>
+#include <utils/time.hh>
+
+/* symbol indexes */
+typedef std::vector<unsigned> OrderingSupport;
+
+class StaticOrdering {
+public:
+    StaticOrdering(ModelMgr& owner);
+    ~StaticOrdering();
+
+    /**
+     * @brief Walks all the constraints of the model (and the
+     * environment extra constraints), allocates the encodings of the
+     * state variables they depend upon and shuffles the DD manager
+     * accordingly. Meant to be run before any compilation.
+     */
+    void process();
+
+private:
+    ModelMgr& f_owner;
+    ExprMgr& f_em;
+    EncodingMgr& f_enc;
+
+    /* state variables, in order of first occurrence */
+    ExprVector f_symbols;
+    boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq> f_symbol_map;
+
+    /* times each variable is used at (UINT_MAX for frozen) */
+    std::vector< std::set<step_t> > f_times;
+
+    /* union-find forest over symbol indexes */
+    std::vector<unsigned> f_parents;
+
+    /* supports of DEFINEs, by fully qualified name and time */
+    boost::unordered_map<TimedExpr, OrderingSupport,
+                         TimedExprHash, TimedExprEq> f_define_supports;
+
+    unsigned find(unsigned index);
+    void merge(const OrderingSupport& support);
+
+    /* adds the variables ctx::expr depends upon (at time) to res,
+       grouping operands of word-level operators on the way */
+    void collect(Expr_ptr ctx, Expr_ptr expr, step_t time,
+                 OrderingSupport& res);
+
+    void collect_symbol(Expr_ptr full, step_t time, OrderingSupport& res);
+
+    void collect_constraints(Expr_ptr ctx, const ExprVector& constraints);
+
+    /* DD indexes of all the bits of the group, in order */
+    void order_group(const OrderingSupport& group, IndexVector& res);
+};
+
+#endif /* ORDERING_H */
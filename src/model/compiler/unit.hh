@@ -33,6 +33,8 @@
 #include <boost/tuple/tuple_comparison.hpp>
 
 #include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <expr/expr.hh>
 
@@ -190,6 +192,18 @@ typedef std::vector<MultiwaySelectionDescriptor> MultiwaySelectionDescriptors;
 typedef boost::unordered_map<Expr_ptr,
                              BinarySelectionDescriptors> Expr2BinarySelectionDescriptorsMap;
 
+/* CNF templates are built by the SAT module (cfr. sat/template.hh),
+   units only provide the storage for them so that all the copies of
+   a unit share the same template. */
+class CNFTemplate;
+typedef boost::shared_ptr<CNFTemplate> CNFTemplate_ptr;
+
+struct CNFTemplateCache {
+    boost::mutex f_mutex;
+    CNFTemplate_ptr f_template;
+};
+typedef boost::shared_ptr<CNFTemplateCache> CNFTemplateCache_ptr;
+
 class CompilationUnit {
 public:
     CompilationUnit( DDVector& dds,
@@ -200,6 +214,7 @@ public:
         , f_inlined_operator_descriptors( inlined_operator_descriptors )
         , f_binary_selection_descriptors_map( binary_selection_descriptors_map )
         , f_array_mux_descriptors( array_mux_descriptors )
+        , f_cnf_template_cache( new CNFTemplateCache() )
     {}
 
     const DDVector& dds() const
@@ -214,15 +229,96 @@ public:
     const MultiwaySelectionDescriptors& array_mux_descriptors() const
     { return f_array_mux_descriptors; }
 
+    CNFTemplateCache& cnf_template_cache() const
+    { return *f_cnf_template_cache; }
+
+    /* A copy of this unit, with fun applied to all of its DDs (e.g.
+       to rename variables, cfr. Compiler::instantiate()) */
+    template <typename F>
+    CompilationUnit transform(F fun) const;
+
 private:
     DDVector f_dds;
     InlinedOperatorDescriptors f_inlined_operator_descriptors;
     Expr2BinarySelectionDescriptorsMap f_binary_selection_descriptors_map;
     MultiwaySelectionDescriptors f_array_mux_descriptors;
+
+    CNFTemplateCache_ptr f_cnf_template_cache;
 };
 typedef CompilationUnit* CompilationUnit_ptr;
 typedef std::vector<CompilationUnit> CompilationUnits;
 
+/* cfr. CompilationUnit::transform() */
+template <typename F>
+inline void transform_dds(const DDVector& dv, F& fun, DDVector& res)
+{
+    for (DDVector::const_iterator i = dv.begin(); dv.end() != i; ++ i)
+        res.push_back(fun(*i));
+}
+
+template <typename F>
+CompilationUnit CompilationUnit::transform(F fun) const
+{
+    DDVector dds;
+    transform_dds(f_dds, fun, dds);
+
+    InlinedOperatorDescriptors inlined;
+    for (InlinedOperatorDescriptors::const_iterator i = f_inlined_operator_descriptors.begin();
+         f_inlined_operator_descriptors.end() != i; ++ i) {
+
+        DDVector z, x, y;
+        transform_dds(i->z(), fun, z);
+        transform_dds(i->x(), fun, x);
+        transform_dds(i->y(), fun, y);
+
+        inlined.push_back(i->is_unary()
+                          ? InlinedOperatorDescriptor(i->ios(), z, x)
+                          : InlinedOperatorDescriptor(i->ios(), z, x, y));
+    }
+
+    Expr2BinarySelectionDescriptorsMap bsd_map;
+    for (Expr2BinarySelectionDescriptorsMap::const_iterator i = f_binary_selection_descriptors_map.begin();
+         f_binary_selection_descriptors_map.end() != i; ++ i) {
+
+        const BinarySelectionDescriptors& descriptors
+            (i->second);
+
+        BinarySelectionDescriptors& res
+            (bsd_map[i->first]);
+
+        for (BinarySelectionDescriptors::const_iterator j = descriptors.begin();
+             descriptors.end() != j; ++ j) {
+
+            DDVector z, x, y;
+            transform_dds(j->z(), fun, z);
+            transform_dds(j->x(), fun, x);
+            transform_dds(j->y(), fun, y);
+
+            res.push_back(BinarySelectionDescriptor(j->width(), z,
+                                                    fun(j->cnd()),
+                                                    fun(j->aux()),
+                                                    x, y));
+        }
+    }
+
+    MultiwaySelectionDescriptors muxes;
+    for (MultiwaySelectionDescriptors::const_iterator i = f_array_mux_descriptors.begin();
+         f_array_mux_descriptors.end() != i; ++ i) {
+
+        DDVector z, cnds, acts, x;
+        transform_dds(i->z(), fun, z);
+        transform_dds(i->cnds(), fun, cnds);
+        transform_dds(i->acts(), fun, acts);
+        transform_dds(i->x(), fun, x);
+
+        muxes.push_back(MultiwaySelectionDescriptor(i->elem_width(),
+                                                    i->elem_count(),
+                                                    z, cnds, acts, x));
+    }
+
+    return CompilationUnit(dds, inlined, bsd_map, muxes);
+}
+
 /* helpers */
 std::ostream& operator<<(std::ostream& os, InlinedOperatorSignature ios);
 std::string ios2string(InlinedOperatorSignature ios);
@@ -26,12 +26,37 @@
 
 #include <symb/typedefs.hh>
 #include <symb/classes.hh>
+#include <symb/symb_iter.hh>
 
 #include <model/exceptions.hh>
 #include <model/model.hh>
 #include <model/module.hh>
 #include <model/model_mgr.hh>
 
+#include <model/compiler/compiler.hh>
+#include <model/compiler/ordering.hh>
+
+#include <env/environment.hh>
+
+#include <boost/thread.hpp>
+#include <boost/unordered_set.hpp>
+
+static const char* COMPILE_THREADS_IDENTIFIER = "compile_threads";
+static const unsigned DEFAULT_COMPILE_THREADS (0);
+
+/* workers compiling a batch of items, 0 is one per core */
+static unsigned compile_threads()
+{
+    unsigned res
+        (env_unsigned(COMPILE_THREADS_IDENTIFIER, 0,
+                      DEFAULT_COMPILE_THREADS));
+
+    if (! res)
+        res = boost::thread::hardware_concurrency();
+
+    return res ? res : 1;
+}
+
 ModelMgr& ModelMgr::INSTANCE()
 {
     if (! f_instance)
@@ -52,7 +77,240 @@ ModelMgr::ModelMgr()
     , f_analyzer(* new Analyzer(* this))
     , f_type_checker(* new TypeChecker(* this))
     , f_analyzed(false)
+    , f_compiler(NULL)
+    , f_compilation_revision(Environment::INSTANCE().revision())
+    , f_compilation_ordered(false)
+{
+}
+
+Compiler& ModelMgr::compiler()
 {
+    boost::mutex::scoped_lock lock
+        (f_compilation_mutex);
+
+    sync_compilation_cache();
+
+    return *f_compiler;
+}
+
+CompilationUnit ModelMgr::compile(Expr_ptr ctx, Expr_ptr body)
+{
+    boost::mutex::scoped_lock lock
+        (f_compilation_mutex);
+
+    sync_compilation_cache();
+
+    CompilationKey key
+        (ctx, body);
+
+    CompilationUnitMap::const_iterator eye
+        (f_compilation_units.find(key));
+
+    if (f_compilation_units.end() != eye) {
+        DRIVEL
+            << "Compilation cache hit for "
+            << ctx << "::" << body
+            << std::endl;
+
+        return eye->second;
+    }
+
+    /* module instance templates */
+    Module_ptr module
+        (template_module(ctx));
+
+    CompilationTemplateKey template_key
+        (module, body);
+
+    CompilationTemplateMap::const_iterator ti
+        (module
+         ? f_compilation_templates.find(template_key)
+         : f_compilation_templates.end());
+
+    if (f_compilation_templates.end() != ti) {
+        Expr_ptr from
+            (ti->second);
+
+        CompilationUnitMap::const_iterator templ
+            (f_compilation_units.find(CompilationKey(from, body)));
+        assert(f_compilation_units.end() != templ);
+
+        CompilationUnits instance;
+        if (f_compiler->instantiate(templ->second, from, ctx, body, instance)) {
+            DRIVEL
+                << "Instantiated "
+                << from << "::" << body
+                << " in "
+                << ctx
+                << std::endl;
+
+            f_compilation_units.insert(std::pair<CompilationKey, CompilationUnit>
+                                       (key, instance.back()));
+
+            return instance.back();
+        }
+    }
+
+    CompilationUnit res
+        (f_compiler->process(ctx, body));
+
+    f_compilation_units.insert(std::pair<CompilationKey, CompilationUnit>
+                               (key, res));
+
+    /* first instance compiled, the template for the others */
+    if (module && f_compilation_templates.end() == ti)
+        f_compilation_templates.insert(std::pair<CompilationTemplateKey, Expr_ptr>
+                                       (template_key, ctx));
+
+    return res;
+}
+
+void ModelMgr::precompile(const CompilationKeys& keys)
+{
+    boost::mutex::scoped_lock lock
+        (f_compilation_mutex);
+
+    sync_compilation_cache();
+
+    /* first instances of module bodies, in this batch */
+    CompilationTemplateMap templates;
+    boost::unordered_set<CompilationKey,
+                         boost::hash<CompilationKey> > seen;
+
+    CompilationKeys items;
+    for (CompilationKeys::const_iterator i = keys.begin(); keys.end() != i; ++ i) {
+        const CompilationKey& key
+            (*i);
+
+        if (! seen.insert(key).second)
+            continue;
+
+        if (f_compilation_units.end() != f_compilation_units.find(key))
+            continue;
+
+        Module_ptr module
+            (template_module(key.first));
+
+        if (module) {
+            CompilationTemplateKey template_key
+                (module, key.second);
+
+            if (f_compilation_templates.end() !=
+                f_compilation_templates.find(template_key))
+                continue;
+
+            if (! templates.insert(std::pair<CompilationTemplateKey, Expr_ptr>
+                                   (template_key, key.first)).second)
+                continue;
+        }
+
+        items.push_back(key);
+    }
+
+    if (items.empty())
+        return;
+
+    CompilationUnitMap units;
+    f_compiler->process(items, compile_threads(), units);
+
+    for (CompilationKeys::const_iterator i = items.begin(); items.end() != i; ++ i) {
+        CompilationUnitMap::const_iterator eye
+            (units.find(*i));
+
+        if (units.end() == eye)
+            continue;
+
+        f_compilation_units.insert(*eye);
+
+        Module_ptr module
+            (template_module(i->first));
+
+        /* first instance compiled, the template for the others */
+        if (module)
+            f_compilation_templates.insert(std::pair<CompilationTemplateKey, Expr_ptr>
+                                           (CompilationTemplateKey(module, i->second),
+                                            i->first));
+    }
+
+    unsigned nunits
+        (units.size());
+    unsigned nitems
+        (items.size());
+
+    DEBUG
+        << "Precompiled "
+        << nunits << " of " << nitems
+        << " compilation units"
+        << std::endl;
+}
+
+void ModelMgr::invalidate_compilation_cache()
+{
+    boost::mutex::scoped_lock lock
+        (f_compilation_mutex);
+
+    f_compilation_units.clear();
+    f_compilation_templates.clear();
+    if (f_compiler)
+        f_compiler->clear_cache();
+
+    f_compilation_ordered = false;
+}
+
+/* private, f_compilation_mutex must be held */
+void ModelMgr::sync_compilation_cache()
+{
+    if (! f_compiler)
+        f_compiler = new Compiler();
+
+    /* initial DD variable order, before anything is compiled */
+    if (! f_compilation_ordered) {
+        if (OptsMgr::INSTANCE().dd_ordering()) {
+            StaticOrdering ordering
+                (*this);
+
+            ordering.process();
+        }
+
+        f_compilation_ordered = true;
+    }
+
+    unsigned revision
+        (Environment::INSTANCE().revision());
+
+    if (revision == f_compilation_revision)
+        return;
+
+    unsigned nunits
+        (f_compilation_units.size());
+
+    DEBUG
+        << "Environment changed, dropping "
+        << nunits
+        << " cached compilation units"
+        << std::endl;
+
+    f_compilation_units.clear();
+    f_compilation_templates.clear();
+    f_compiler->clear_cache();
+
+    f_compilation_revision = revision;
+}
+
+/* private, the module ctx is an instance of, if the units compiled in
+   ctx are templates for the other instances (cfr. compile()) */
+Module_ptr ModelMgr::template_module(Expr_ptr ctx)
+{
+    if (! ctx)
+        return NULL;
+
+    ContextMap::const_iterator mi
+        (f_context_map.find(ctx));
+
+    if (f_context_map.end() != mi && mi->second->parameters().empty())
+        return mi->second;
+
+    return NULL;
 }
 
 Module_ptr ModelMgr::scope(Expr_ptr key)
@@ -466,6 +724,9 @@ bool ModelMgr::analyze_aux(analyzer_pass_t pass)
    analyzer_pass_t enum definition for the exact sequence of actions. */
 bool ModelMgr::analyze()
 {
+    /* compiled units refer to the previous model, if any */
+    invalidate_compilation_cache();
+
     analyzer_pass_t pass
         ((analyzer_pass_t) 0);
 
@@ -485,6 +746,22 @@ bool ModelMgr::analyze()
     f_analyzed = true;
     f_analyzer.generate_framing_conditions();
 
+    /* INPUT values are compiled in, changing them drops the
+       compilation cache */
+    Environment& env
+        (Environment::INSTANCE());
+
+    SymbIter symbs
+        (model());
+
+    while (symbs.has_next()) {
+        Symbol_ptr symb
+            (symbs.next().second);
+
+        if (symb->is_variable() && symb->as_variable().is_input())
+            env.watch(symb->name());
+    }
+
     TRACE
         << "Model analysis complete"
         << std::endl;
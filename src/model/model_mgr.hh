@@ -35,11 +35,30 @@
 #include <model/analyzer/analyzer.hh>
 #include <model/type_checker/type_checker.hh>
 
+#include <model/compiler/unit.hh>
+
 #include <type/type_mgr.hh>
 
+#include <boost/functional/hash.hpp>
+#include <boost/thread/mutex.hpp>
+
 typedef boost::unordered_map<Expr_ptr, Module_ptr, PtrHash, PtrEq> ContextMap;
 typedef boost::unordered_map<Expr_ptr, Expr_ptr> ParamMap;
 
+/* (ctx, body) -> compilation unit, cfr. ModelMgr::compile() */
+typedef std::pair<Expr_ptr, Expr_ptr> CompilationKey;
+typedef boost::unordered_map<CompilationKey, CompilationUnit,
+                             boost::hash<CompilationKey> > CompilationUnitMap;
+typedef std::vector<CompilationKey> CompilationKeys;
+
+/* (module, body) -> context of the instance compiled first, whose
+   unit is the template for all the other instances */
+typedef std::pair<Module_ptr, Expr_ptr> CompilationTemplateKey;
+typedef boost::unordered_map<CompilationTemplateKey, Expr_ptr,
+                             boost::hash<CompilationTemplateKey> > CompilationTemplateMap;
+
+class Compiler;
+
 typedef enum {
     MMGR_BUILD_CTX_MAP,
     MMGR_BUILD_PARAM_MAP,
@@ -76,21 +95,49 @@ public:
     inline Analyzer& analyzer() const
     { return f_analyzer; }
 
-    // delegated type inference method
+    // delegated type inference method (synchronized)
     inline Type_ptr type(Expr_ptr body,
                          Expr_ptr ctx = ExprMgr::INSTANCE().make_empty())
     {
         assert( f_analyzed );
+
+        boost::mutex::scoped_lock lock
+            (f_type_checker_mutex);
+
         return f_type_checker.type(body, ctx);
     }
 
-    // delegated param binding method
+    // delegated param binding method (synchronized)
     inline Expr_ptr preprocess(Expr_ptr body,
                                Expr_ptr ctx = ExprMgr::INSTANCE().make_empty())
     {
+        boost::mutex::scoped_lock lock
+            (f_preprocessor_mutex);
+
         return f_preprocessor.process(body, ctx);
     }
 
+    /* Model-scoped compiler, shared by all the algorithms */
+    Compiler& compiler();
+
+    /* Compiles ctx::body with the model-scoped compiler. Units are
+       cached until the model is analyzed again, or the environment
+       changes (e.g. values of INPUT vars, extra constraints). Bodies
+       of modules with no parameters are compiled once, the units for
+       the other instances are obtained by remapping bits (cfr.
+       Compiler::instantiate()). */
+    CompilationUnit compile(Expr_ptr ctx, Expr_ptr body);
+
+    /* Compiles a batch of items ahead of compile(), the units are
+       cached. Items are spread across `compile_threads` workers, the
+       units do not depend on their number (cfr.
+       Compiler::process()). Items compiled already, further instances
+       of a module body and items that fail to compile are left to
+       compile(), which reports the errors. */
+    void precompile(const CompilationKeys& keys);
+
+    void invalidate_compilation_cache();
+
     Module_ptr scope(Expr_ptr ctx);
 
     Expr_ptr rewrite_parameter( Expr_ptr expr );
@@ -122,12 +169,14 @@ private:
 
     // ref to preprocessor (used for defines expr substitution)
     Preprocessor& f_preprocessor;
+    boost::mutex f_preprocessor_mutex;
 
     // ref to analyzer (used for model analysis)
     Analyzer& f_analyzer;
 
     // ref to type_checker (used for model analysis)
     TypeChecker& f_type_checker;
+    boost::mutex f_type_checker_mutex;
 
     ContextMap f_context_map;
     ParamMap f_param_map;
@@ -135,6 +184,19 @@ private:
     /* internals */
     bool analyze_aux( analyzer_pass_t pass );
     bool f_analyzed;
+
+    /* compilation cache, cfr. compile() */
+    void sync_compilation_cache();
+    Module_ptr template_module(Expr_ptr ctx);
+
+    boost::mutex f_compilation_mutex;
+    Compiler* f_compiler;
+    CompilationUnitMap f_compilation_units;
+    CompilationTemplateMap f_compilation_templates;
+    unsigned f_compilation_revision;
+
+    /* static DD variable order set for the current model? */
+    bool f_compilation_ordered;
 };
 
 #endif /* MODEL_MGR_H */
@@ -98,6 +98,24 @@ void Module::add_var(Expr_ptr identifier, Variable_ptr var)
                        (identifier, var));
 }
 
+void Module::remove_var(Expr_ptr identifier)
+{
+    DEBUG
+        << "Module `"
+        << (*this)
+        << "`, removed var `" << identifier << "`"
+        << std::endl;
+
+    f_locals.erase(identifier);
+
+    Variables::iterator eye
+        (f_localVars.find(identifier));
+    assert(f_localVars.end() != eye);
+
+    delete eye->second;
+    f_localVars.erase(eye);
+}
+
 void Module::add_parameter(Expr_ptr identifier, Parameter_ptr param)
 {
     Expr_ptr type_repr
@@ -209,3 +227,51 @@ void Module::add_trans(Expr_ptr expr)
 
     f_trans.push_back(expr);
 }
+
+void Module::remove_init(Expr_ptr expr)
+{
+    ExprVector::iterator eye
+        (std::find(f_init.begin(), f_init.end(), expr));
+    assert(f_init.end() != eye);
+
+    DEBUG
+        << "Module `"
+        << (*this)
+        << "`, removed INIT "
+        << expr
+        << std::endl;
+
+    f_init.erase(eye);
+}
+
+void Module::remove_invar(Expr_ptr expr)
+{
+    ExprVector::iterator eye
+        (std::find(f_invar.begin(), f_invar.end(), expr));
+    assert(f_invar.end() != eye);
+
+    DEBUG
+        << "Module `"
+        << (*this)
+        << "`, removed INVAR "
+        << expr
+        << std::endl;
+
+    f_invar.erase(eye);
+}
+
+void Module::remove_trans(Expr_ptr expr)
+{
+    ExprVector::iterator eye
+        (std::find(f_trans.begin(), f_trans.end(), expr));
+    assert(f_trans.end() != eye);
+
+    DEBUG
+        << "Module `"
+        << (*this)
+        << "`, removed TRANS "
+        << expr
+        << std::endl;
+
+    f_trans.erase(eye);
+}
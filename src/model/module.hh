@@ -43,6 +43,9 @@ public:
     { return f_localVars; }
     void add_var(Expr_ptr expr, Variable_ptr var);
 
+    /* the module owns its variables, the removed one is deleted */
+    void remove_var(Expr_ptr expr);
+
     inline const Parameters& parameters() const
     { return f_localParams; }
     void add_parameter(Expr_ptr expr, Parameter_ptr param);
@@ -56,14 +59,17 @@ public:
     inline const ExprVector& init() const
     { return f_init; }
     void add_init(Expr_ptr expr);
+    void remove_init(Expr_ptr expr);
 
     const ExprVector& invar() const
     { return f_invar; }
     void add_invar(Expr_ptr expr);
+    void remove_invar(Expr_ptr expr);
 
     inline const ExprVector& trans() const
     { return f_trans; }
     void add_trans(Expr_ptr expr);
+    void remove_trans(Expr_ptr expr);
 
 private:
     friend std::ostream& operator<<(std::ostream& os, Module& module);
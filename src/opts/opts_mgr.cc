@@ -67,6 +67,30 @@ OptsMgr::OptsMgr()
          "native word size in bits"
         )
 
+        (
+         "dd-unique-slots",
+         options::value<unsigned>()->default_value(DEFAULT_DD_UNIQUE_SLOTS),
+         "initial size of DD unique subtables"
+        )
+
+        (
+         "dd-cache-slots",
+         options::value<unsigned>()->default_value(DEFAULT_DD_CACHE_SLOTS),
+         "initial size of DD computed table"
+        )
+
+        (
+         "dd-reorder",
+         options::value<unsigned>()->default_value(DEFAULT_DD_REORDER),
+         "DD dynamic reordering (0 disables)"
+        )
+
+        (
+         "dd-ordering",
+         options::value<unsigned>()->default_value(DEFAULT_DD_ORDERING),
+         "DD static variable ordering from model structure (0 disables)"
+        )
+
         (
          "verbosity",
          options::value<unsigned>()->default_value(DEFAULT_VERBOSITY),
@@ -166,6 +190,33 @@ unsigned OptsMgr::precision() const
         : f_vm["precision"].as<unsigned>();
 }
 
+unsigned OptsMgr::dd_unique_slots() const
+{
+    return f_started
+        ? f_vm["dd-unique-slots"].as<unsigned>()
+        : DEFAULT_DD_UNIQUE_SLOTS;
+}
+
+unsigned OptsMgr::dd_cache_slots() const
+{
+    return f_started
+        ? f_vm["dd-cache-slots"].as<unsigned>()
+        : DEFAULT_DD_CACHE_SLOTS;
+}
+
+bool OptsMgr::dd_reorder() const
+{
+    return 0 != (f_started
+                 ? f_vm["dd-reorder"].as<unsigned>()
+                 : DEFAULT_DD_REORDER);
+}
+
+bool OptsMgr::dd_ordering() const
+{
+    return 0 != (f_started
+                 ? f_vm["dd-ordering"].as<unsigned>()
+                 : DEFAULT_DD_ORDERING);
+}
 
 std::string OptsMgr::model() const
 {
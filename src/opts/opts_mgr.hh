@@ -40,6 +40,12 @@ const unsigned DEFAULT_WORD_WIDTH     = 16;
 const unsigned DEFAULT_PRECISION      = 0;
 const unsigned DEFAULT_VERBOSITY      = 0;
 
+// -- DD manager defaults (cfr. CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS)
+const unsigned DEFAULT_DD_UNIQUE_SLOTS = 256;
+const unsigned DEFAULT_DD_CACHE_SLOTS  = 262144;
+const unsigned DEFAULT_DD_REORDER      = 1;
+const unsigned DEFAULT_DD_ORDERING     = 1;
+
 class OptsMgr {
 
 public:
@@ -73,6 +79,18 @@ public:
     unsigned precision() const;
     void set_precision(unsigned);
 
+    // initial size of DD unique subtables (per variable)
+    unsigned dd_unique_slots() const;
+
+    // initial size of DD computed table
+    unsigned dd_cache_slots() const;
+
+    // true iff DD dynamic reordering is enabled
+    bool dd_reorder() const;
+
+    // true iff DD variables are ordered by model structure
+    bool dd_ordering() const;
+
     // model filename
     std::string model() const;
 
@@ -901,6 +901,9 @@ command_topic returns [CommandTopic_ptr res]
     :  c=check_init_command_topic
        { $res = c; }
 
+    |  c=check_ltl_command_topic
+       { $res = c; }
+
     |  c=check_trans_command_topic
        { $res = c; }
 
@@ -946,6 +949,9 @@ command_topic returns [CommandTopic_ptr res]
     |  c=quit_command_topic
        { $res = c; }
 
+    |  c=random_simulate_command_topic
+       { $res = c; }
+
     |  c=reach_command_topic
        { $res = c; }
 
@@ -963,6 +969,9 @@ command returns [Command_ptr res]
     :  c=check_init_command
        { $res = c; }
 
+    |  c=check_ltl_command
+       { $res = c; }
+
     |  c=check_trans_command
        { $res = c; }
 
@@ -1008,6 +1017,9 @@ command returns [Command_ptr res]
     |  c=quit_command
        { $res = c; }
 
+    |  c=random_simulate_command
+       { $res = c; }
+
     |  c=reach_command
        { $res = c; }
 
@@ -1147,10 +1159,56 @@ check_init_command_topic returns [CommandTopic_ptr res]
         { $res = cm.topic_check_init(); }
     ;
 
+check_ltl_command returns[Command_ptr res]
+    :   'check-ltl'
+        { $res = cm.make_check_ltl(); }
+
+        (
+            '-k' bound=constant
+            { ((CheckLTL_ptr) $res)->set_bound(bound->value()); }
+
+        |   '-s' strategy=pcchar_identifier
+            { ((CheckLTL_ptr) $res)->add_strategy(strategy); }
+
+            ( ',' strategy=pcchar_identifier
+            { ((CheckLTL_ptr) $res)->add_strategy(strategy); } )*
+        )*
+
+        property=toplevel_expression
+        { ((CheckLTL_ptr) $res)->set_property(property); }
+
+        ( '-c' constraint=toplevel_expression
+        { ((CheckLTL_ptr) $res)->add_constraint(constraint); })*
+    ;
+
+check_ltl_command_topic returns [CommandTopic_ptr res]
+    :  'check-ltl'
+        { $res = cm.topic_check_ltl(); }
+    ;
+
 reach_command returns[Command_ptr res]
     :   'reach'
         { $res = cm.make_reach(); }
 
+        (
+            '-u' mode=pcchar_identifier
+            { ((Reach_ptr) $res)->set_uniqueness(mode); }
+
+        |   '-s' reach_strategy[$res] ( ',' reach_strategy[$res] )*
+
+        |   '-j' threads=constant
+            { ((Reach_ptr) $res)->set_threads(threads->value()); }
+
+        |   '-x'
+            { ((Reach_ptr) $res)->set_sharing(true); }
+
+        |   '-k' step=constant
+            { ((Reach_ptr) $res)->set_induction_step(step->value()); }
+
+        |   '-l' lemma=toplevel_expression
+            { ((Reach_ptr) $res)->add_lemma(lemma); }
+        )*
+
         target=toplevel_expression
         { ((Reach_ptr) $res)->set_target(target); }
 
@@ -1158,6 +1216,20 @@ reach_command returns[Command_ptr res]
         { ((Reach_ptr) $res)->add_constraint(constraint); })*
     ;
 
+reach_strategy [Command_ptr cmd]
+@init {
+    value_t seed = 0;
+    pconst_char backend = NULL;
+}
+    :   strategy=pcchar_identifier
+        ( ':' konst=constant
+          { seed = konst->value(); }
+          ( ':' id=pcchar_identifier
+            { backend = id; } )? )?
+
+        { ((Reach_ptr) cmd)->add_strategy(strategy, seed, backend); }
+    ;
+
 reach_command_topic returns [CommandTopic_ptr res]
     :  'reach'
         { $res = cm.topic_reach(); }
@@ -1268,6 +1340,31 @@ simulate_command_topic returns [CommandTopic_ptr res]
         { $res = cm.topic_simulate(); }
     ;
 
+random_simulate_command returns [Command_ptr res]
+    : 'random-simulate'
+      { $res = cm.make_random_simulate(); }
+    (
+       '-t' target=toplevel_expression
+        { ((RandomSimulate_ptr) $res)->add_target(target); }
+
+    |  '-c' constraint=toplevel_expression
+        { ((RandomSimulate_ptr) $res)->add_constraint(constraint); }
+
+    |   '-k' konst=constant
+        { ((RandomSimulate_ptr) $res)->set_k(konst->value()); }
+
+    |   '-n' konst=constant
+        { ((RandomSimulate_ptr) $res)->set_traces(konst->value()); }
+
+    |   '-s' konst=constant
+        { ((RandomSimulate_ptr) $res)->set_seed(konst->value()); }
+    )* ;
+
+random_simulate_command_topic returns [CommandTopic_ptr res]
+    :  'random-simulate'
+        { $res = cm.topic_random_simulate(); }
+    ;
+
 get_command returns [Command_ptr res]
     : 'get'
       { $res = cm.make_get(); }
@@ -0,0 +1,85 @@
+/**
+ * @file sat/backend.cc
+ * @brief SAT interface, SAT backends factory implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/sat.hh>
+
+#include <sat/backend_minisat.hh>
+#include <sat/backend_ipasir.hh>
+
+#include <env/environment.hh>
+
+static const char* SAT_BACKEND_IDENTIFIER = "sat_backend";
+static const char* DEFAULT_SAT_BACKEND = "simp";
+
+const char* sat_backends()
+{
+#ifdef HAVE_IPASIR
+    return "simp, core, ipasir";
+#else
+    return "simp, core";
+#endif
+}
+
+std::string sat_backend()
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Environment& env
+        (Environment::INSTANCE());
+
+    try {
+        Expr_ptr value
+            (env.get(em.make_identifier(SAT_BACKEND_IDENTIFIER)));
+
+        if (em.is_identifier(value))
+            return value->atom();
+
+        WARN
+            << "Unsupported " << SAT_BACKEND_IDENTIFIER
+            << " `" << value << "`, "
+            << "falling back to "
+            << DEFAULT_SAT_BACKEND
+            << std::endl;
+    }
+    catch (NoSuchIdentifier& nsi) {
+    }
+
+    return DEFAULT_SAT_BACKEND;
+}
+
+SATBackend_ptr make_sat_backend(const std::string& name)
+{
+    if (name == "simp")
+        return new MinisatSimpBackend();
+
+    if (name == "core")
+        return new MinisatCoreBackend();
+
+#ifdef HAVE_IPASIR
+    if (name == "ipasir")
+        return new IPASIRBackend();
+#endif
+
+    throw UnsupportedSATBackend(name);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file sat/backend.hh
+ * @brief SAT interface, SAT backends declarations.
+ *
+ * This header file contains the abstract interface of an incremental
+ * SAT solver, as seen by the Engine. Each Engine owns exactly one
+ * backend, chosen at construction time (cfr. `set sat_backend`).
+ * Variables and literals are expressed in Minisat's (header-only)
+ * value types, backends translate them as needed.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_BACKEND_H
+#define SAT_BACKEND_H
+
+#include <iostream>
+#include <string>
+
+#include <sat/typedefs.hh>
+
+class SATBackend {
+public:
+    virtual ~SATBackend()
+    {}
+
+    /**
+     * @brief Backend name, as accepted by make_sat_backend()
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief A new variable. Variables are numbered consecutively,
+     * starting from 0.
+     */
+    virtual Var new_var() = 0;
+
+    /**
+     * @brief Protects var from elimination. Backends that do not
+     * eliminate variables ignore this.
+     */
+    virtual void set_frozen(Var var, bool frozen) = 0;
+
+    /**
+     * @brief Adds a clause. The contents of ps are undefined on exit.
+     */
+    virtual void add_clause(vec<Lit>& ps) = 0;
+
+    /**
+     * @brief Solves under assumptions, within the current budget.
+     */
+    virtual status_t solve(const vec<Lit>& assumptions) = 0;
+
+    /**
+     * @brief After an UNSAT solve(), appends to out the assumptions
+     * that were used to prove unsatisfiability.
+     */
+    virtual void failed(vec<Lit>& out) = 0;
+
+    /**
+     * @brief Conflicts and propagations budget for the next solve()
+     * calls, negative values mean no limit.
+     */
+    virtual void set_budget(int64_t conf_budget, int64_t prop_budget) = 0;
+
+    /**
+     * @brief Seeds the solver's pseudo-random choices, used to
+     * diversify otherwise identical instances. seed is non-zero.
+     */
+    virtual void set_seed(unsigned seed) = 0;
+
+    /**
+     * @brief Asynchronously interrupts solve(), thread-safe. The
+     * interrupt is sticky: all subsequent solve() calls return
+     * STATUS_UNKNOWN.
+     */
+    virtual void interrupt() = 0;
+
+    /**
+     * @brief Enables collection of the learned clauses having at most
+     * max_size literals, 0 disables it (cfr. learnts()).
+     */
+    virtual void collect_learnts(unsigned max_size) = 0;
+
+    /**
+     * @brief Appends the learned clauses collected since the previous
+     * call to out. A clause is seldom reported more than once.
+     */
+    virtual void learnts(LitsVector& out) = 0;
+
+    /**
+     * @brief Value of var in the model, after a SAT solve()
+     */
+    virtual bool model_value(Var var) = 0;
+
+    /**
+     * @brief Prints solver statistics
+     */
+    virtual void print_stats(std::ostream& os) const = 0;
+};
+
+typedef SATBackend* SATBackend_ptr;
+
+/* Available backends, as a comma separated list of names */
+const char* sat_backends();
+
+/* Currently selected backend name, from the environment */
+std::string sat_backend();
+
+/* Builds a new backend instance. Throws UnsupportedSATBackend. */
+SATBackend_ptr make_sat_backend(const std::string& name);
+
+#endif /* SAT_BACKEND_H */
@@ -0,0 +1,206 @@
+/**
+ * @file sat/backend_ipasir.cc
+ * @brief SAT interface, IPASIR backend implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/backend_ipasir.hh>
+
+#ifdef HAVE_IPASIR
+
+#include <climits>
+#include <cstdlib>
+
+extern "C" {
+#include <ipasir.h>
+}
+
+/* IPASIR variables are 1-based, sign is negation */
+static inline int to_ipasir(Lit lit)
+{
+    int res
+        (1 + Minisat::var(lit));
+
+    return Minisat::sign(lit) ? -res : res;
+}
+
+IPASIRBackend::IPASIRBackend()
+    : f_solver(ipasir_init())
+    , f_nvars(0)
+    , f_interrupted(false)
+    , f_conf_budget(-1)
+    , f_conflicts(0)
+    , f_solves(0)
+    , f_learnts_max_size(0)
+    , f_learn_length(-1)
+{
+    ipasir_set_terminate(f_solver, this, terminate);
+
+    const char* signature
+        (ipasir_signature());
+
+    DEBUG
+        << "Initialized IPASIR solver `"
+        << signature
+        << "`"
+        << std::endl;
+}
+
+IPASIRBackend::~IPASIRBackend()
+{
+    ipasir_release(f_solver);
+}
+
+void IPASIRBackend::add_clause(vec<Lit>& ps)
+{
+    for (int i = 0; i < ps.size(); ++ i)
+        ipasir_add(f_solver, to_ipasir(ps[i]));
+
+    ipasir_add(f_solver, 0);
+}
+
+status_t IPASIRBackend::solve(const vec<Lit>& assumptions)
+{
+    for (int i = 0; i < assumptions.size(); ++ i)
+        ipasir_assume(f_solver, to_ipasir(assumptions[i]));
+
+    assumptions.copyTo(f_assumptions);
+
+    ++ f_solves;
+    f_conflicts = 0;
+
+    int status
+        (ipasir_solve(f_solver));
+
+    if (10 == status)
+        return STATUS_SAT;
+
+    if (20 == status)
+        return STATUS_UNSAT;
+
+    return STATUS_UNKNOWN;
+}
+
+void IPASIRBackend::failed(vec<Lit>& out)
+{
+    for (int i = 0; i < f_assumptions.size(); ++ i)
+        if (ipasir_failed(f_solver, to_ipasir(f_assumptions[i])))
+            out.push(f_assumptions[i]);
+}
+
+void IPASIRBackend::set_budget(int64_t conf_budget, int64_t prop_budget)
+{
+    f_conf_budget = conf_budget;
+    update_learn();
+
+    if (0 <= prop_budget)
+        WARN
+            << "IPASIR backend does not support propagation budgets"
+            << std::endl;
+}
+
+void IPASIRBackend::collect_learnts(unsigned max_size)
+{
+    f_learnts_max_size = max_size;
+    update_learn();
+}
+
+/* The learned clauses callback is registered only when needed: a
+   conflicts budget needs every learned clause to count conflicts,
+   clause exchange only the ones up to the exchange size. Once
+   registered, a callback can not be removed: a zero length only
+   reports empty clauses. */
+void IPASIRBackend::update_learn()
+{
+    int length
+        (0 <= f_conf_budget ? INT_MAX : (int) f_learnts_max_size);
+
+    if (length == f_learn_length || (0 == length && f_learn_length < 0))
+        return;
+
+    ipasir_set_learn(f_solver, this, length, learn);
+    f_learn_length = length;
+}
+
+void IPASIRBackend::learnts(LitsVector& out)
+{
+    out.insert(out.end(), f_learnts.begin(), f_learnts.end());
+    f_learnts.clear();
+}
+
+bool IPASIRBackend::model_value(Var var)
+{
+    return 0 < ipasir_val(f_solver, 1 + var);
+}
+
+void IPASIRBackend::print_stats(std::ostream& os) const
+{
+    os
+        << "solver: "
+        << ipasir_signature()
+
+        << ", solves: "
+        << f_solves
+        ;
+}
+
+int IPASIRBackend::terminate(void* data)
+{
+    IPASIRBackend& backend
+        (*reinterpret_cast<IPASIRBackend*> (data));
+
+    return
+        backend.f_interrupted ||
+        (0 <= backend.f_conf_budget &&
+         backend.f_conf_budget <= backend.f_conflicts);
+}
+
+/* one learned clause per conflict, cfr. update_learn() */
+void IPASIRBackend::learn(void* data, int* clause)
+{
+    IPASIRBackend& backend
+        (*reinterpret_cast<IPASIRBackend*> (data));
+
+    ++ backend.f_conflicts;
+
+    if (! backend.f_learnts_max_size)
+        return;
+
+    unsigned size
+        (0);
+    while (clause[size])
+        ++ size;
+
+    if (backend.f_learnts_max_size < size)
+        return;
+
+    backend.f_learnts.push_back(Lits());
+
+    Lits& lits
+        (backend.f_learnts.back());
+    for (unsigned i = 0; i < size; ++ i) {
+        int lit
+            (clause[i]);
+
+        lits.push_back(mkLit(abs(lit) - 1, lit < 0));
+    }
+}
+
+#endif /* HAVE_IPASIR */
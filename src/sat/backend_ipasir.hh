@@ -0,0 +1,105 @@
+/**
+ * @file sat/backend_ipasir.hh
+ * @brief SAT interface, IPASIR backend declarations.
+ *
+ * The `ipasir` backend wraps any solver library implementing the
+ * standard IPASIR incremental interface. It is available only if
+ * such a library was found at configure time (cfr. --with-ipasir).
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_BACKEND_IPASIR_H
+#define SAT_BACKEND_IPASIR_H
+
+#include <sat/backend.hh>
+
+#ifdef HAVE_IPASIR
+
+class IPASIRBackend : public SATBackend {
+public:
+    IPASIRBackend();
+    ~IPASIRBackend();
+
+    const char* name() const
+    { return "ipasir"; }
+
+    Var new_var()
+    { return f_nvars ++; }
+
+    /* IPASIR solvers never eliminate variables */
+    void set_frozen(Var var, bool frozen)
+    {}
+
+    void add_clause(vec<Lit>& ps);
+
+    status_t solve(const vec<Lit>& assumptions);
+
+    void failed(vec<Lit>& out);
+
+    /* IPASIR has no budgets, only the conflicts budget is honored,
+       cfr. terminate() */
+    void set_budget(int64_t conf_budget, int64_t prop_budget);
+
+    /* IPASIR solvers have no seeds */
+    void set_seed(unsigned seed)
+    {}
+
+    void interrupt()
+    { f_interrupted = true; }
+
+    void collect_learnts(unsigned max_size);
+
+    void learnts(LitsVector& out);
+
+    bool model_value(Var var);
+
+    void print_stats(std::ostream& os) const;
+
+private:
+    void* f_solver;
+    Var f_nvars;
+
+    volatile bool f_interrupted;
+
+    /* conflicts are counted via the learned clauses callback, cfr.
+       update_learn() */
+    int64_t f_conf_budget;
+    int64_t f_conflicts;
+    uint64_t f_solves;
+
+    /* last solve() assumptions, cfr. failed() */
+    vec<Lit> f_assumptions;
+
+    /* learned clauses, buffered by the learned clauses callback */
+    unsigned f_learnts_max_size;
+    LitsVector f_learnts;
+
+    /* max length of the clauses reported by the learned clauses
+       callback, -1 if the callback is not registered */
+    int f_learn_length;
+    void update_learn();
+
+    static int terminate(void* data);
+    static void learn(void* data, int* clause);
+};
+
+#endif /* HAVE_IPASIR */
+
+#endif /* SAT_BACKEND_IPASIR_H */
@@ -0,0 +1,66 @@
+/**
+ * @file sat/backend_minisat.cc
+ * @brief SAT interface, Minisat backends implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/backend_minisat.hh>
+
+template <class S>
+void MinisatBackend<S>::print_stats(std::ostream& os) const
+{
+    os
+        << "solves: "
+        << f_solver.solves
+
+        << ", starts: "
+        << f_solver.starts
+
+        << ", decs: "
+        << f_solver.decisions
+
+        << ", rnd decs: "
+        << f_solver.rnd_decisions
+
+        << ", props: "
+        << f_solver.propagations
+
+        << ", conflicts: "
+        << f_solver.conflicts
+
+        << ", dec vars: "
+        << f_solver.dec_vars
+
+        << ", clause lits: "
+        << f_solver.clauses_literals
+
+        << ", learnt lits: "
+        << f_solver.learnts_literals
+
+        << ", max lits: "
+        << f_solver.max_literals
+
+        << ", tot lits: "
+        << f_solver.tot_literals
+        ;
+}
+
+template class MinisatBackend<Minisat::SimpSolver>;
+template class MinisatBackend<Minisat::Solver>;
@@ -0,0 +1,183 @@
+/**
+ * @file sat/backend_minisat.hh
+ * @brief SAT interface, Minisat backends declarations.
+ *
+ * Two backends are provided: `simp` wraps Minisat's SimpSolver (with
+ * variable elimination, frozen variables are preserved), `core` wraps
+ * the plain, non-simplifying Minisat Solver.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_BACKEND_MINISAT_H
+#define SAT_BACKEND_MINISAT_H
+
+#include <minisat/core/Solver.h>
+#include <minisat/simp/SimpSolver.h>
+
+#include <sat/backend.hh>
+
+/* Minisat keeps learned clauses to itself. Learned clauses are
+   appended to the learnts database, so the ones past the high-water
+   mark are new since the previous scan. A database reduction reorders
+   the survivors: the mark is then clamped, and the tail past it may
+   hold a few clauses already reported (sharing is best-effort). */
+template <class S>
+class MinisatSolver : public S {
+public:
+    MinisatSolver()
+        : f_learnts_mark(0)
+    {}
+
+    void collect_learnts(unsigned max_size, LitsVector& out)
+    {
+        int size
+            (this->learnts.size());
+
+        if (size < f_learnts_mark)
+            f_learnts_mark = size;
+
+        for (int i = f_learnts_mark; i < size; ++ i) {
+            const Minisat::Clause& c
+                (this->ca[this->learnts[i]]);
+
+            if (max_size < (unsigned) c.size())
+                continue;
+
+            out.push_back(Lits());
+
+            Lits& lits
+                (out.back());
+            for (int j = 0; j < c.size(); ++ j)
+                lits.push_back(c[j]);
+        }
+
+        f_learnts_mark = size;
+    }
+
+private:
+    int f_learnts_mark;
+};
+
+template <class S>
+class MinisatBackend : public SATBackend {
+public:
+    MinisatBackend()
+        : f_learnts_max_size(0)
+    {
+        /* Default configuration */
+        f_solver.random_var_freq = .1;
+        // f_solver.ccmin_mode = 0;
+        // f_solver.phase_saving = 0;
+        f_solver.rnd_init_act = true;
+        f_solver.garbage_frac = 0.50;
+    }
+
+    virtual ~MinisatBackend()
+    {}
+
+    Var new_var()
+    { return f_solver.newVar(); }
+
+    void add_clause(vec<Lit>& ps)
+    { f_solver.addClause_(ps); }
+
+    status_t solve(const vec<Lit>& assumptions)
+    {
+        Minisat::lbool status
+            (f_solver.solveLimited(assumptions));
+
+        if (status == l_True)
+            return STATUS_SAT;
+
+        if (status == l_False)
+            return STATUS_UNSAT;
+
+        return STATUS_UNKNOWN;
+    }
+
+    /* the final conflict holds the negation of failed assumptions */
+    void failed(vec<Lit>& out)
+    {
+        for (int i = 0; i < f_solver.conflict.size(); ++ i)
+            out.push(~ f_solver.conflict[i]);
+    }
+
+    /* Minisat budgets are relative to the current counters, a
+       negative one would stop the search at the first conflict */
+    void set_budget(int64_t conf_budget, int64_t prop_budget)
+    {
+        f_solver.budgetOff();
+
+        if (0 <= conf_budget)
+            f_solver.setConfBudget(conf_budget);
+
+        if (0 <= prop_budget)
+            f_solver.setPropBudget(prop_budget);
+    }
+
+    void set_seed(unsigned seed)
+    {
+        assert(0 < seed);
+        f_solver.random_seed = seed;
+    }
+
+    void interrupt()
+    { f_solver.interrupt(); }
+
+    void collect_learnts(unsigned max_size)
+    { f_learnts_max_size = max_size; }
+
+    /* learned clauses are scanned on demand, from the high-water
+       mark of the previous scan */
+    void learnts(LitsVector& out)
+    {
+        if (f_learnts_max_size)
+            f_solver.collect_learnts(f_learnts_max_size, out);
+    }
+
+    bool model_value(Var var)
+    { return l_True == f_solver.modelValue(var); }
+
+    void print_stats(std::ostream& os) const;
+
+protected:
+    MinisatSolver<S> f_solver;
+    unsigned f_learnts_max_size;
+};
+
+class MinisatSimpBackend : public MinisatBackend<Minisat::SimpSolver> {
+public:
+    const char* name() const
+    { return "simp"; }
+
+    void set_frozen(Var var, bool frozen)
+    { f_solver.setFrozen(var, frozen); }
+};
+
+class MinisatCoreBackend : public MinisatBackend<Minisat::Solver> {
+public:
+    const char* name() const
+    { return "core"; }
+
+    void set_frozen(Var var, bool frozen)
+    {}
+};
+
+#endif /* SAT_BACKEND_MINISAT_H */
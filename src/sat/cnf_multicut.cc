@@ -0,0 +1,191 @@
+/**
+ * @file sat/cnf_multicut.cc
+ * @brief Engine interface implementation, CNFization algorithm #4 (Adaptive
+ * multi cut) implementation.
+ *
+ * Cut variables are introduced only for selected DD nodes. Each cut
+ * variable is defined (positive polarity only, cfr. cnf_polarity.cc)
+ * by expanding all paths from the cut node down to the leaves or to
+ * the next cut nodes (cfr. cnf_nocut.cc). Cut nodes are chosen bottom
+ * up so that each expansion has a bounded number of paths (clauses)
+ * and a bounded depth (clause width). Small DDs need no cuts at all,
+ * and are expanded with no auxiliary variables.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/sat.hh>
+
+#include <dd/dd_walker.hh>
+
+/* (#paths to the zero leaf or to a cut, depth) for a DD node */
+typedef std::pair<unsigned, unsigned> CutMetrics;
+typedef boost::unordered_map<DdNode*, CutMetrics, PtrHash, PtrEq> DDNode2CutMetricsMap;
+
+class CNFCutSelector : public ADDWalker {
+public:
+    CNFCutSelector(DDNodeSet& cuts, std::vector<DdNode*>& order,
+                   unsigned max_paths, unsigned max_depth)
+        : f_cuts(cuts)
+        , f_order(order)
+        , f_max_paths(max_paths)
+        , f_max_depth(max_depth)
+    {}
+
+    ~CNFCutSelector()
+    {}
+
+    void pre_hook()
+    {}
+
+    void post_hook()
+    {}
+
+    bool condition(const DdNode* node)
+    {
+        return
+            ! cuddIsConstant(node) &&
+            f_metrics.end() == f_metrics.find(const_cast<DdNode*> (node));
+    }
+
+    /* children are always visited before their parents */
+    void action(const DdNode* node)
+    {
+        DdNode* t
+            (cuddT(node));
+        DdNode* e
+            (cuddE(node));
+
+        CutMetrics res
+            (combine(metrics(t), metrics(e)));
+
+        /* too many clauses, or clauses too wide: cut children */
+        if (f_max_paths < res.first || f_max_depth < res.second) {
+            cut(t);
+            cut(e);
+
+            res = combine(metrics(t), metrics(e));
+        }
+
+        f_metrics.insert(std::pair<DdNode*, CutMetrics>
+                         (const_cast<DdNode*> (node), res));
+    }
+
+protected:
+    /* post-order visit, shared nodes are visited only once */
+    void walk()
+    {
+        while (0 != f_recursion_stack.size()) {
+            add_activation_record& curr
+                (f_recursion_stack.top());
+
+            const DdNode* node
+                (curr.node);
+
+            if (cuddIsConstant(node) || ! condition(node)) {
+                f_recursion_stack.pop();
+                continue;
+            }
+
+            switch (curr.pc) {
+            case DD_WALK_LHS:
+                curr.pc = DD_WALK_RHS;
+                f_recursion_stack.push( add_activation_record( cuddT(node)));
+                break;
+
+            case DD_WALK_RHS:
+                curr.pc = DD_WALK_NODE;
+                f_recursion_stack.push( add_activation_record( cuddE(node)));
+                break;
+
+            case DD_WALK_NODE:
+                action(node);
+                f_recursion_stack.pop();
+                break;
+
+            default: assert( false ); // unexpected
+            } /* switch() */
+        }
+    }
+
+private:
+    DDNodeSet& f_cuts;
+    std::vector<DdNode*>& f_order;
+    DDNode2CutMetricsMap f_metrics;
+
+    unsigned f_max_paths;
+    unsigned f_max_depth;
+
+    inline CutMetrics metrics(DdNode* node)
+    {
+        if (cuddIsConstant(node))
+            return CutMetrics(cuddV(node) ? 0 : 1, 0);
+
+        if (f_cuts.end() != f_cuts.find(node))
+            return CutMetrics(1, 0);
+
+        DDNode2CutMetricsMap::const_iterator eye
+            (f_metrics.find(node));
+        assert(f_metrics.end() != eye);
+
+        return eye->second;
+    }
+
+    inline CutMetrics combine(const CutMetrics& t, const CutMetrics& e)
+    {
+        return CutMetrics(t.first + e.first,
+                          1 + std::max(t.second, e.second));
+    }
+
+    inline void cut(DdNode* node)
+    {
+        if (! cuddIsConstant(node) && f_cuts.insert(node).second)
+            f_order.push_back(node);
+    }
+};
+
+void CNFTemplate::cnf_push_adaptive(const ADD& add)
+{
+    const DdNode* root
+        (add.getNode());
+
+    DDNodeSet cuts;
+    std::vector<DdNode*> order;
+
+    if (! cuddIsConstant(root)) {
+        CNFCutSelector selector
+            (cuts, order, f_config.max_paths, f_config.max_depth);
+
+        selector(add);
+    }
+
+    /* root is asserted directly, cut nodes are defined. If no cuts
+       were needed, this is just a no-cut expansion of the DD. */
+    cnf_push_paths(root, cuts, true);
+    for (std::vector<DdNode*>::const_iterator i = order.begin();
+         order.end() != i; ++ i)
+        cnf_push_paths(*i, cuts, false);
+
+    if (0 == cuts.size())
+        ++ f_stats.nocut_dds;
+    else {
+        ++ f_stats.multicut_dds;
+        f_stats.cuts += cuts.size();
+    }
+}
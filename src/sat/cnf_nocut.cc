@@ -3,15 +3,21 @@
  * @brief Engine interface implementation, CNFization algorithm #1 (No cut)
  * implementation.
  *
+ * Each path from the root of the DD to the zero leaf is excluded by a
+ * single clause, no auxiliary variables are introduced. The number of
+ * clauses is the number of such paths, hence this algorithm is only
+ * suitable for small DDs. The same paths expansion is used to define
+ * cut variables in the multi-cut algorithm (cfr. cnf_multicut.cc).
+ *
  * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
  *
  * This library is free software; you can redistribute it and/or
- * modify it under the terms of the GNU Lesser General Public License
- * as published by the Free Software Foundation; either version 2.1 of
- * the License, or (at your option) any later version.
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
  *
- * This library is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
  * Lesser General Public License for more details.
  *
@@ -21,114 +27,115 @@
  * 02110-1301 USA
  *
  **/
-#define  DEBUG_CNF_LITERALS
 
 #include <sat/sat.hh>
+
 #include <dd/dd_walker.hh>
 
-class CNFBuilderNoCut : public ADDWalker {
-public:
-    CNFBuilderNoCut(Engine& sat, step_t time,
-                    group_t group = MAINGROUP)
-        : f_sat(sat)
-        , f_time(time)
-        , f_group(group)
-    {}
+/* reserved for paths expansion */
+struct path_activation_record {
+    const DdNode* node;
+    bool then_done;
+    bool else_done;
 
-    ~CNFBuilderNoCut()
+    path_activation_record(const DdNode* dd)
+        : node(dd)
+        , then_done(false)
+        , else_done(false)
     {}
+};
 
-    void pre_hook()
-    {
-        assert(1 == f_recursion_stack.size());
-
-        add_activation_record curr = f_recursion_stack.top();
-        f_toplevel = const_cast<DdNode *>(curr.node);
-    }
-
-    void post_hook()
-    {
-        /* build and push clause toplevel */
-        vec<Lit> ps;
-        ps.push( mkLit( f_group, true));
+void CNFTemplate::cnf_push_no_cut(const ADD& add)
+{
+    DDNodeSet no_cuts;
+    cnf_push_paths(add.getNode(), no_cuts, true);
+}
 
-        assert (NULL != f_toplevel);
+void CNFTemplate::cnf_push_paths(const DdNode* node,
+                                 const DDNodeSet& cuts,
+                                 bool toplevel)
+{
+    assert(NULL != node);
+
+    /* toplevel leaf */
+    if (cuddIsConstant(node)) {
+        assert(toplevel);
+        if (! cuddV(node)) {
+            append( mkLit( 0, true)); /* makes formula unsatisfiable */
+            close_clause();
+        }
 
-        /* assert toplevel fun */
-        push1( f_sat.find_cnf_var(f_toplevel, f_time), false);
+        return;
     }
 
-    inline bool is_unseen(const DdNode* node) const
-    { return f_seen.end() == f_seen.find(const_cast<DdNode *>(node)); }
-
-    inline void mark(const DdNode* node)
-    { f_seen.insert(const_cast<DdNode *>(node)); }
+    /* a cut node is only defined when it holds (cfr. cnf_polarity.cc) */
+    Lit head
+        (mkLit( toplevel ? 0 : find_cnf_var(node), true));
 
-    bool condition(const DdNode *node)
-    {
-        return
-            cuddIsConstant(node) && ! cuddV(node);
-    }
+    std::vector<Lit> path;
+    std::vector<path_activation_record> stack;
+    stack.push_back( path_activation_record(node));
 
-    void action(const DdNode *node)
-    {
-      DdManager* dd_mgr
-        (f_sat.enc().dd().getManager());
+    while (0 != stack.size()) {
+        path_activation_record& curr
+            (stack.back());
 
-        value_t value
-            (Cudd_V(node));
-        assert(! value);
+        if (curr.then_done && curr.else_done) {
+            stack.pop_back();
+            if (0 != stack.size())
+                path.pop_back();
 
-        vec<Lit> ps;
-        if (MAINGROUP != f_group)
-            ps.push( mkLit( f_group, true));
+            continue;
+        }
 
-        unsigned i, size = dd_mgr->size;
-        for (i = 0; i < size; ++ i) {
-            Lit lit
-                (mkLit( f_sat.find_dd_var(i, f_time), true));
+        const DdNode* dd
+            (curr.node);
 
-            ps.push(lit);
-        }
+        /* taking the THEN arc requires v, hence ! v is in the clause */
+        bool is_then
+            (! curr.then_done);
 
-        f_sat.add_clause(ps);
+        if (is_then)
+            curr.then_done = true;
+        else
+            curr.else_done = true;
 
-        DEBUG
-            << ps
-            << std::endl;
-}
+        const DdNode* child
+            (is_then ? cuddT(dd) : cuddE(dd));
 
-private:
-    Engine& f_sat;
-    boost::unordered_set<DdNode*> f_seen;
+        Lit lit
+            (mkLit( find_dd_var(dd), is_then));
 
-    DdNode* f_toplevel;
+        if (cuddIsConstant(child)) {
+            if (! cuddV(child)) {
+                if (! toplevel)
+                    append(head);
 
-    step_t f_time;
-    group_t f_group;
+                for (std::vector<Lit>::const_iterator i = path.begin();
+                     path.end() != i; ++ i)
+                    append(*i);
 
-    /* push 1 var clause */
-    inline void push1( Var x, bool px )
-    {
-        vec<Lit> ps;
-        ps.push( mkLit( f_group, true));
-        ps.push( mkLit( x, px ));
+                append(lit);
+                close_clause();
+            }
+        }
 
-#ifdef DEBUG_CNF_LITERALS
-        DRIVEL
-            << ps
-            << std::endl;
-#endif
+        else if (cuts.end() != cuts.find(const_cast<DdNode*> (child))) {
+            if (! toplevel)
+                append(head);
 
-        f_sat.add_clause(ps);
-    }
-};
+            for (std::vector<Lit>::const_iterator i = path.begin();
+                 path.end() != i; ++ i)
+                append(*i);
 
-void Engine::cnf_push_no_cut(ADD add, step_t time, const group_t group)
-{
-    CNFBuilderNoCut worker
-        (*this, time, group);
+            append(lit);
+            append( mkLit( find_cnf_var(child), false));
+            close_clause();
+        }
 
-    worker(add);
+        else {
+            path.push_back(lit);
+            stack.push_back( path_activation_record(child));
+        }
+    }
 }
-
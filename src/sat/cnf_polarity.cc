@@ -0,0 +1,258 @@
+/**
+ * @file sat/cnf_polarity.cc
+ * @brief Engine interface implementation, CNFization algorithm #3 (Polarity
+ * aware single cut) implementation.
+ *
+ * This is the single cut algorithm, restricted to the Plaisted-Greenbaum
+ * encoding: for each cut variable only the clauses required by the
+ * polarities the node actually occurs with are emitted. The toplevel
+ * of a DD is always asserted, and 0/1-ADDs have no complemented arcs,
+ * hence every node reachable from the toplevel occurs positively: only
+ * the f -> ITE(v, t, e) half of each bi-implication is needed.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/sat.hh>
+
+#include <dd/dd_walker.hh>
+
+// #define DEBUG_CNF_LITERALS
+
+class CNFBuilderPolarity : public ADDWalker {
+public:
+    CNFBuilderPolarity(CNFTemplate& tmpl)
+        : f_tmpl(tmpl)
+        , f_toplevel(NULL)
+    {}
+
+    ~CNFBuilderPolarity()
+    {}
+
+    void pre_hook()
+    {
+        assert(1 == f_recursion_stack.size());
+
+        add_activation_record curr = f_recursion_stack.top();
+        f_toplevel = const_cast<DdNode *>(curr.node);
+    }
+
+    void post_hook()
+    {
+        /* build and push clause toplevel */
+        assert (NULL != f_toplevel);
+
+        /* assert toplevel fun, positive polarity */
+        push1( f_tmpl.find_cnf_var(f_toplevel), false);
+    }
+
+    inline bool is_toplevel() const
+    { return 1 == f_recursion_stack.size(); }
+
+    inline bool is_unseen(const DdNode* node) const
+    { return f_seen.end() == f_seen.find(const_cast<DdNode *>(node)); }
+
+    inline void mark(const DdNode* node)
+    { f_seen.insert(const_cast<DdNode *>(node)); }
+
+    bool condition(const DdNode* node)
+    {
+        assert(NULL != node);
+        return
+            cuddIsConstant(node)
+
+            /* toplevel leaf or ... */
+            ? is_toplevel()
+
+            /* is a non-constant, yet unseen node. */
+            : is_unseen(node) ;
+    }
+
+    void action(const DdNode* node)
+    {
+        if (cuddIsConstant(node)) {
+            assert(is_toplevel());
+            if (! Cudd_V(node))
+                push1(0, true); /* makes formula unsatisfiable */
+        }
+        else {
+            mark(node);
+
+            Var f
+                (f_tmpl.find_cnf_var(node));
+            Var v
+                (f_tmpl.find_dd_var(node));
+
+            /* both T, E are consts */
+            if (cuddIsConstant(cuddT(node)) &&
+                cuddIsConstant(cuddE(node))) {
+
+                /* positive polarity (T ^ !E) */
+                if (0 != cuddV(cuddT(node)) &&
+                    0 == cuddV(cuddE(node)))
+
+                    /* f -> v */
+                    push2( f, true, v, false );
+
+                /* negative polarity (!T ^ E) */
+                else if (0 == cuddV(cuddT(node)) &&
+                         0 != cuddV(cuddE(node)))
+
+                    /* f -> ! v */
+                    push2( f, true, v, true );
+
+                else assert (false); /* unreachable */
+            }
+
+            /* T is const, E is not */
+            else if (cuddIsConstant(cuddT(node)) &&
+                     ! cuddIsConstant(cuddE(node))) {
+
+                Var e
+                    (f_tmpl.find_cnf_var(cuddE(node)));
+
+                /* Positive polarity (T) */
+                if (0 != cuddV(cuddT(node)))
+
+                    /* (!f |  v |  e) */
+                    push3( f, true , v, false, e, false);
+
+                /* Negative polarity (!T) */
+                else {
+                    /* ( !f | !v ) ; */
+                    push2( f, true, v, true);
+
+                    /* ( !f | e ) */
+                    push2( f, true, e, false);
+                }
+            }
+
+            /* E is const, T is not */
+            else if (cuddIsConstant(cuddE(node)) &&
+                     ! cuddIsConstant(cuddT(node))) {
+
+                Var t
+                    (f_tmpl.find_cnf_var(cuddT(node)));
+
+                /* Positive polarity (E) */
+                if (0 != cuddV(cuddE(node)))
+
+                    /* (!f |  !v |  t) */
+                    push3( f, true , v, true, t, false);
+
+                /* Negative polarity */
+                else {
+                    /* ( !f | v ) */
+                    push2( f, true, v, false);
+
+                    /* ( !f | t ) */
+                    push2( f, true, t, false);
+                }
+            }
+
+            /* General case: both T, E non const */
+            else {
+                assert (! cuddIsConstant(cuddT(node)));
+                Var t
+                    (f_tmpl.find_cnf_var(cuddT(node)));
+
+                assert (! cuddIsConstant(cuddE(node)));
+                Var e
+                    (f_tmpl.find_cnf_var(cuddE(node)));
+
+                /* !f, v, e */
+                push3( f, true, v, false, e, false);
+
+                /* !f, !v, t  */
+                push3( f, true, v, true, t, false );
+            }
+        }
+    } /* action() */
+
+private:
+    CNFTemplate& f_tmpl;
+    boost::unordered_set<DdNode*> f_seen;
+
+    DdNode* f_toplevel;
+
+    /* push 1 var clause */
+    inline void push1( Var x, bool px )
+    {
+        Lit a (mkLit( x, px ));
+
+        f_tmpl.append(a);
+        f_tmpl.close_clause();
+
+#ifdef DEBUG_CNF_LITERALS
+        DRIVEL
+            << a
+            << std::endl;
+#endif
+    }
+
+    /* push 2 vars clause */
+    inline void push2( Var x, bool px, Var y, bool py )
+    {
+        Lit a (mkLit( x, px ));
+        Lit b (mkLit( y, py ));
+
+        f_tmpl.append(a);
+        f_tmpl.append(b);
+        f_tmpl.close_clause();
+
+#ifdef DEBUG_CNF_LITERALS
+        DRIVEL
+            << a << " " << b
+            << std::endl;
+#endif
+    }
+
+    /* push 3 vars clause */
+    inline void push3( Var x, bool px, Var y, bool py, Var w, bool pw )
+    {
+        Lit a (mkLit( x, px ));
+        Lit b (mkLit( y, py ));
+        Lit c (mkLit( w, pw ));
+
+        f_tmpl.append(a);
+        f_tmpl.append(b);
+        f_tmpl.append(c);
+        f_tmpl.close_clause();
+
+#ifdef DEBUG_CNF_LITERALS
+        DRIVEL
+            << a << " " << b << " " << c
+            << std::endl;
+#endif
+    }
+};
+
+void CNFTemplate::cnf_push_polarity(const ADD& add)
+{
+    CNFBuilderPolarity worker
+        (*this);
+
+    worker(add);
+
+#ifdef DEBUG_CNF_LITERALS
+    DRIVEL
+        << "------------------------------------------------------------"
+        << std::endl;
+#endif
+}
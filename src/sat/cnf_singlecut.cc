@@ -30,12 +30,9 @@
 
 class CNFBuilderSingleCut : public ADDWalker {
 public:
-    CNFBuilderSingleCut(Engine& sat, step_t time,
-                        group_t group = MAINGROUP)
-        : f_sat(sat)
+    CNFBuilderSingleCut(CNFTemplate& tmpl)
+        : f_tmpl(tmpl)
         , f_toplevel(NULL)
-        , f_time(time)
-        , f_group(group)
     {}
 
     ~CNFBuilderSingleCut()
@@ -55,7 +52,7 @@ public:
         assert (NULL != f_toplevel);
 
         /* assert toplevel fun */
-        push1( f_sat.find_cnf_var(f_toplevel, f_time), false);
+        push1( f_tmpl.find_cnf_var(f_toplevel), false);
     }
 
     inline bool is_toplevel() const
@@ -91,9 +88,9 @@ public:
             mark(node);
 
             Var f
-                (f_sat.find_cnf_var(node, f_time));
+                (f_tmpl.find_cnf_var(node));
             Var v
-                (f_sat.find_dd_var(node, f_time));
+                (f_tmpl.find_dd_var(node));
 
             /* both T, E are consts */
             if (cuddIsConstant(cuddT(node)) &&
@@ -125,7 +122,7 @@ public:
                      ! cuddIsConstant(cuddE(node))) {
 
                 Var e
-                    (f_sat.find_cnf_var(cuddE(node), f_time));
+                    (f_tmpl.find_cnf_var(cuddE(node)));
 
                 /* Positive polarity (T) */
                 if (0 != cuddV(cuddT(node))) {
@@ -158,7 +155,7 @@ public:
                      ! cuddIsConstant(cuddT(node))) {
 
                 Var t
-                    (f_sat.find_cnf_var(cuddT(node), f_time));
+                    (f_tmpl.find_cnf_var(cuddT(node)));
 
                 /* Positive polarity (E) */
                 if (0 != cuddV(cuddE(node))) {
@@ -190,11 +187,11 @@ public:
             else {
                 assert (! cuddIsConstant(cuddT(node)));
                 Var t
-                    (f_sat.find_cnf_var(cuddT(node), f_time));
+                    (f_tmpl.find_cnf_var(cuddT(node)));
 
                 assert (! cuddIsConstant(cuddE(node)));
                 Var e
-                    (f_sat.find_cnf_var(cuddE(node), f_time));
+                    (f_tmpl.find_cnf_var(cuddE(node)));
 
                 /* !f, v, e */
                 push3( f, true, v, false, e, false);
@@ -212,79 +209,67 @@ public:
     } /* action() */
 
 private:
-    Engine& f_sat;
+    CNFTemplate& f_tmpl;
     boost::unordered_set<DdNode*> f_seen;
 
     DdNode* f_toplevel;
 
-    step_t f_time;
-    group_t f_group;
-
     /* push 1 var clause */
     inline void push1( Var x, bool px )
     {
-        vec<Lit> ps;
-
-        if (MAINGROUP != f_group)
-            ps.push( mkLit( f_group, true));
+        Lit a (mkLit( x, px ));
 
-        ps.push( mkLit( x, px ));
+        f_tmpl.append(a);
+        f_tmpl.close_clause();
 
 #ifdef DEBUG_CNF_LITERALS
         DRIVEL
-            << ps
+            << a
             << std::endl;
 #endif
-
-        f_sat.add_clause(ps);
     }
 
     /* push 2 vars clause */
     inline void push2( Var x, bool px, Var y, bool py )
     {
-        vec<Lit> ps;
-
-        if (MAINGROUP != f_group)
-            ps.push( mkLit( f_group, true));
+        Lit a (mkLit( x, px ));
+        Lit b (mkLit( y, py ));
 
-        ps.push( mkLit( x, px ));
-        ps.push( mkLit( y, py ));
+        f_tmpl.append(a);
+        f_tmpl.append(b);
+        f_tmpl.close_clause();
 
 #ifdef DEBUG_CNF_LITERALS
         DRIVEL
-            << ps
+            << a << " " << b
             << std::endl;
 #endif
-
-        f_sat.add_clause(ps);
     }
 
     /* push 3 vars clause */
     inline void push3( Var x, bool px, Var y, bool py, Var w, bool pw )
     {
-        vec<Lit> ps;
-
-        if (MAINGROUP != f_group)
-            ps.push( mkLit( f_group, true));
+        Lit a (mkLit( x, px ));
+        Lit b (mkLit( y, py ));
+        Lit c (mkLit( w, pw ));
 
-        ps.push( mkLit( x, px ));
-        ps.push( mkLit( y, py ));
-        ps.push( mkLit( w, pw ));
+        f_tmpl.append(a);
+        f_tmpl.append(b);
+        f_tmpl.append(c);
+        f_tmpl.close_clause();
 
 #ifdef DEBUG_CNF_LITERALS
         DRIVEL
-            << ps
+            << a << " " << b << " " << c
             << std::endl;
 #endif
-
-        f_sat.add_clause(ps);
     }
 };
 
-void Engine::cnf_push_single_cut(ADD add, step_t time, const group_t group)
+void CNFTemplate::cnf_push_single_cut(const ADD& add)
 {
     CNFBuilderSingleCut worker
-        (*this, time, group);
+        (*this);
 
     worker(add);
 
@@ -23,43 +23,117 @@
 
 #include <sat.hh>
 #include <cstdlib>
+#include <algorithm>
 
 /**
  * @brief SAT instancte ctor
  */
-Engine::Engine(const char* instance_name)
+Engine::Engine(const std::string& instance_name, const EngineConfig& config)
     : f_instance_name(instance_name)
+    , f_owner(config.owner)
     , f_enc_mgr(EncodingMgr::INSTANCE())
+    , f_last_push_clauses(0)
+    , f_last_push_literals(0)
+    , f_clauses(0)
+    , f_literals(0)
+    , f_exchange(NULL)
+    , f_exported(0)
+    , f_imported(0)
+    , f_backend(make_sat_backend(config.backend.empty()
+                                 ? sat_backend() : config.backend))
 {
     const void* instance
         (this);
+    const char* backend_name
+        (f_backend->name());
 
-    /* Default configuration */
-    f_solver.random_var_freq = .1;
-    // f_solver.ccmin_mode = 0;
-    // f_solver.phase_saving = 0;
-    f_solver.rnd_init_act = true;
-    f_solver.garbage_frac = 0.50;
+    /* MAINGROUP (=0) is final: it is always enabled. */
+    Var main_group
+        (new_sat_var(true));
+    assert(MAINGROUP == main_group);
 
-    /* MAINGROUP (=0) is already there. */
-    f_groups.push(new_sat_var());
+    vec<Lit> ps;
+    ps.push( mkLit( main_group, false));
+    f_backend->add_clause(ps);
+
+    if (config.seed)
+        f_backend->set_seed(config.seed);
+
+    if (! config.exchange.empty()) {
+        f_exchange = EngineMgr::INSTANCE()
+            .exchange(f_owner, config.exchange);
+
+        f_exchange->subscribe(this);
+        f_backend->collect_learnts(f_exchange->max_size());
+    }
 
     EngineMgr::INSTANCE()
         .register_instance(this);
 
     DEBUG
-        << "Initialized Engine instance @"
+        << "Initialized Engine instance `"
+        << f_instance_name
+        << "` @"
         << instance
+        << " ("
+        << backend_name
+        << " backend, seed "
+        << config.seed
+        << ")"
         << std::endl;
 }
 
 Engine::~Engine()
 {
+    if (f_exchange)
+        f_exchange->unsubscribe(this);
+
     EngineMgr::INSTANCE()
         .unregister_instance(this);
+
+    delete f_backend;
+}
+
+void Engine::finalize_last_group()
+{
+    assert(0 < f_groups.size());
+    finalize_group(f_groups.last());
+}
+
+void Engine::finalize_group(group_t group)
+{
+    Var var
+        (abs(group));
+    bool enabled
+        (0 < group);
+
+    /* remove group from the active ones, order is preserved */
+    int i
+        (0);
+    while (i < f_groups.size() && var != abs(f_groups[i]))
+        ++ i;
+
+    assert(i < f_groups.size());
+    for (++ i; i < f_groups.size(); ++ i)
+        f_groups[i - 1] = f_groups[i];
+    f_groups.pop();
+
+    /* assert the group with given polarity, if disabled the solver
+       will eventually get rid of all of its clauses. */
+    vec<Lit> ps;
+    ps.push( mkLit( var, ! enabled));
+    f_backend->add_clause(ps);
+
+    DEBUG
+        << "Finalized group var "
+        << var
+        << ", enabled = "
+        << enabled
+        << std::endl;
 }
 
-status_t Engine::sat_solve_groups(const Groups& groups)
+status_t Engine::sat_solve_groups(const Groups& groups,
+                                  const vec<Lit>& extra)
 {
     vec<Lit> assumptions;
 
@@ -74,20 +148,20 @@ status_t Engine::sat_solve_groups(const Groups& groups)
         assumptions.push( mkLit( abs(grp), grp < 0));
     }
 
+    for (int i = 0; i < extra.size(); ++ i)
+        assumptions.push(extra[i]);
+
+    if (f_exchange)
+        import_learnts();
+
     DEBUG
         << "Solving ..."
         << std::endl;
 
-    Minisat::lbool status
-        (f_solver.solveLimited(assumptions));
+    f_status = f_backend->solve(assumptions);
 
-    if (status == l_True)
-        f_status = STATUS_SAT;
-    else if (status == l_False)
-        f_status = STATUS_UNSAT;
-    else if (status == l_Undef)
-        f_status = STATUS_UNKNOWN;
-    else assert(false); /* unreachable */
+    if (f_exchange)
+        export_learnts();
 
     clock_t elapsed = clock() - t0;
     double secs = (double) elapsed / (double) CLOCKS_PER_SEC;
@@ -102,84 +176,166 @@ status_t Engine::sat_solve_groups(const Groups& groups)
     return f_status;
 }
 
-void Engine::push(CompilationUnit cu, step_t time, group_t group)
+void Engine::export_learnts()
 {
-    /**
-     * 1. Pushing DDs
-     */
-    {
-        const DDVector& dv
-            (cu.dds());
-
-        DDVector::const_iterator i;
-        for (i = dv.begin(); dv.end() != i; ++ i) {
-            cnf_push_single_cut( *i, time, group );
-            // cnf_push_no_cut( *i, time, group );
-        }
-    }
+    const unsigned max_lbd
+        (f_exchange->max_lbd());
+
+    f_learnts_buf.clear();
+    f_backend->learnts(f_learnts_buf);
 
-    /**
-     * 2. Pushing CNF for inlined operators
-     */
-    {
-        const InlinedOperatorDescriptors& inlined_operator_descriptors
-            (cu.inlined_operator_descriptors());
+    SharedClauses shared;
+    std::vector<step_t> frames;
 
-        InlinedOperatorDescriptors::const_iterator i;
-        for (i = inlined_operator_descriptors.begin();
-             inlined_operator_descriptors.end() != i; ++ i) {
+    for (LitsVector::iterator i = f_learnts_buf.begin();
+         f_learnts_buf.end() != i; ++ i) {
+        const Lits& lits
+            (*i);
 
-            CNFOperatorInliner worker
-                (*this, time, group);
+        /* only clauses over model bits are shared. The LBD of a
+           shared clause is measured in time frames, backends do not
+           report decision levels. */
+        SharedClause clause;
+        frames.clear();
 
-            worker(*i);
+        Lits::const_iterator j;
+        for (j = lits.begin(); lits.end() != j; ++ j) {
+            const TCBI* tcbi
+                (f_tcbi_registry.find_tcbi(Minisat::var(*j)));
+
+            if (! tcbi)
+                break;
+
+            step_t time
+                (tcbi->absolute_time());
+
+            if (frames.end() == std::find(frames.begin(), frames.end(), time)) {
+                if (max_lbd == frames.size())
+                    break;
+
+                frames.push_back(time);
+            }
+
+            clause.push_back(SharedLit(*tcbi, Minisat::sign(*j)));
         }
+
+        if (lits.end() == j)
+            shared.push_back(SharedClause_ptr(new SharedClause(clause)));
     }
 
-    /**
-     * 3. Pushing ITE MUXes
-     */
-    {
-        const Expr2BinarySelectionDescriptorsMap& binary_selection_descriptors_map
-            (cu.binary_selection_descriptors_map());
+    f_exchange->publish(this, shared);
+    f_exported += shared.size();
+}
 
-        Expr2BinarySelectionDescriptorsMap::const_iterator mmi
-            (binary_selection_descriptors_map.begin());
+void Engine::import_learnts()
+{
+    SharedClauses shared;
+    f_exchange->fetch(this, shared);
 
-        while (binary_selection_descriptors_map.end() != mmi) {
-            Expr_ptr toplevel
-                (mmi -> first);
-            BinarySelectionDescriptors descriptors
-                (mmi -> second);
+    for (SharedClauses::const_iterator i = shared.begin();
+         shared.end() != i; ++ i) {
+        const SharedClause& clause
+            (**i);
 
-            BinarySelectionDescriptors::const_iterator i;
-            for (i = descriptors.begin(); descriptors.end() != i; ++ i) {
+        /* bits that are not in this instance yet are booked now */
+        f_clause_buf.clear();
+        for (SharedClause::const_iterator j = clause.begin();
+             clause.end() != j; ++ j)
+            f_clause_buf.push( mkLit( tcbi_to_var(j->tcbi), j->sign));
 
-                CNFBinarySelectionInliner worker
-                    (*this, time, group);
+        f_backend->add_clause(f_clause_buf);
+    }
 
-                worker(*i);
-            }
+    f_imported += shared.size();
+}
+
+void Engine::push(const CompilationUnit& cu, step_t time, group_t group)
+{
+    push( CNFTemplate::require(cu), time, group);
+}
 
-            ++ mmi ;
+void Engine::push(const CNFTemplate& tmpl, step_t time, group_t group)
+{
+    f_last_push_clauses = 0;
+    f_last_push_literals = 0;
+
+    /* bind template vars in this time frame: model bits are looked up
+       once per bit, aux vars are fresh for each instantiation. */
+    const unsigned nvars
+        (tmpl.nvars());
+
+    f_template_vars.resize(nvars);
+    for (unsigned i = 0; i < nvars; ++ i) {
+        int binding
+            (tmpl.binding(i));
+
+        if (0 <= binding)
+            f_template_vars[i] = find_dd_var(binding, time);
+        else if (CNF_BINDING_AUX == binding)
+            f_template_vars[i] = new_sat_var();
+        else {
+            /* MAINGROUP var is always true */
+            assert(CNF_BINDING_TRUE == binding);
+            f_template_vars[i] = MAINGROUP;
         }
     }
 
-    /**
-     * 4. Pushing ARRAY MUXes
-     */
-    {
-        const MultiwaySelectionDescriptors& muxes
-            (cu.array_mux_descriptors());
-        MultiwaySelectionDescriptors::const_iterator i;
-        for (i = muxes.begin(); muxes.end() != i; ++ i) {
+    /* clauses are copied literal by literal into the arena, renaming
+       vars, and then flushed to the solver in a single batch. */
+    for (unsigned i = 0; i < tmpl.nclauses(); ++ i) {
+        if (MAINGROUP != group)
+            append_lit( mkLit( group, true));
 
-            CNFMultiwaySelectionInliner worker
-                (*this, time, group);
+        for (const Lit* lp = tmpl.begin(i); tmpl.end(i) != lp; ++ lp)
+            append_lit( mkLit( f_template_vars[ Minisat::var(*lp) ],
+                               Minisat::sign(*lp)));
 
-            worker(*i);
-        }
+        close_clause();
+    }
+
+    flush_clauses();
+    f_cnf_stats.add(tmpl.stats());
+
+    DEBUG
+        << "Pushed "
+        << f_last_push_clauses << " clauses, "
+        << f_last_push_literals << " literals @"
+        << time
+        << std::endl;
+}
+
+void Engine::flush_clauses()
+{
+    unsigned nclauses
+        (f_arena_ends.size());
+    unsigned nlits
+        (f_arena_lits.size());
+
+    int begin
+        (0);
+    for (unsigned i = 0; i < nclauses; ++ i) {
+        int end
+            (f_arena_ends[i]);
+
+        /* each clause is copied into the buffer and handed over to
+           the backend, which copies it again; the buffer storage is
+           recycled across clauses. */
+        f_clause_buf.clear();
+        for (int j = begin; j < end; ++ j)
+            f_clause_buf.push(f_arena_lits[j]);
+
+        f_backend->add_clause(f_clause_buf);
+        begin = end;
     }
+
+    f_arena_lits.clear();
+    f_arena_ends.clear();
+
+    f_last_push_clauses += nclauses;
+    f_last_push_literals += nlits;
+
+    f_clauses += nclauses;
+    f_literals += nlits;
 }
 
 Var Engine::find_dd_var(const DdNode* node, step_t time)
@@ -206,80 +362,12 @@ Var Engine::find_dd_var(int node_index, step_t time)
     return tcbi_to_var(tcbi);
 }
 
-Var Engine::find_cnf_var(const DdNode* node, step_t time)
-{
-    Var res;
-
-    assert (NULL != node);
-    TimedDD timed_node
-        (const_cast<DdNode*> (node), time);
-
-    TDD2VarMap::const_iterator eye
-        (f_tdd2var_map.find( timed_node ));
-
-    if (f_tdd2var_map.end() == eye) {
-        res = new_sat_var();
-
-        /* Insert into tdd2var map */
-        f_tdd2var_map.insert( std::pair<TimedDD, Var>
-                              (timed_node, res));
-
-        DEBUG
-            << "Created cnf var "
-            << res
-            << " for DD node "
-            << node
-            << std::endl;
-    }
-    else {
-        res = (*eye).second;
-    }
-    return res;
-}
-
-void Engine::clear_cnf_map()
-{
-    f_rewrite_map.clear();
-}
-
-Var Engine::rewrite_cnf_var(Var v, step_t time)
-{
-    Var res;
-
-    TimedVar timed_var (v, time);
-    RewriteMap::const_iterator eye = \
-        f_rewrite_map.find( timed_var );
-
-    if (f_rewrite_map.end() == eye) {
-        res = new_sat_var();
-
-        /* Insert into tvv2var map */
-        f_rewrite_map.insert( std::pair<TimedVar, Var>
-                              (timed_var, res));
-
-        DEBUG
-            << "Rewrote microcode cnf var "
-            << v << "@" << time
-            << " as "
-            << res
-            << std::endl;
-    }
-    else {
-        res = (*eye).second;
-    }
-    return res;
-}
-
 Var Engine::tcbi_to_var(const TCBI& tcbi)
 {
-    Var var;
-    const TCBI2VarMap::iterator eye
-        (f_tcbi2var_map.find(tcbi));
+    Var var
+        (f_tcbi_registry.find(tcbi));
 
-    if (f_tcbi2var_map.end() != eye) {
-        var = eye->second;
-    }
-    else {
+    if (VAR_UNDEF == var) {
         /* generate a new var and book it. Newly created var is not eliminable. */
         var = new_sat_var(true);
 
@@ -288,21 +376,13 @@ Var Engine::tcbi_to_var(const TCBI& tcbi)
             << " for " << tcbi
             << std::endl;
 
-        f_tcbi2var_map.insert( std::pair<TCBI, Var>(tcbi, var));
-        f_var2tcbi_map.insert( std::pair<Var, TCBI>(var, tcbi));
+        f_tcbi_registry.insert(tcbi, var);
     }
 
     return var;
 }
 
-TCBI& Engine::var_to_tcbi(Var var)
+const TCBI& Engine::var_to_tcbi(Var var)
 {
-    const Var2TCBIMap::iterator eye
-        (f_var2tcbi_map.find(var));
-
-    /* TCBI *has* to be there already. */
-    assert (f_var2tcbi_map.end() != eye);
-
-    return eye->second;
+    return f_tcbi_registry.tcbi(var);
 }
-
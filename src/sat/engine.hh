@@ -33,6 +33,34 @@
 #include <model/compiler/unit.hh>
 
 #include <sat/typedefs.hh>
+#include <sat/registry.hh>
+#include <sat/template.hh>
+#include <sat/backend.hh>
+#include <sat/exchange.hh>
+
+/* Engine configuration, cfr. Engine ctor */
+struct EngineConfig {
+    /* SAT backend, empty for the one selected in the environment
+       (cfr. `set sat_backend`) */
+    std::string backend;
+
+    /* solver seed, 0 for the backend default */
+    unsigned seed;
+
+    /* cancellation scope, cfr. EngineMgr::interrupt(owner) */
+    const void* owner;
+
+    /* learned clauses exchange channel in the owner's scope, empty
+       for none (cfr. EngineMgr::exchange) */
+    std::string exchange;
+
+    EngineConfig()
+        : backend()
+        , seed(0)
+        , owner(NULL)
+        , exchange()
+    {}
+};
 
 class Engine {
 public:
@@ -61,10 +89,30 @@ public:
     { f_groups.last() *= -1; }
 
     /**
-     * @brief Returns the complete set of defined SAT groups.
+     * @brief Declares the last group as final.
+     *
+     * A final group can no longer be inverted. Its current polarity is
+     * asserted once and for all as a unit clause, so that the solver
+     * can simplify away the clauses of a disabled group, and the group
+     * is no longer passed to the solver as an assumption.
+     */
+    void finalize_last_group();
+
+    /**
+     * @brief Declares group as final.
+     *
+     * Same as finalize_last_group(), for any group that is not final
+     * yet. The polarity asserted is the sign of group, regardless of
+     * the current one: use -group to disable it for good.
+     */
+    void finalize_group(group_t group);
+
+    /**
+     * @brief Returns the set of SAT groups that are not final yet.
      *
      * A positive value of the i-th element of this array enables the
-     * i-th group, whereas a negative value disables it.
+     * i-th group, whereas a negative value disables it. MAINGROUP is
+     * final and it is not part of this set.
      */
     inline Groups& groups()
     { return f_groups; }
@@ -72,29 +120,60 @@ public:
     /**
      * @brief add a formula to the SAT problem instance.
      */
-    void push(CompilationUnit cu, step_t time, group_t group = MAINGROUP);
+    void push(const CompilationUnit& cu, step_t time, group_t group = MAINGROUP);
+
+    /**
+     * @brief instantiate a CNF template at the given time frame.
+     */
+    void push(const CNFTemplate& tmpl, step_t time, group_t group = MAINGROUP);
 
     /**
-     * @brief Invoke Minisat
+     * @brief Invoke the SAT solver
      */
     inline status_t solve()
-    { return sat_solve_groups(f_groups); }
+    { return sat_solve_groups(f_groups, vec<Lit>()); }
 
     /**
-     * @brief Interrupt Minisat
+     * @brief Invoke the SAT solver, under additional assumptions
      */
-    inline void interrupt()
-    { f_solver.interrupt(); }
+    inline status_t solve(const vec<Lit>& assumptions)
+    { return sat_solve_groups(f_groups, assumptions); }
 
     /**
-     * @brief Configure Minisat
+     * @brief Additional assumptions used to prove the last UNSAT
+     * solve(assumptions), appended to out. Group vars may be reported
+     * as well.
      */
-    inline void configure(int64_t conf_budget, int64_t prop_budget)
+    inline void failed(vec<Lit>& out)
     {
-        f_solver.setConfBudget(conf_budget);
-        f_solver.setPropBudget(prop_budget);
+        assert (STATUS_UNSAT == f_status);
+        f_backend->failed(out);
     }
 
+    /**
+     * @brief Interrupt the SAT solver
+     */
+    inline void interrupt()
+    { f_backend->interrupt(); }
+
+    /**
+     * @brief Configure the SAT solver budget
+     */
+    inline void configure(int64_t conf_budget, int64_t prop_budget)
+    { f_backend->set_budget(conf_budget, prop_budget); }
+
+    /**
+     * @brief SAT backend name
+     */
+    inline const char* backend_name() const
+    { return f_backend->name(); }
+
+    /**
+     * @brief Cancellation scope, cfr. EngineMgr::interrupt(owner)
+     */
+    inline const void* owner() const
+    { return f_owner; }
+
     /**
      * @brief Last solving status
      */
@@ -102,12 +181,12 @@ public:
     { return f_status; }
 
     /**
-     * @brief Fetch variable value from Minisat model
+     * @brief Fetch variable value from the SAT model
      */
     inline int value(Var var)
     {
         assert (STATUS_SAT == f_status);
-        return 0 == Minisat::toInt(f_solver.modelValue(var));
+        return f_backend->model_value(var);
     }
 
     /**
@@ -118,7 +197,7 @@ public:
     /**
      * @brief Minisat variable -> TCBI mapping
      */
-    TCBI& var_to_tcbi(Var var);
+    const TCBI& var_to_tcbi(Var var);
 
     /**
      * @brief DD index -> UCBI mapping
@@ -137,43 +216,69 @@ public:
     Var find_dd_var(int node_index, step_t time);
 
     /**
-     * @brief Artifactory DD nodes to Minisat variable mapping
+     * @brief a new SAT variable
      */
-    Var find_cnf_var(const DdNode* node, step_t time);
+    inline Var new_sat_var(bool frozen=false) // proxy
+    {
+        Var var
+            (f_backend->new_var());
+
+        f_backend->set_frozen(var, frozen);
+
+        return var;
+    }
 
     /**
-     * @brief CNF registry for injection CNF var
+     * @brief add a CNF clause
      */
-    void clear_cnf_map();
+    inline void add_clause(vec<Lit>& ps) // proxy
+    {
+        f_last_push_clauses += 1;
+        f_last_push_literals += ps.size();
+
+        f_clauses += 1;
+        f_literals += ps.size();
+
+        f_backend->add_clause(ps);
+    }
 
     /**
-     * @brief Rewrites a CNF var
+     * @brief Clause arena: appends a literal to the current clause
      */
-    Var rewrite_cnf_var(Var var, step_t time);
+    inline void append_lit(Lit lit)
+    { f_arena_lits.push(lit); }
 
     /**
-     * @brief a new Minisat variable
+     * @brief Clause arena: closes the current clause
      */
-    inline Var new_sat_var(bool frozen=false) // proxy
-    {
-        Var var
-            (f_solver.newVar());
+    inline void close_clause()
+    { f_arena_ends.push(f_arena_lits.size()); }
 
-        f_solver.setFrozen(var, frozen);
+    /**
+     * @brief Clause arena: adds all closed clauses to the solver, in a
+     * single batch. Clause and literal counters are updated.
+     */
+    void flush_clauses();
 
-        return var;
-    }
+    /**
+     * @brief Number of clauses produced since the last push started,
+     * clauses added or flushed afterwards included
+     */
+    inline unsigned last_push_clauses() const
+    { return f_last_push_clauses; }
 
     /**
-     * @brief add a CNF clause
+     * @brief Number of literals produced since the last push started,
+     * clauses added or flushed afterwards included
      */
-    inline void add_clause(vec<Lit>& ps) // proxy
-    { f_solver.addClause_(ps); }
+    inline unsigned last_push_literals() const
+    { return f_last_push_literals; }
 
     /**
-     * @brief SAT instance ctor
+     * @brief SAT instance ctor. Throws UnsupportedSATBackend.
      */
-    Engine(const char* instance_name);
+    Engine(const std::string& instance_name,
+           const EngineConfig& config = EngineConfig());
 
     /**
      * @brief SAT instance dctor
@@ -184,22 +289,44 @@ public:
     { return f_enc_mgr; }
 
 private:
-    const char* f_instance_name;
+    std::string f_instance_name;
+    const void* f_owner;
 
     EncodingMgr& f_enc_mgr;
 
-    // CNF registry
-    TDD2VarMap f_tdd2var_map;
-    RewriteMap f_rewrite_map;
+    // template vars -> Minisat vars, reused across instantiations
+    VarVector f_template_vars;
+
+    // clause arena, storage is reused across flushes
+    vec<Lit> f_arena_lits;
+    vec<int> f_arena_ends;
+    vec<Lit> f_clause_buf;
+
+    // CNF counters
+    unsigned f_last_push_clauses;
+    unsigned f_last_push_literals;
+    unsigned long f_clauses;
+    unsigned long f_literals;
+
+    // CNFization strategies, over all pushed templates
+    CNFStats f_cnf_stats;
+
+    // learned clauses exchange, NULL if not sharing
+    ClauseExchange_ptr f_exchange;
+    unsigned long f_exported;
+    unsigned long f_imported;
+
+    // learned clauses reported by the backend, scratch
+    LitsVector f_learnts_buf;
 
     // Bidirectional time mapping
-    TCBI2VarMap f_tcbi2var_map;
-    Var2TCBIMap f_var2tcbi_map;
+    TCBIRegistry f_tcbi_registry;
 
-    // SAT solver, currently Minisat
-    SimpSolver f_solver;
+    // SAT solver, owned
+    SATBackend_ptr f_backend;
 
-    // used to partition the formula to be solved using assumptions
+    // used to partition the formula to be solved using assumptions,
+    // final groups are asserted as unit clauses instead.
     Groups f_groups;
 
     // last solve() status
@@ -235,11 +362,11 @@ private:
     // -- Low level services -----------------------------------------------
     Lit cnf_find_group_lit(group_t group, bool enabled = true);
 
-    status_t sat_solve_groups(const Groups& groups);
+    status_t sat_solve_groups(const Groups& groups,
+                              const vec<Lit>& extra);
 
-    /* CNFization algorithms */
-    void cnf_push_no_cut(ADD add, step_t time, const group_t group);
-    void cnf_push_single_cut(ADD add, step_t time, const group_t group);
+    void export_learnts();
+    void import_learnts();
 
     friend std::ostream& operator<<(std::ostream& os, const Engine& engine);
 };
@@ -62,6 +62,13 @@ void EngineMgr::register_instance(Engine_ptr engine)
         << std::endl;
 
     f_engines.insert(engine);
+
+    /* too late for this one */
+    const void* owner
+        (engine->owner());
+
+    if (owner && f_interrupted.end() != f_interrupted.find(owner))
+        engine->interrupt();
 }
 
 void EngineMgr::unregister_instance(Engine_ptr engine)
@@ -91,6 +98,79 @@ void EngineMgr::interrupt()
     }
 }
 
+void EngineMgr::interrupt(const void* owner)
+{
+    boost::mutex::scoped_lock lock { f_mutex };
+
+    assert(NULL != owner);
+    f_interrupted.insert(owner);
+
+    EngineSet::iterator esi;
+    for (esi = begin(f_engines); end(f_engines) != esi; ++ esi) {
+        Engine_ptr pe { *esi };
+        if (owner == pe -> owner())
+            pe -> interrupt();
+    }
+}
+
+ClauseExchange_ptr EngineMgr::exchange(const void* owner,
+                                       const std::string& name)
+{
+    boost::mutex::scoped_lock lock { f_mutex };
+
+    assert(NULL != owner);
+    ExchangeKey key
+        (owner, name);
+
+    ExchangeMap::const_iterator eye
+        (f_exchanges.find(key));
+
+    if (f_exchanges.end() != eye)
+        return eye->second;
+
+    ClauseExchange_ptr res
+        (new ClauseExchange(sat_share_max_size(), sat_share_max_lbd()));
+
+    f_exchanges.insert(std::pair<ExchangeKey, ClauseExchange_ptr>
+                       (key, res));
+
+    DEBUG
+        << "Created exchange channel `"
+        << name
+        << "`"
+        << std::endl;
+
+    return res;
+}
+
+void EngineMgr::release(const void* owner)
+{
+    boost::mutex::scoped_lock lock { f_mutex };
+
+    f_interrupted.erase(owner);
+
+    ExchangeMap::iterator i
+        (f_exchanges.begin());
+    while (f_exchanges.end() != i) {
+        if (owner == i->first.first) {
+            unsigned nclauses
+                (i->second->size());
+
+            DEBUG
+                << "Released exchange channel `"
+                << i->first.second
+                << "`, "
+                << nclauses
+                << " clauses shared"
+                << std::endl;
+
+            delete i->second;
+            i = f_exchanges.erase(i);
+        }
+        else ++ i;
+    }
+}
+
 void EngineMgr::dump_stats(std::ostream& os)
 {
     boost::mutex::scoped_lock lock { f_mutex };
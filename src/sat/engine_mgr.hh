@@ -24,7 +24,11 @@
 #ifndef SAT_ENGINE_MGR_H
 #define SAT_ENGINE_MGR_H
 
+#include <string>
+
 #include <sat/typedefs.hh>
+#include <sat/exchange.hh>
+
 #include <boost/thread/mutex.hpp>
 
 class EngineMgr {
@@ -35,6 +39,28 @@ public:
      */
     void interrupt();
 
+    /**
+     * @brief Signals an interrupt to all instances in the owner's
+     * cancellation scope (cfr. EngineConfig). Instances joining the
+     * scope later on are interrupted as soon as they are registered,
+     * until the scope is released.
+     */
+    void interrupt(const void* owner);
+
+    /**
+     * @brief Learned clauses exchange channel `name` in the owner's
+     * scope, created on first request with the current sharing
+     * limits. Engines joining the same channel must share a time base
+     * (cfr. ClauseExchange).
+     */
+    ClauseExchange_ptr exchange(const void* owner, const std::string& name);
+
+    /**
+     * @brief Releases a cancellation scope, along with its exchange
+     * channels. No engine in the scope may be alive.
+     */
+    void release(const void* owner);
+
     /**
      * @brief Requires a stats printout from all existing instances
      */
@@ -67,6 +93,14 @@ private: /* private interface, reserved to Engine instances. */
     static EngineMgr_ptr f_instance;
     EngineSet f_engines;
 
+    /* interrupted cancellation scopes */
+    boost::unordered_set<const void*> f_interrupted;
+
+    /* exchange channels, by (owner, name) */
+    typedef std::pair<const void*, std::string> ExchangeKey;
+    typedef boost::unordered_map<ExchangeKey, ClauseExchange_ptr> ExchangeMap;
+    ExchangeMap f_exchanges;
+
     boost::mutex f_mutex;
 };
 
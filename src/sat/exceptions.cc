@@ -23,6 +23,7 @@
 
 #include <sat/exceptions.hh>
 #include <sat/inlining.hh>
+#include <sat/backend.hh>
 
 #include <sstream>
 #include <string>
@@ -44,3 +45,21 @@ InlinedOperatorLoaderException::InlinedOperatorLoaderException(const InlinedOper
                       format_loader_exception(ios))
 {}
 
+
+std::string format_unsupported_sat_backend(const std::string& name)
+{
+    std::ostringstream oss;
+
+    oss
+        << "unsupported SAT backend `"
+        << name
+        << "`, available backends are: "
+        << sat_backends() ;
+
+    return oss.str();
+}
+
+UnsupportedSATBackend::UnsupportedSATBackend(const std::string& name)
+    : EngineException("UnsupportedSATBackend",
+                      format_unsupported_sat_backend(name))
+{}
@@ -43,4 +43,9 @@ public:
     InlinedOperatorLoaderException(const InlinedOperatorSignature& ios);
 };
 
+class UnsupportedSATBackend : public EngineException {
+public:
+    UnsupportedSATBackend(const std::string& name);
+};
+
 #endif /* SAT_EXCEPTIONS_H */
@@ -0,0 +1,136 @@
+/**
+ * @file sat/exchange.cc
+ * @brief SAT interface, learned clauses exchange implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/exchange.hh>
+
+#include <env/environment.hh>
+
+static const char* SAT_SHARE_MAX_SIZE_IDENTIFIER = "sat_share_max_size";
+static const char* SAT_SHARE_MAX_LBD_IDENTIFIER = "sat_share_max_lbd";
+
+static const unsigned DEFAULT_SAT_SHARE_MAX_SIZE (8);
+static const unsigned DEFAULT_SAT_SHARE_MAX_LBD (2);
+
+unsigned sat_share_max_size()
+{
+    return env_unsigned(SAT_SHARE_MAX_SIZE_IDENTIFIER, 1,
+                        DEFAULT_SAT_SHARE_MAX_SIZE);
+}
+
+unsigned sat_share_max_lbd()
+{
+    return env_unsigned(SAT_SHARE_MAX_LBD_IDENTIFIER, 1,
+                        DEFAULT_SAT_SHARE_MAX_LBD);
+}
+
+ClauseExchange::ClauseExchange(unsigned max_size, unsigned max_lbd)
+    : f_max_size(max_size)
+    , f_max_lbd(max_lbd)
+    , f_base(0)
+{
+    assert(0 < max_size && 0 < max_lbd);
+}
+
+void ClauseExchange::publish(const void* source,
+                             const SharedClauses& clauses)
+{
+    if (clauses.empty())
+        return;
+
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    f_sources.insert(f_sources.end(), clauses.size(), source);
+    f_clauses.insert(f_clauses.end(), clauses.begin(), clauses.end());
+}
+
+void ClauseExchange::subscribe(const void* reader)
+{
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    assert(f_cursors.end() == f_cursors.find(reader));
+    f_cursors.insert(std::pair<const void*, unsigned>(reader, f_base));
+}
+
+void ClauseExchange::unsubscribe(const void* reader)
+{
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    f_cursors.erase(reader);
+    trim();
+}
+
+void ClauseExchange::fetch(const void* reader, SharedClauses& out)
+{
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    ReaderCursors::iterator eye
+        (f_cursors.find(reader));
+    assert(f_cursors.end() != eye);
+
+    unsigned& cursor
+        (eye->second);
+
+    assert(f_base <= cursor && cursor <= f_base + f_clauses.size());
+    for (; cursor < f_base + f_clauses.size(); ++ cursor)
+        if (reader != f_sources[cursor - f_base])
+            out.push_back(f_clauses[cursor - f_base]);
+
+    trim();
+}
+
+unsigned ClauseExchange::size()
+{
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    return f_base + f_clauses.size();
+}
+
+unsigned ClauseExchange::retained()
+{
+    boost::mutex::scoped_lock lock
+        (f_mutex);
+
+    return f_clauses.size();
+}
+
+/* drops the clauses all readers have fetched, with no readers the
+   whole log goes. Lock must be held. */
+void ClauseExchange::trim()
+{
+    unsigned mark
+        (f_base + f_clauses.size());
+
+    for (ReaderCursors::const_iterator i = f_cursors.begin();
+         f_cursors.end() != i; ++ i)
+        if (i->second < mark)
+            mark = i->second;
+
+    f_sources.erase(f_sources.begin(), f_sources.begin() + (mark - f_base));
+    f_clauses.erase(f_clauses.begin(), f_clauses.begin() + (mark - f_base));
+    f_base = mark;
+}
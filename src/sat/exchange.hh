@@ -0,0 +1,140 @@
+/**
+ * @file sat/exchange.hh
+ * @brief SAT interface, learned clauses exchange declarations.
+ *
+ * A ClauseExchange is a channel through which concurrent engines
+ * share short learned clauses. Shared clauses are expressed in terms
+ * of model bits (TCBIs), so that each engine can translate them into
+ * its own variables. Clauses over CNF or group vars are never shared.
+ *
+ * Sharing a clause is sound only among engines whose formulas agree
+ * on all the time frames the clause mentions, i.e. engines unrolling
+ * the same model, with the same constraints, in the same time base
+ * (cfr. EngineMgr::exchange).
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_EXCHANGE_H
+#define SAT_EXCHANGE_H
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <sat/typedefs.hh>
+
+/* A literal of a shared clause */
+struct SharedLit {
+    TCBI tcbi;
+    bool sign;
+
+    SharedLit(const TCBI& tcbi_, bool sign_)
+        : tcbi(tcbi_)
+        , sign(sign_)
+    {}
+};
+
+typedef std::vector<SharedLit> SharedClause;
+
+/* shared clauses are immutable once published */
+typedef boost::shared_ptr<const SharedClause> SharedClause_ptr;
+typedef std::vector<SharedClause_ptr> SharedClauses;
+
+typedef class ClauseExchange* ClauseExchange_ptr;
+
+class ClauseExchange {
+public:
+    /**
+     * @brief A new channel. Engines export learned clauses of at most
+     * max_size literals, spanning at most max_lbd time frames.
+     */
+    ClauseExchange(unsigned max_size, unsigned max_lbd);
+
+    inline unsigned max_size() const
+    { return f_max_size; }
+
+    inline unsigned max_lbd() const
+    { return f_max_lbd; }
+
+    /**
+     * @brief Appends clauses to the channel, on behalf of source.
+     */
+    void publish(const void* source, const SharedClauses& clauses);
+
+    /**
+     * @brief Registers reader, its first fetch() starts from the
+     * oldest clause still in the channel. Clauses are dropped once
+     * all the registered readers have fetched them.
+     */
+    void subscribe(const void* reader);
+
+    /**
+     * @brief Unregisters reader, which no longer holds clauses back.
+     */
+    void unsubscribe(const void* reader);
+
+    /**
+     * @brief Appends to out the clauses published by engines other
+     * than reader since its previous fetch. reader must be registered.
+     *
+     * Only clause pointers are copied while holding the channel lock,
+     * engines exchange clauses only in between solve() calls.
+     */
+    void fetch(const void* reader, SharedClauses& out);
+
+    /**
+     * @brief Number of clauses published so far
+     */
+    unsigned size();
+
+    /**
+     * @brief Number of clauses not yet fetched by all readers
+     */
+    unsigned retained();
+
+private:
+    unsigned f_max_size;
+    unsigned f_max_lbd;
+
+    /* log of (source, clause), trimmed of the clauses every reader
+       has fetched already. f_base is the position of its first
+       entry, since the channel was created. */
+    std::deque<const void*> f_sources;
+    std::deque<SharedClause_ptr> f_clauses;
+    unsigned f_base;
+
+    /* readers positions, cfr. f_base */
+    typedef std::map<const void*, unsigned> ReaderCursors;
+    ReaderCursors f_cursors;
+
+    void trim();
+
+    boost::mutex f_mutex;
+};
+
+/* Clause sharing limits, from the environment (cfr. `set
+   sat_share_max_size` and `set sat_share_max_lbd`) */
+unsigned sat_share_max_size();
+unsigned sat_share_max_lbd();
+
+#endif /* SAT_EXCHANGE_H */
@@ -30,7 +30,7 @@
 #include <sat/typedefs.hh>
 #include <sat/inlining.hh>
 #include <sat/exceptions.hh>
-#include <sat/engine.hh>
+#include <sat/template.hh>
 
 #include <dd/dd_walker.hh>
 
@@ -277,21 +277,17 @@ void CNFOperatorInliner::inject(const InlinedOperatorDescriptor& md,
         (ios_width(md.ios()));
 
     /* keep each injection in a separate cnf space */
-    f_sat.clear_cnf_map();
+    f_tmpl.clear_cnf_map();
 
     for (LitsVector::const_iterator i = clauses.begin(); clauses.end() != i; ++ i) {
 
         const Lits& clause
             (*i);
 
-        Minisat::vec<Lit> ps;
-        if (MAINGROUP != f_group)
-            ps.push( mkLit( f_group, true));
-
         /* for each literal in clause, determine whether associated var belongs
            to z, x, y or is a cnf var. For each group in (z, x, y) fetch
-           appropriate DD var from the registry; cnf vars gets rewritten into
-           new sat vars. Remark: rewritten cnf vars must be kept distinct among
+           appropriate template var; cnf vars gets rewritten into new
+           template vars. Remark: rewritten cnf vars must be kept distinct among
            distinct injections. */
         for (Lits::const_iterator j = clause.begin(); clause.end() != j; ++ j)  {
 
@@ -324,15 +320,15 @@ void CNFOperatorInliner::inject(const InlinedOperatorDescriptor& md,
                     node = z[ width - ndx - 1].getNode();
 
                 if (! Cudd_IsConstant(node)) {
-                    tgt_var = f_sat.find_dd_var(node, f_time);
-                    ps.push( mkLit( tgt_var, lit_sign));
+                    tgt_var = f_tmpl.find_dd_var(node);
+                    f_tmpl.append( mkLit( tgt_var, lit_sign));
                 }
                 else {
                     value_t value
                         (cuddV(node));
 
                     assert( value < 2); // 0 or 1
-                    ps.push( mkLit( alpha, value ? lit_sign : ! lit_sign));
+                    f_tmpl.append( mkLit( alpha, value ? lit_sign : ! lit_sign));
                 }
             }
 
@@ -347,15 +343,15 @@ void CNFOperatorInliner::inject(const InlinedOperatorDescriptor& md,
                     (x[ width - ndx - 1].getNode());
 
                 if (! Cudd_IsConstant(node)) {
-                    tgt_var = f_sat.find_dd_var(node, f_time);
-                    ps.push( mkLit( tgt_var, lit_sign));
+                    tgt_var = f_tmpl.find_dd_var(node);
+                    f_tmpl.append( mkLit( tgt_var, lit_sign));
                 }
                 else {
                     value_t value
                         (cuddV(node));
 
                     assert( value < 2); // 0 or 1
-                    ps.push( mkLit( alpha, value ? lit_sign : ! lit_sign));
+                    f_tmpl.append( mkLit( alpha, value ? lit_sign : ! lit_sign));
                 }
             }
 
@@ -370,15 +366,15 @@ void CNFOperatorInliner::inject(const InlinedOperatorDescriptor& md,
                     (y[ width - ndx - 1].getNode());
 
                 if (! Cudd_IsConstant(node)) {
-                    tgt_var = f_sat.find_dd_var(node, f_time);
-                    ps.push( mkLit( tgt_var, lit_sign));
+                    tgt_var = f_tmpl.find_dd_var(node);
+                    f_tmpl.append( mkLit( tgt_var, lit_sign));
                 }
                 else {
                     value_t value
                         (cuddV(node));
 
                     assert( value < 2); // 0 or 1
-                    ps.push( mkLit( alpha, value
+                    f_tmpl.append( mkLit( alpha, value
                                     ? lit_sign :
                                     ! lit_sign));
                 }
@@ -391,13 +387,13 @@ void CNFOperatorInliner::inject(const InlinedOperatorDescriptor& md,
 
                 assert(0 <= ndx /* && ndx < width */);
 
-                tgt_var = f_sat.rewrite_cnf_var(ndx, f_time);
-                ps.push( mkLit( tgt_var, lit_sign));
+                tgt_var = f_tmpl.rewrite_cnf_var(ndx);
+                f_tmpl.append( mkLit( tgt_var, lit_sign));
             }
 
         } /* for (j = clause...) */
 
-        f_sat.add_clause(ps);
+        f_tmpl.close_clause();
     } /* foreach clause ... */
 
 } /* CNFOperatorInliner::inject */
@@ -424,29 +420,23 @@ void CNFBinarySelectionInliner::inject(const BinarySelectionDescriptor& md)
 
     /* allocate a fresh variable for ITE condition */
     Var act
-        (f_sat.find_dd_var( aux.getNode(), f_time));
+        (f_tmpl.find_dd_var( aux.getNode()));
 
     /* ! a, Zi <-> Xi for all i */
     for (unsigned pol = 0; pol < 2; ++ pol) {
 
         for (unsigned i = 0; i < md.width(); ++ i) {
 
-            Minisat::vec<Lit> ps;
-
-            if (MAINGROUP != f_group)
-                ps.push( mkLit( f_group, true));
-
-            ps.push( mkLit( act, true));
-            ps.push( mkLit( f_sat.find_dd_var( z[i].getNode(),
-                                               f_time), ! pol));
+            f_tmpl.append( mkLit( act, true));
+            f_tmpl.append( mkLit( f_tmpl.find_dd_var( z[i].getNode()), ! pol));
             DdNode* xnode
                 (x[i].getNode());
 
-            ps.push( Cudd_IsConstant(xnode)
-                     ? mkLit( alpha, Cudd_V(xnode) ? pol : ! pol)
-                     : mkLit( f_sat.find_dd_var( x[i].getNode(), f_time), pol));
+            f_tmpl.append( Cudd_IsConstant(xnode)
+                           ? mkLit( alpha, Cudd_V(xnode) ? pol : ! pol)
+                           : mkLit( f_tmpl.find_dd_var( x[i].getNode()), pol));
 
-            f_sat.add_clause( ps );
+            f_tmpl.close_clause();
         }
     }
 
@@ -454,22 +444,16 @@ void CNFBinarySelectionInliner::inject(const BinarySelectionDescriptor& md)
     for (unsigned pol = 0; pol < 2; ++ pol) {
 
         for (unsigned i = 0; i < md.width(); ++ i) {
-            Minisat::vec<Lit> ps;
-
-            if (MAINGROUP != f_group)
-                ps.push( mkLit( f_group, true));
-
-            ps.push( mkLit( act, false));
-            ps.push( mkLit( f_sat.find_dd_var( z[i].getNode(),
-                                               f_time), ! pol));
+            f_tmpl.append( mkLit( act, false));
+            f_tmpl.append( mkLit( f_tmpl.find_dd_var( z[i].getNode()), ! pol));
             DdNode* ynode
                 (y[i].getNode());
 
-            ps.push(Cudd_IsConstant(ynode)
-                    ? mkLit( alpha, Cudd_V(ynode) ? pol : ! pol )
-                    : mkLit( f_sat.find_dd_var( y[i].getNode(), f_time), pol));
+            f_tmpl.append( Cudd_IsConstant(ynode)
+                           ? mkLit( alpha, Cudd_V(ynode) ? pol : ! pol )
+                           : mkLit( f_tmpl.find_dd_var( y[i].getNode()), pol));
 
-            f_sat.add_clause( ps );
+            f_tmpl.close_clause();
         }
     }
 }
@@ -500,7 +484,7 @@ void CNFMultiwaySelectionInliner::inject(const MultiwaySelectionDescriptor& md)
 
         /* allocate a fresh variable for ITE condition */
         Var act
-            (f_sat.find_dd_var((*ai).getNode(), f_time));
+            (f_tmpl.find_dd_var((*ai).getNode()));
 
         /* ! a, Zi <-> Xi for all i */
         for (unsigned pol = 0; pol < 2; ++ pol) {
@@ -510,17 +494,10 @@ void CNFMultiwaySelectionInliner::inject(const MultiwaySelectionDescriptor& md)
                 unsigned ndx
                     (i + j * md.elem_width());
 
-                Minisat::vec<Lit> ps;
-
-                if (MAINGROUP != f_group)
-                    ps.push( mkLit( f_group, true));
-
-                ps.push( mkLit( act, true));
-                ps.push( mkLit( f_sat.find_dd_var( z[ i ].getNode(),
-                                                   f_time), ! pol));
-                ps.push( mkLit( f_sat.find_dd_var( x[ ndx ].getNode(),
-                                                   f_time), pol));
-                f_sat.add_clause( ps );
+                f_tmpl.append( mkLit( act, true));
+                f_tmpl.append( mkLit( f_tmpl.find_dd_var( z[ i ].getNode()), ! pol));
+                f_tmpl.append( mkLit( f_tmpl.find_dd_var( x[ ndx ].getNode()), pol));
+                f_tmpl.close_clause();
             }
         }
 
@@ -34,7 +34,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/thread/mutex.hpp>
 
-class Engine;
+class CNFTemplate;
 
 typedef class InlinedOperatorLoader* InlinedOperatorLoader_ptr;
 typedef boost::unordered_map<InlinedOperatorSignature, InlinedOperatorLoader_ptr,
@@ -91,10 +91,8 @@ private:
 
 class CNFOperatorInliner {
 public:
-    CNFOperatorInliner(Engine& sat, step_t time, group_t group = MAINGROUP)
-        : f_sat(sat)
-        , f_time(time)
-        , f_group(group)
+    CNFOperatorInliner(CNFTemplate& tmpl)
+        : f_tmpl(tmpl)
     {}
 
     ~CNFOperatorInliner()
@@ -117,17 +115,13 @@ private:
     void inject(const InlinedOperatorDescriptor& md,
                 const LitsVector& clauses);
 
-    Engine& f_sat;
-    step_t f_time;
-    group_t f_group;
+    CNFTemplate& f_tmpl;
 };
 
 class CNFBinarySelectionInliner {
 public:
-    CNFBinarySelectionInliner(Engine& sat, step_t time, group_t group = MAINGROUP)
-        : f_sat(sat)
-        , f_time(time)
-        , f_group(group)
+    CNFBinarySelectionInliner(CNFTemplate& tmpl)
+        : f_tmpl(tmpl)
     {}
 
     ~CNFBinarySelectionInliner()
@@ -139,17 +133,13 @@ public:
 private:
     void inject(const BinarySelectionDescriptor& md);
 
-    Engine& f_sat;
-    step_t f_time;
-    group_t f_group;
+    CNFTemplate& f_tmpl;
 };
 
 class CNFMultiwaySelectionInliner {
 public:
-    CNFMultiwaySelectionInliner(Engine& sat, step_t time, group_t group = MAINGROUP)
-        : f_sat(sat)
-        , f_time(time)
-        , f_group(group)
+    CNFMultiwaySelectionInliner(CNFTemplate& tmpl)
+        : f_tmpl(tmpl)
     {}
 
     ~CNFMultiwaySelectionInliner()
@@ -161,9 +151,7 @@ public:
 private:
     void inject(const MultiwaySelectionDescriptor& md);
 
-    Engine& f_sat;
-    step_t f_time;
-    group_t f_group;
+    CNFTemplate& f_tmpl;
 };
 
 #endif /* SAT_HELPERS */
@@ -89,47 +89,44 @@ std::ostream &operator<<(std::ostream &os, const status_t &status)
 
 std::ostream& operator<<(std::ostream& os, const Engine& engine)
 {
-    const Solver& solver
-        (engine.f_solver);
-
     os
         << "Solver: `"
         << engine.f_instance_name
 
-        << "`, solves: "
-        << solver.solves
-
-        << ", starts: "
-        << solver.starts
-
-        << ", decs: "
-        << solver.decisions
+        << "` ("
+        << engine.f_backend->name()
+        << "), ";
 
-        << ", rnd decs: "
-        << solver.rnd_decisions
+    engine.f_backend->print_stats(os);
 
-        << ", props: "
-        << solver.propagations
+    os
+        << ", pushed clauses: "
+        << engine.f_clauses
 
-        << ", conflicts: "
-        << solver.conflicts
+        << ", pushed lits: "
+        << engine.f_literals
 
-        << ", dec vars: "
-        << solver.dec_vars
+        << ", singlecut DDs: "
+        << engine.f_cnf_stats.singlecut_dds
 
-        << ", clause lits: "
-        << solver.clauses_literals
+        << ", nocut DDs: "
+        << engine.f_cnf_stats.nocut_dds
 
-        << ", learnt lits: "
-        << solver.learnts_literals
+        << ", multicut DDs: "
+        << engine.f_cnf_stats.multicut_dds
 
-        << ", max lits: "
-        << solver.max_literals
+        << ", cuts: "
+        << engine.f_cnf_stats.cuts
+        ;
 
-        << ", tot lits: "
-        << solver.tot_literals
+    if (engine.f_exchange)
+        os
+            << ", exported learnts: "
+            << engine.f_exported
 
-        ;
+            << ", imported learnts: "
+            << engine.f_imported
+            ;
 
     return os;
 }
@@ -39,4 +39,10 @@ std::ostream &operator<<(std::ostream &os, const lbool &value);
 std::ostream &operator<<(std::ostream &out, const Lit &lit);
 std::ostream &operator<<(std::ostream &out, const vec<Lit> &lits);
 
+/* Minisat types are streamed from within the logger's namespace,
+   the operators above must be visible to argument dependent lookup. */
+namespace Minisat {
+    using ::operator<<;
+}
+
 #endif /* SAT_LOGGING_H */
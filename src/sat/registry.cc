@@ -0,0 +1,87 @@
+/**
+ * @file sat/registry.cc
+ * @brief SAT interface subsystem, timed variables registries implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/registry.hh>
+
+TimedVarRegistry::TimedVarRegistry()
+    : f_count(0)
+{}
+
+TCBIRegistry::TCBIRegistry()
+{}
+
+Var TCBIRegistry::find(const TCBI& tcbi)
+{
+    CanonicalBitMap::const_iterator eye
+        (f_cbit_map.find(CanonicalBit(tcbi.expr(), tcbi.bitno())));
+
+    if (f_cbit_map.end() == eye)
+        return VAR_UNDEF;
+
+    return f_registry.find(eye->second, tcbi.absolute_time());
+}
+
+void TCBIRegistry::insert(const TCBI& tcbi, Var var)
+{
+    assert(0 <= var);
+
+    f_registry.insert(cbit(tcbi), tcbi.absolute_time(), var);
+
+    if (f_var2tcbi.size() <= (unsigned) var)
+        f_var2tcbi.resize(1 + var, -1);
+
+    assert(-1 == f_var2tcbi[var]);
+    f_var2tcbi[var] = f_tcbis.size();
+    f_tcbis.push_back(tcbi);
+}
+
+const TCBI& TCBIRegistry::tcbi(Var var) const
+{
+    /* TCBI *has* to be there already. */
+    assert(0 <= var && (unsigned) var < f_var2tcbi.size());
+
+    int ndx
+        (f_var2tcbi[var]);
+    assert(0 <= ndx);
+
+    return f_tcbis[ndx];
+}
+
+unsigned TCBIRegistry::cbit(const TCBI& tcbi)
+{
+    CanonicalBit key
+        (tcbi.expr(), tcbi.bitno());
+
+    CanonicalBitMap::const_iterator eye
+        (f_cbit_map.find(key));
+
+    if (f_cbit_map.end() != eye)
+        return eye->second;
+
+    unsigned res
+        (f_cbit_map.size());
+
+    f_cbit_map.insert(std::pair<CanonicalBit, unsigned> (key, res));
+
+    return res;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file sat/registry.hh
+ * @brief SAT module, timed variables registries declarations.
+ *
+ * This header file contains the declarations of the registries used
+ * by the Engine to map timed model bits to solver variables. All
+ * registries are organized in time frames: each time frame is a
+ * separate row, so that the cost of a lookup does not depend on the
+ * number of frames that have been unrolled so far.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_REGISTRY_H
+#define SAT_REGISTRY_H
+
+#include <deque>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <sat/typedefs.hh>
+
+/* Marks an unbooked entry in the registries */
+const Var VAR_UNDEF(-1);
+
+/* Time frames -> rows mapping. Lookups are almost always performed
+   on the same time frame, therefore the last row fetched is cached. */
+template <class Row>
+class TimeFrameRows {
+public:
+    TimeFrameRows()
+        : f_nrows(0)
+        , f_last_time(0)
+        , f_last_row(NULL)
+    {}
+
+    /* Row for time frame `time`, NULL if no such row exists */
+    inline Row* find_row(step_t time)
+    {
+        if (NULL != f_last_row && f_last_time == time)
+            return f_last_row;
+
+        typename Time2RowMap::iterator eye
+            (f_time2row_map.find(time));
+
+        if (f_time2row_map.end() == eye)
+            return NULL;
+
+        f_last_time = time;
+        f_last_row = &f_rows[eye->second];
+
+        return f_last_row;
+    }
+
+    /* Row for time frame `time`, it is created if it does not exist */
+    inline Row& row(step_t time)
+    {
+        Row* res
+            (find_row(time));
+
+        if (NULL != res)
+            return *res;
+
+        /* recycle a previously cleared row, if any */
+        if (f_rows.size() == f_nrows)
+            f_rows.push_back(Row());
+
+        f_time2row_map.insert(std::pair<step_t, unsigned>
+                              (time, f_nrows));
+
+        f_last_time = time;
+        f_last_row = &f_rows[f_nrows ++];
+
+        return *f_last_row;
+    }
+
+    /* Number of time frames */
+    inline unsigned size() const
+    { return f_nrows; }
+
+    /* Drops all time frames, keeps allocated row storage */
+    inline void clear()
+    {
+        for (unsigned i = 0; i < f_nrows; ++ i)
+            f_rows[i].clear();
+
+        f_time2row_map.clear();
+        f_nrows = 0;
+        f_last_row = NULL;
+    }
+
+private:
+    typedef boost::unordered_map<step_t, unsigned, IntHash, IntEq> Time2RowMap;
+    Time2RowMap f_time2row_map;
+
+    /* rows are never moved once created */
+    std::deque<Row> f_rows;
+    unsigned f_nrows;
+
+    step_t f_last_time;
+    Row* f_last_row;
+};
+
+/* (index, time) -> Var registry. Indexes are expected to be small,
+   dense integers (e.g. canonical bit ids). Each
+   row is a flat vector of Vars. */
+class TimedVarRegistry {
+public:
+    TimedVarRegistry();
+
+    /* VAR_UNDEF if (index, time) is not booked */
+    inline Var find(unsigned index, step_t time)
+    {
+        VarVector* row
+            (f_frames.find_row(time));
+
+        if (NULL == row || row->size() <= index)
+            return VAR_UNDEF;
+
+        return (*row)[index];
+    }
+
+    inline void insert(unsigned index, step_t time, Var var)
+    {
+        VarVector& row
+            (f_frames.row(time));
+
+        if (row.size() <= index)
+            row.resize(1 + index, VAR_UNDEF);
+
+        assert(VAR_UNDEF == row[index]);
+        row[index] = var;
+
+        ++ f_count;
+    }
+
+    inline void clear()
+    {
+        f_frames.clear();
+        f_count = 0;
+    }
+
+    /* Number of time frames */
+    inline unsigned nframes() const
+    { return f_frames.size(); }
+
+    /* Number of booked entries */
+    inline unsigned size() const
+    { return f_count; }
+
+private:
+    TimeFrameRows<VarVector> f_frames;
+    unsigned f_count;
+};
+
+/* Bidirectional TCBI <-> Var registry. Each (expr, bitno) pair is
+   given a dense canonical bit id, TCBIs are then booked by (canonical
+   bit, absolute time). This preserves TCBI equality semantics (cfr.
+   TCBIEq) while keeping lookups independent of the unrolling
+   depth. The reverse mapping is indexed directly by Var. */
+class TCBIRegistry {
+public:
+    TCBIRegistry();
+
+    /* VAR_UNDEF if tcbi is not booked */
+    Var find(const TCBI& tcbi);
+
+    void insert(const TCBI& tcbi, Var var);
+
+    /* TCBI for var, var *must* be booked */
+    const TCBI& tcbi(Var var) const;
+
+    /* TCBI for var, NULL if var is not booked (e.g. a CNF var) */
+    inline const TCBI* find_tcbi(Var var) const
+    {
+        assert(0 <= var);
+
+        if (f_var2tcbi.size() <= (unsigned) var || f_var2tcbi[var] < 0)
+            return NULL;
+
+        return &f_tcbis[f_var2tcbi[var]];
+    }
+
+    /* Number of time frames */
+    inline unsigned nframes() const
+    { return f_registry.nframes(); }
+
+    /* Number of booked entries */
+    inline unsigned size() const
+    { return f_tcbis.size(); }
+
+private:
+    /* canonical bit id for (expr, bitno), created on demand */
+    unsigned cbit(const TCBI& tcbi);
+
+    typedef std::pair<Expr_ptr, unsigned> CanonicalBit;
+    typedef boost::unordered_map<CanonicalBit, unsigned> CanonicalBitMap;
+    CanonicalBitMap f_cbit_map;
+
+    TimedVarRegistry f_registry;
+
+    /* Var -> TCBI, positions into f_tcbis (-1 if not booked) */
+    std::vector<int> f_var2tcbi;
+    std::deque<TCBI> f_tcbis;
+};
+
+#endif /* SAT_REGISTRY_H */
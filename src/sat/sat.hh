@@ -37,6 +37,12 @@
 /* logging helpers */
 #include <sat/logging.hh>
 
+/* SAT backends */
+#include <sat/backend.hh>
+
+/* CNF templates */
+#include <sat/template.hh>
+
 /* Engine class */
 #include <sat/engine.hh>
 
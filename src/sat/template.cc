@@ -0,0 +1,282 @@
+/**
+ * @file sat/template.cc
+ * @brief SAT module, CNF templates implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <sat/sat.hh>
+
+#include <env/environment.hh>
+
+static const char* CNF_MODE_IDENTIFIER = "cnf_mode";
+static const char* CNF_MAX_PATHS_IDENTIFIER = "cnf_max_paths";
+static const char* CNF_MAX_DEPTH_IDENTIFIER = "cnf_max_depth";
+
+static const unsigned DEFAULT_CNF_MAX_PATHS (8);
+static const unsigned DEFAULT_CNF_MAX_DEPTH (16);
+
+CNFConfig cnf_config()
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    CNFConfig res;
+
+    res.mode = CNF_ADAPTIVE;
+    res.max_paths = env_unsigned(CNF_MAX_PATHS_IDENTIFIER, 2,
+                                 DEFAULT_CNF_MAX_PATHS);
+    res.max_depth = env_unsigned(CNF_MAX_DEPTH_IDENTIFIER, 1,
+                                 DEFAULT_CNF_MAX_DEPTH);
+
+    Expr_ptr value
+        (env_value(CNF_MODE_IDENTIFIER));
+
+    if (! value || value == em.make_identifier("adaptive"))
+        res.mode = CNF_ADAPTIVE;
+
+    else if (value == em.make_identifier("singlecut"))
+        res.mode = CNF_SINGLE_CUT;
+
+    else if (value == em.make_identifier("polarity"))
+        res.mode = CNF_POLARITY;
+
+    else
+        WARN
+            << "Unsupported " << CNF_MODE_IDENTIFIER
+            << " `" << value << "`, "
+            << "falling back to adaptive"
+            << std::endl;
+
+    return res;
+}
+
+CNFTemplate::CNFTemplate(const CompilationUnit& cu, const CNFConfig& config)
+    : f_config(config)
+{
+    clock_t t0 = clock();
+
+    /* template var 0 is bound to true (cfr. MAINGROUP) */
+    new_var(CNF_BINDING_TRUE);
+
+    /**
+     * 1. DDs
+     */
+    {
+        const DDVector& dv
+            (cu.dds());
+
+        DDVector::const_iterator i;
+        for (i = dv.begin(); dv.end() != i; ++ i) {
+            switch (f_config.mode) {
+            case CNF_ADAPTIVE:
+                cnf_push_adaptive( *i );
+                break;
+
+            case CNF_SINGLE_CUT:
+                cnf_push_single_cut( *i );
+                ++ f_stats.singlecut_dds;
+                break;
+
+            case CNF_POLARITY:
+                cnf_push_polarity( *i );
+                ++ f_stats.singlecut_dds;
+                break;
+
+            default: assert(false); /* unreachable */
+            } /* switch() */
+        }
+    }
+
+    /**
+     * 2. CNF for inlined operators
+     */
+    {
+        const InlinedOperatorDescriptors& inlined_operator_descriptors
+            (cu.inlined_operator_descriptors());
+
+        InlinedOperatorDescriptors::const_iterator i;
+        for (i = inlined_operator_descriptors.begin();
+             inlined_operator_descriptors.end() != i; ++ i) {
+
+            CNFOperatorInliner worker
+                (*this);
+
+            worker(*i);
+        }
+    }
+
+    /**
+     * 3. ITE MUXes
+     */
+    {
+        const Expr2BinarySelectionDescriptorsMap& binary_selection_descriptors_map
+            (cu.binary_selection_descriptors_map());
+
+        Expr2BinarySelectionDescriptorsMap::const_iterator mmi
+            (binary_selection_descriptors_map.begin());
+
+        while (binary_selection_descriptors_map.end() != mmi) {
+            const BinarySelectionDescriptors& descriptors
+                (mmi -> second);
+
+            BinarySelectionDescriptors::const_iterator i;
+            for (i = descriptors.begin(); descriptors.end() != i; ++ i) {
+
+                CNFBinarySelectionInliner worker
+                    (*this);
+
+                worker(*i);
+            }
+
+            ++ mmi ;
+        }
+    }
+
+    /**
+     * 4. ARRAY MUXes
+     */
+    {
+        const MultiwaySelectionDescriptors& muxes
+            (cu.array_mux_descriptors());
+        MultiwaySelectionDescriptors::const_iterator i;
+        for (i = muxes.begin(); muxes.end() != i; ++ i) {
+
+            CNFMultiwaySelectionInliner worker
+                (*this);
+
+            worker(*i);
+        }
+    }
+
+    /* construction-time maps are no longer needed */
+    VarVector().swap(f_dd_map);
+    DDNode2VarMap().swap(f_cnf_map);
+    VarVector().swap(f_rewrite_map);
+
+    double secs = (double) (clock() - t0) / (double) CLOCKS_PER_SEC;
+    unsigned vars (nvars()), clauses (nclauses()), lits (nlits());
+
+    DEBUG
+        << "Built CNF template: "
+        << vars << " vars, "
+        << clauses << " clauses, "
+        << lits << " literals ("
+        << f_stats.singlecut_dds << " singlecut, "
+        << f_stats.nocut_dds << " nocut, "
+        << f_stats.multicut_dds << " multicut DDs, "
+        << f_stats.cuts << " cuts), took "
+        << secs << " seconds"
+        << std::endl;
+}
+
+CNFTemplate::~CNFTemplate()
+{}
+
+const CNFTemplate& CNFTemplate::require(const CompilationUnit& cu)
+{
+    CNFTemplateCache& cache
+        (cu.cnf_template_cache());
+
+    CNFConfig config
+        (cnf_config());
+
+    boost::mutex::scoped_lock lock
+        (cache.f_mutex);
+
+    if (! cache.f_template || ! (config == cache.f_template->config()))
+        cache.f_template = CNFTemplate_ptr(new CNFTemplate(cu, config));
+
+    return *cache.f_template;
+}
+
+Var CNFTemplate::new_var(int binding)
+{
+    Var res
+        (f_bindings.size());
+
+    f_bindings.push_back(binding);
+
+    return res;
+}
+
+Var CNFTemplate::find_dd_var(const DdNode* node)
+{
+    assert (NULL != node && ! Cudd_IsConstant(node));
+
+    return find_dd_var(node->index);
+}
+
+Var CNFTemplate::find_dd_var(int node_index)
+{
+    assert (0 <= node_index);
+
+    if (f_dd_map.size() <= (unsigned) node_index)
+        f_dd_map.resize(1 + node_index, VAR_UNDEF);
+
+    Var& res
+        (f_dd_map[node_index]);
+
+    if (VAR_UNDEF == res)
+        res = new_var(node_index);
+
+    return res;
+}
+
+Var CNFTemplate::find_cnf_var(const DdNode* node)
+{
+    assert (NULL != node);
+
+    DdNode* key
+        (const_cast<DdNode*> (node));
+
+    DDNode2VarMap::const_iterator eye
+        (f_cnf_map.find(key));
+
+    if (f_cnf_map.end() != eye)
+        return eye->second;
+
+    Var res
+        (new_var(CNF_BINDING_AUX));
+
+    f_cnf_map.insert(std::pair<DdNode*, Var> (key, res));
+
+    return res;
+}
+
+void CNFTemplate::clear_cnf_map()
+{
+    f_rewrite_map.clear();
+}
+
+Var CNFTemplate::rewrite_cnf_var(Var v)
+{
+    assert (0 <= v);
+
+    if (f_rewrite_map.size() <= (unsigned) v)
+        f_rewrite_map.resize(1 + v, VAR_UNDEF);
+
+    Var& res
+        (f_rewrite_map[v]);
+
+    if (VAR_UNDEF == res)
+        res = new_var(CNF_BINDING_AUX);
+
+    return res;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file sat/template.hh
+ * @brief SAT module, CNF templates declarations.
+ *
+ * This header file contains the declarations of CNF templates. A CNF
+ * template is the time-relative CNF of a CompilationUnit: clauses are
+ * expressed in terms of template variables, each of which is bound
+ * either to a model bit (a DD index), to an auxiliary CNF variable or
+ * to the constant true. The template is built once per unit and is
+ * then instantiated in any time frame of any Engine by renaming its
+ * variables (cfr. Engine::push).
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef SAT_TEMPLATE_H
+#define SAT_TEMPLATE_H
+
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <sat/typedefs.hh>
+#include <sat/registry.hh>
+
+#include <model/compiler/unit.hh>
+
+/* Template variable bindings, non-negative bindings are DD indexes */
+const int CNF_BINDING_TRUE(-1);
+const int CNF_BINDING_AUX(-2);
+
+typedef boost::unordered_map<DdNode*, Var, PtrHash, PtrEq> DDNode2VarMap;
+typedef boost::unordered_set<DdNode*, PtrHash, PtrEq> DDNodeSet;
+
+/* DD CNFization algorithms, selected with `set cnf_mode <mode>` */
+typedef enum {
+    CNF_ADAPTIVE,    /* `adaptive`, default */
+    CNF_SINGLE_CUT,  /* `singlecut` */
+    CNF_POLARITY,    /* `polarity`, Plaisted-Greenbaum single cut */
+} cnf_mode_t;
+
+/* DD CNFization configuration */
+struct CNFConfig {
+    cnf_mode_t mode;
+
+    /* adaptive only: max clauses per cut (`set cnf_max_paths <n>`)
+       and max path length per clause (`set cnf_max_depth <n>`) */
+    unsigned max_paths;
+    unsigned max_depth;
+
+    inline bool operator==(const CNFConfig& other) const
+    {
+        return
+            mode == other.mode &&
+            max_paths == other.max_paths &&
+            max_depth == other.max_depth;
+    }
+};
+
+/* Current DD CNFization configuration, from the environment */
+CNFConfig cnf_config();
+
+/* Strategies chosen for the DDs of a template */
+struct CNFStats {
+    unsigned singlecut_dds;
+    unsigned nocut_dds;
+    unsigned multicut_dds;
+    unsigned cuts;
+
+    CNFStats()
+        : singlecut_dds(0)
+        , nocut_dds(0)
+        , multicut_dds(0)
+        , cuts(0)
+    {}
+
+    inline void add(const CNFStats& other)
+    {
+        singlecut_dds += other.singlecut_dds;
+        nocut_dds += other.nocut_dds;
+        multicut_dds += other.multicut_dds;
+        cuts += other.cuts;
+    }
+};
+
+class CNFTemplate {
+public:
+    /**
+     * @brief Builds the CNF template for cu
+     */
+    CNFTemplate(const CompilationUnit& cu, const CNFConfig& config);
+
+    ~CNFTemplate();
+
+    /**
+     * @brief The CNF template for cu, built on first request and
+     * shared by all copies of cu (synchronized). The template is
+     * rebuilt if the CNFization configuration has changed.
+     */
+    static const CNFTemplate& require(const CompilationUnit& cu);
+
+    /**
+     * @brief CNFization configuration used to build this template
+     */
+    inline const CNFConfig& config() const
+    { return f_config; }
+
+    /**
+     * @brief CNFization strategies chosen for the DDs
+     */
+    inline const CNFStats& stats() const
+    { return f_stats; }
+
+    /**
+     * @brief Number of template variables
+     */
+    inline unsigned nvars() const
+    { return f_bindings.size(); }
+
+    /**
+     * @brief Binding for template variable var
+     */
+    inline int binding(Var var) const
+    { return f_bindings[var]; }
+
+    /**
+     * @brief Number of clauses
+     */
+    inline unsigned nclauses() const
+    { return f_clauses.size(); }
+
+    /**
+     * @brief Literals of the i-th clause are in [begin(i), end(i))
+     */
+    inline const Lit* begin(unsigned i) const
+    { return &f_lits[0] + (i ? f_clauses[i - 1] : 0); }
+
+    inline const Lit* end(unsigned i) const
+    { return &f_lits[0] + f_clauses[i]; }
+
+    /**
+     * @brief Total number of literals
+     */
+    inline unsigned nlits() const
+    { return f_lits.size(); }
+
+    /* -- CNF builders interface ------------------------------------------ */
+
+    /**
+     * @brief Model DD nodes to template variable mapping
+     */
+    Var find_dd_var(const DdNode* node);
+
+    /**
+     * @brief Model DD index to template variable mapping
+     */
+    Var find_dd_var(int node_index);
+
+    /**
+     * @brief Artifactory DD nodes to template variable mapping
+     */
+    Var find_cnf_var(const DdNode* node);
+
+    /**
+     * @brief Starts a new space for microcode CNF vars
+     */
+    void clear_cnf_map();
+
+    /**
+     * @brief Rewrites a microcode CNF var
+     */
+    Var rewrite_cnf_var(Var var);
+
+    /**
+     * @brief Appends a literal to the current clause
+     */
+    inline void append(Lit lit)
+    {
+        assert((unsigned) Minisat::var(lit) < nvars());
+        f_lits.push_back(lit);
+    }
+
+    /**
+     * @brief Closes the current clause
+     */
+    inline void close_clause()
+    {
+        assert(f_clauses.empty() || f_clauses.back() < f_lits.size());
+        f_clauses.push_back(f_lits.size());
+    }
+
+private:
+    CNFConfig f_config;
+    CNFStats f_stats;
+
+    /* template variable -> binding, var 0 is bound to true */
+    std::vector<int> f_bindings;
+
+    /* clauses, f_clauses holds the end offset of each clause */
+    std::vector<Lit> f_lits;
+    std::vector<unsigned> f_clauses;
+
+    /* construction-time maps */
+    VarVector f_dd_map;
+    DDNode2VarMap f_cnf_map;
+    VarVector f_rewrite_map;
+
+    Var new_var(int binding);
+
+    /* CNFization algorithms. DDs are taken by reference: strategies
+       may build templates concurrently, DD reference counts are not
+       synchronized. */
+    void cnf_push_no_cut(const ADD& add);
+    void cnf_push_single_cut(const ADD& add);
+    void cnf_push_polarity(const ADD& add);
+    void cnf_push_adaptive(const ADD& add);
+
+    /* clauses for all paths from node to the zero leaf or to a cut
+       node. Unless toplevel, clauses are activated by node's cut var. */
+    void cnf_push_paths(const DdNode* node, const DDNodeSet& cuts,
+                        bool toplevel);
+};
+
+#endif /* SAT_TEMPLATE_H */
@@ -28,10 +28,10 @@
 
 #include <dd/dd.hh>
 
-/* decls from the Minisat SAT solver */
-#include <minisat/core/Solver.h>
-#include <minisat/simp/SimpSolver.h>
+/* literals and variables, from the Minisat SAT solver. Solvers
+   proper are only visible to the SAT backends (cfr. sat/backend.hh) */
 #include <minisat/core/SolverTypes.h>
+#include <minisat/mtl/Vec.h>
 
 #include <utils/pool.hh>
 
@@ -47,9 +47,6 @@ typedef std::vector<Var> VarVector;
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
-using Minisat::Solver;
-using Minisat::SimpSolver;
-
 // Engine mgmt
 typedef class Engine* Engine_ptr;
 typedef class EngineMgr* EngineMgr_ptr;
@@ -68,72 +65,6 @@ typedef enum {
 } status_t;
 
 #include <enc/tcbi.hh>
-typedef boost::unordered_map<TCBI, Var, TCBIHash, TCBIEq> TCBI2VarMap;
-typedef boost::unordered_map<Var, TCBI, IntHash, IntEq> Var2TCBIMap;
-
-struct TimedVar {
-public:
-    TimedVar(Var var, step_t time)
-        : f_var(var)
-        , f_time(time)
-    {}
-
-    inline Var var() const
-    { return f_var; }
-
-    inline step_t time() const
-    { return f_time; }
-
-    // The CNF var
-    Var f_var;
-
-    // expression time (default is 0)
-    step_t f_time;
-};
-
-struct TimedVarHash {
-    inline long operator() (const TimedVar& k) const
-    { return 0L; }
-};
-
-struct TimedVarEq {
-    inline bool operator() (const TimedVar& x, const TimedVar& y) const
-    { return (x.var() == y.var() && x.time() == y.time()); }
-};
-
-typedef boost::unordered_map<TimedVar, Var, TimedVarHash, TimedVarEq> RewriteMap;
-
-struct TimedDD {
-public:
-  TimedDD(DdNode *node, step_t time)
-    : f_node(node)
-    , f_time(time)
-  {}
-
-  inline DdNode* node() const
-  { return f_node; }
-
-  inline step_t time() const
-  { return f_time; }
-
-  // The DdNode node
-  DdNode* f_node;
-
-  // expression time (default is 0)
-  step_t f_time;
-};
-
-struct TimedDDHash {
-  inline long operator() (const TimedDD& k) const
-  { PtrHash hasher; return hasher( reinterpret_cast<void *> (k.node())); }
-};
-
-struct TimedDDEq {
-  inline bool operator() (const TimedDD& x, const TimedDD& y) const
-  { return (x.node() == y.node() && x.time() == y.time()); }
-};
-
-typedef boost::unordered_map<TimedDD, Var, TimedDDHash, TimedDDEq> TDD2VarMap;
 
 // move me!
 #if 0
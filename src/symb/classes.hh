@@ -33,6 +33,7 @@
 #include <utils/pool.hh>
 
 #include <type/typedefs.hh>
+#include <symb/typedefs.hh>
 
 #include <parser/grammars/grammar.hh>
 
@@ -69,6 +70,9 @@ public:
         , f_hidden(false)
     {}
 
+    virtual ~Symbol()
+    {}
+
     virtual const Expr_ptr module()  const =0;
     virtual const Expr_ptr name() const =0;
 
@@ -145,6 +149,7 @@ class Variable
     bool     f_temp;
     bool     f_frozen;
     bool     f_inertial;
+    monitor_t f_monitor;
 
 public:
     Variable(Expr_ptr module, Expr_ptr name, Type_ptr type)
@@ -155,6 +160,7 @@ public:
         , f_temp(false)
         , f_frozen(false)
         , f_inertial(false)
+        , f_monitor(MONITOR_NONE)
     {}
 
     const Expr_ptr module() const
@@ -189,6 +195,15 @@ public:
 
     inline bool is_temp() const
     { return f_temp; }
+
+    void set_monitor(monitor_t value)
+    { f_monitor = value; }
+
+    inline monitor_t monitor() const
+    { return f_monitor; }
+
+    inline bool is_monitor() const
+    { return MONITOR_NONE != f_monitor; }
 };
 
 class Parameter
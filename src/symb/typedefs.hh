@@ -45,6 +45,15 @@ typedef class Constant* Constant_ptr;
 typedef boost::unordered_map<Expr_ptr, Constant_ptr,
                              PtrHash, PtrEq> Constants;
 
+/* Variables added by model transformations (cfr. LivenessToSafety)
+   are monitors: they are not part of witnesses. A loop monitor holds
+   from the time frame the last state loops back to on. */
+typedef enum {
+    MONITOR_NONE,
+    MONITOR_AUX,
+    MONITOR_LOOP,
+} monitor_t;
+
 typedef class Variable* Variable_ptr;
 typedef boost::unordered_map<Expr_ptr, Variable_ptr,
                              PtrHash, PtrEq> Variables;
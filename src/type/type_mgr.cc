@@ -43,6 +43,9 @@ TypeMgr::TypeMgr()
 /** Booleans */
 const ScalarType_ptr TypeMgr::find_boolean()
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_boolean_type());
 
@@ -60,6 +63,9 @@ const ScalarType_ptr TypeMgr::find_boolean()
 
 const ArrayType_ptr TypeMgr::find_boolean_array(unsigned size)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_subscript(f_em.make_boolean_type(),
                              f_em.make_const(size)));
@@ -79,6 +85,9 @@ const ArrayType_ptr TypeMgr::find_boolean_array(unsigned size)
 /** Enums */
 const ScalarType_ptr TypeMgr::find_enum(ExprSet& lits)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr repr
         (em().make_enum_type(lits));
 
@@ -111,6 +120,9 @@ const ScalarType_ptr TypeMgr::find_enum(ExprSet& lits)
 
 const ArrayType_ptr TypeMgr::find_enum_array(ExprSet& lits, unsigned size)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_subscript(f_em.make_enum_type(lits),
                              f_em.make_const(size)));
@@ -130,6 +142,9 @@ const ArrayType_ptr TypeMgr::find_enum_array(ExprSet& lits, unsigned size)
 /** Constants */
 const ScalarType_ptr TypeMgr::find_constant(unsigned width)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_const_int_type(width));
 
@@ -148,6 +163,9 @@ const ScalarType_ptr TypeMgr::find_constant(unsigned width)
 
 const StringType_ptr TypeMgr::find_string()
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_string_type());
 
@@ -166,6 +184,9 @@ const StringType_ptr TypeMgr::find_string()
 /** Unsigned algebraics (both integer and fixed-point) */
 const ScalarType_ptr TypeMgr::find_unsigned(unsigned width)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_unsigned_int_type(width));
 
@@ -184,6 +205,9 @@ const ScalarType_ptr TypeMgr::find_unsigned(unsigned width)
 
 const ArrayType_ptr TypeMgr::find_unsigned_array(unsigned width, unsigned size)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_subscript( f_em.make_unsigned_int_type(width), f_em.make_const(size)));
 
@@ -203,6 +227,9 @@ const ArrayType_ptr TypeMgr::find_unsigned_array(unsigned width, unsigned size)
 /** Signed algebraics (both integer and fixed-point) */
 const ScalarType_ptr TypeMgr::find_signed(unsigned width)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_signed_int_type(width));
 
@@ -221,6 +248,9 @@ const ScalarType_ptr TypeMgr::find_signed(unsigned width)
 
 const ArrayType_ptr TypeMgr::find_signed_array(unsigned width, unsigned size)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_subscript( f_em.make_signed_int_type(width), f_em.make_const(size)));
 
@@ -240,6 +270,9 @@ const ArrayType_ptr TypeMgr::find_signed_array(unsigned width, unsigned size)
 /** Instances */
 const ScalarType_ptr TypeMgr::find_instance(Expr_ptr module, Expr_ptr params)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr repr
         (em().make_params(module, params));
 
@@ -277,6 +310,9 @@ const Type_ptr TypeMgr::find_type_by_def(const Expr_ptr expr)
 /** Arrays */
 const ArrayType_ptr TypeMgr::find_array_type( ScalarType_ptr of, unsigned nelems)
 {
+    boost::recursive_mutex::scoped_lock lock
+        (f_register_mutex);
+
     Expr_ptr descr
         (f_em.make_subscript( of->repr(),
                               f_em.make_const( nelems)));
@@ -28,6 +28,7 @@
 #define TYPE_MGR_H
 
 #include <boost/unordered_map.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 
 #include <expr/expr.hh>
 #include <expr/expr_mgr.hh>
@@ -112,7 +113,9 @@ private:
     inline Type_ptr lookup_type(const Expr_ptr expr)
     { return f_register [ expr ]; }
 
-    /* local data */
+    /* local data, types are looked up and registered concurrently
+       (e.g. by compiler workers) */
+    boost::recursive_mutex f_register_mutex;
     TypeMap f_register;
 
     // ref to expr manager
@@ -0,0 +1,227 @@
+/**
+ * @file extractor.cc
+ * @brief Witness module (WitnessExtractor class) implementation.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <witness/extractor.hh>
+
+#include <enc/enc_mgr.hh>
+#include <enc/tcbi.hh>
+
+#include <symb/symb_iter.hh>
+
+WitnessExtractor::WitnessExtractor(Model& model)
+{
+    EncodingMgr& bm
+        (EncodingMgr::INSTANCE());
+
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    unsigned width
+        (0);
+
+    SymbIter symbols
+        (model);
+
+    while (symbols.has_next()) {
+
+        std::pair <Expr_ptr, Symbol_ptr> pair
+            (symbols.next());
+
+        Expr_ptr ctx
+            (pair.first);
+
+        Symbol_ptr symb
+            (pair.second);
+
+        Expr_ptr key
+            (em.make_dot( ctx, symb->name()));
+
+        f_language.push_back(key);
+        if (! symb->is_variable() || ! symb->as_variable().is_monitor())
+            f_model_language.push_back(key);
+
+        if (symb->is_variable()) {
+
+            const Variable& var
+                (symb->as_variable());
+
+            /* INPUT vars are in fact bodyless, typed DEFINEs */
+            if (var.is_input()) {
+                f_inputs.push_back(WitnessSymbol(ctx, key, symb));
+                continue;
+            }
+
+            /* time it, and fetch encoding for enc mgr */
+            Encoding_ptr enc
+                (bm.find_encoding( TimedExpr(key, var.is_frozen()
+                                             ? UINT_MAX : 0)) );
+
+            /* not in COI, skipping... */
+            if ( ! enc )
+                continue;
+
+            WitnessSymbol entry
+                (ctx, key, symb, enc);
+
+            /* DD index -> UCBI, once and for all */
+            DDVector::const_iterator di;
+            for (di = enc->bits().begin(); enc->bits().end() != di; ++ di) {
+
+                unsigned bit
+                    ((*di).getNode()->index);
+
+                entry.bits.push_back(bm.find_ucbi(bit));
+            }
+
+            if (width < entry.bits.size())
+                width = entry.bits.size();
+
+            f_variables.push_back(entry);
+        }
+
+        else if (symb->is_define()) {
+            f_define_index.insert( std::pair< Expr_ptr, unsigned >
+                                   (key, f_defines.size()));
+            f_defines.push_back(WitnessSymbol(ctx, key, symb));
+        }
+    }
+
+    f_word.resize(width);
+
+    unsigned nvars
+        (f_variables.size());
+
+    DEBUG
+        << "Witness extractor ready, "
+        << nvars
+        << " variables, "
+        << width
+        << " bits at most"
+        << std::endl;
+}
+
+WitnessExtractor::~WitnessExtractor()
+{}
+
+Expr_ptr WitnessExtractor::value(Engine& engine, const WitnessSymbol& var,
+                                 step_t time)
+{
+    assert(var.enc);
+
+    unsigned nbits
+        (var.bits.size());
+
+    /* time each bit into a TCBI, fetch its value in the SAT model */
+    for (unsigned i = 0; i < nbits; ++ i) {
+        const TCBI tcbi
+            (var.bits[i], time);
+
+        f_word[i] = engine.value(engine.tcbi_to_var(tcbi));
+    }
+
+    return var.enc->bits_expr(nbits ? &f_word[0] : NULL);
+}
+
+WitnessSnapshot::WitnessSnapshot(Model& model, bool monitors)
+    : f_extractor(model)
+    , f_monitors(monitors)
+    , f_stride(0)
+    , f_nrows(0)
+{
+    const WitnessSymbols& variables
+        (f_extractor.variables());
+
+    unsigned width
+        (0);
+
+    for (WitnessSymbols::const_iterator i = variables.begin();
+         variables.end() != i; ++ i) {
+
+        unsigned nbits
+            (i->bits.size());
+
+        f_offsets.push_back(f_stride);
+        f_stride += nbits;
+
+        if (width < nbits)
+            width = nbits;
+    }
+
+    f_word.resize(width);
+}
+
+WitnessSnapshot::~WitnessSnapshot()
+{}
+
+void WitnessSnapshot::push_row(Engine& engine, step_t time)
+{
+    const WitnessSymbols& variables
+        (f_extractor.variables());
+
+    uint64_t base
+        ((uint64_t) f_nrows * f_stride);
+
+    f_bits.resize((base + f_stride + 63) / 64, 0);
+
+    uint64_t pos
+        (base);
+
+    for (WitnessSymbols::const_iterator i = variables.begin();
+         variables.end() != i; ++ i) {
+
+        const std::vector<UCBI>& bits
+            (i->bits);
+
+        for (std::vector<UCBI>::const_iterator j = bits.begin();
+             bits.end() != j; ++ j, ++ pos) {
+
+            const TCBI tcbi
+                (*j, time);
+
+            /* don't cares are assigned to 0 */
+            if (engine.value(engine.tcbi_to_var(tcbi)))
+                f_bits[pos / 64] |= (uint64_t) 1 << (pos % 64);
+        }
+    }
+
+    ++ f_nrows;
+}
+
+Expr_ptr WitnessSnapshot::value(unsigned i, step_t row) const
+{
+    assert(row < f_nrows);
+
+    const WitnessSymbol& var
+        (f_extractor.variables()[i]);
+
+    unsigned nbits
+        (var.bits.size());
+
+    uint64_t pos
+        ((uint64_t) row * f_stride + f_offsets[i]);
+
+    for (unsigned j = 0; j < nbits; ++ j, ++ pos)
+        f_word[j] = (f_bits[pos / 64] >> (pos % 64)) & 1;
+
+    return var.enc->bits_expr(nbits ? &f_word[0] : NULL);
+}
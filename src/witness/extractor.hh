@@ -0,0 +1,159 @@
+/**
+ * @file extractor.hh
+ * @brief Witness module (WitnessExtractor class)
+ *
+ * This header file contains the declarations required to extract
+ * witness time frames from a SAT model. The symbols of the model, and
+ * the bits of the encodings of its variables, are collected once;
+ * each frame is then decoded straight from the values of those bits.
+ *
+ * The values of the bits can also be kept in a snapshot, and decoded
+ * later on, only if the witness is actually inspected.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#ifndef WITNESS_EXTRACTOR_H
+#define WITNESS_EXTRACTOR_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <expr/expr.hh>
+
+#include <enc/enc.hh>
+#include <enc/ucbi.hh>
+
+#include <model/model.hh>
+
+#include <sat/sat.hh>
+
+#include <symb/classes.hh>
+
+/* A symbol of the model, as seen by witness extraction */
+struct WitnessSymbol {
+    Expr_ptr ctx;
+    Expr_ptr key;
+    Symbol_ptr symb;
+
+    /* variables only: the encoding, and the untimed bits of the
+       encoding, in the order of its bits() */
+    Encoding_ptr enc;
+    std::vector<UCBI> bits;
+
+    WitnessSymbol(Expr_ptr ctx_, Expr_ptr key_, Symbol_ptr symb_,
+                  Encoding_ptr enc_ = NULL)
+        : ctx(ctx_)
+        , key(key_)
+        , symb(symb_)
+        , enc(enc_)
+    {}
+};
+
+typedef std::vector<WitnessSymbol> WitnessSymbols;
+
+typedef boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq> WitnessSymbolIndex;
+
+class WitnessExtractor {
+public:
+    WitnessExtractor(Model& model);
+    ~WitnessExtractor();
+
+    /* Full list of symbols, in model order. Monitors are not part of
+       the model, they can be left out. */
+    inline const ExprVector& language(bool monitors = true) const
+    { return monitors ? f_language : f_model_language; }
+
+    /* Encoded variables, INPUT variables excluded */
+    inline const WitnessSymbols& variables() const
+    { return f_variables; }
+
+    /* INPUT variables, these have no encoding */
+    inline const WitnessSymbols& inputs() const
+    { return f_inputs; }
+
+    inline const WitnessSymbols& defines() const
+    { return f_defines; }
+
+    inline bool is_define(Expr_ptr key) const
+    { return f_define_index.end() != f_define_index.find(key); }
+
+    /* Value of var in the SAT model, at time. Don't cares are
+       assigned to 0, NULL values indicate UNDEFs. */
+    Expr_ptr value(Engine& engine, const WitnessSymbol& var, step_t time);
+
+private:
+    ExprVector f_language;
+    ExprVector f_model_language;
+
+    WitnessSymbols f_variables;
+    WitnessSymbols f_inputs;
+    WitnessSymbols f_defines;
+    WitnessSymbolIndex f_define_index;
+
+    /* bit values of one variable, sized to the widest encoding */
+    std::vector<int> f_word;
+};
+
+/* Raw values of the encoding bits of the variables, one row per time
+   frame, as taken from a SAT model. The engine is no longer needed to
+   decode them. */
+class WitnessSnapshot {
+public:
+    /* monitors tells whether monitor variables are part of the
+       witness' language */
+    WitnessSnapshot(Model& model, bool monitors);
+    ~WitnessSnapshot();
+
+    inline const WitnessExtractor& extractor() const
+    { return f_extractor; }
+
+    inline bool monitors() const
+    { return f_monitors; }
+
+    inline step_t nrows() const
+    { return f_nrows; }
+
+    /* Appends a row, with the values of the bits at time in the SAT
+       model */
+    void push_row(Engine& engine, step_t time);
+
+    /* Value of the i-th variable of the extractor in row, NULL values
+       indicate UNDEFs */
+    Expr_ptr value(unsigned i, step_t row) const;
+
+private:
+    WitnessExtractor f_extractor;
+    bool f_monitors;
+
+    /* per variable, offset of its bits in a row */
+    std::vector<unsigned> f_offsets;
+    unsigned f_stride;
+
+    std::vector<uint64_t> f_bits;
+    step_t f_nrows;
+
+    mutable std::vector<int> f_word;
+};
+
+typedef boost::shared_ptr<WitnessSnapshot> WitnessSnapshot_ptr;
+
+#endif /* WITNESS_EXTRACTOR_H */
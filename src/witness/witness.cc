@@ -22,14 +22,151 @@
  **/
 
 #include <witness.hh>
+#include <witness_mgr.hh>
 
 #include <utils/misc.hh>
 
 #include <sstream>
 #include <cstring>
 
-TimeFrame::TimeFrame(Witness& owner)
+WitnessLayout::WitnessLayout()
+{}
+
+WitnessLayout::~WitnessLayout()
+{}
+
+unsigned WitnessLayout::column(Expr_ptr expr, value_format_t format)
+{
+    Expr2CodeMapIterator eye
+        (f_index.find(expr));
+
+    if (f_index.end() != eye)
+        return (*eye).second;
+
+    unsigned res
+        (f_columns.size());
+
+    f_columns.push_back(WitnessColumnLayout(expr, format));
+    f_index.insert( std::pair< Expr_ptr, unsigned >
+                    (expr, res));
+
+    return res;
+}
+
+bool WitnessLayout::find_column(Expr_ptr expr, unsigned& column) const
+{
+    Expr2CodeMap::const_iterator eye
+        (f_index.find(expr));
+
+    if (f_index.end() == eye)
+        return false;
+
+    column = (*eye).second;
+    return true;
+}
+
+unsigned WitnessLayout::encode(unsigned column, Expr_ptr value)
+{
+    WitnessColumnLayout& layout
+        (f_columns[column]);
+
+    Expr2CodeMapIterator eye
+        (layout.codes.find(value));
+
+    if (layout.codes.end() != eye)
+        return (*eye).second;
+
+    layout.values.push_back(value);
+
+    unsigned res
+        (layout.values.size());
+
+    layout.codes.insert( std::pair< Expr_ptr, unsigned >
+                         (value, res));
+
+    return res;
+}
+
+WitnessColumn::WitnessColumn()
+    : f_width(1)
+{}
+
+unsigned WitnessColumn::code(step_t frame) const
+{
+    unsigned per_word
+        (64 / f_width);
+
+    unsigned word
+        (frame / per_word);
+
+    if (f_words.size() <= word)
+        return 0;
+
+    unsigned shift
+        ((frame % per_word) * f_width);
+
+    uint64_t mask
+        (((uint64_t) 1 << f_width) -1);
+
+    return (f_words[word] >> shift) & mask;
+}
+
+void WitnessColumn::set_code(step_t frame, unsigned code)
+{
+    unsigned width
+        (f_width);
+
+    while (width < 32 && ((uint64_t) 1 << width) <= code)
+        width <<= 1;
+
+    if (width != f_width)
+        widen(width);
+
+    unsigned per_word
+        (64 / f_width);
+
+    unsigned word
+        (frame / per_word);
+
+    if (f_words.size() <= word)
+        f_words.resize(1 + word, 0);
+
+    unsigned shift
+        ((frame % per_word) * f_width);
+
+    uint64_t mask
+        (((uint64_t) 1 << f_width) -1);
+
+    f_words[word] &= ~ (mask << shift);
+    f_words[word] |= ((uint64_t) code & mask) << shift;
+}
+
+void WitnessColumn::widen(unsigned width)
+{
+    assert(f_width < width);
+
+    WitnessColumn res;
+    res.f_width = width;
+
+    step_t nframes
+        (f_words.size() * (64 / f_width));
+
+    res.f_words.reserve(1 + nframes / (64 / width));
+    for (step_t frame = 0; frame < nframes; ++ frame) {
+        unsigned code
+            (this->code(frame));
+
+        if (code)
+            res.set_code(frame, code);
+    }
+
+    f_width = width;
+    f_words.swap(res.f_words);
+}
+
+TimeFrame::TimeFrame(Witness& owner, step_t index)
     : f_owner(owner)
+    , f_index(index)
 {}
 
 TimeFrame::~TimeFrame()
@@ -46,7 +183,17 @@ TimeFrame& Witness::operator[](step_t i)
     if (f_frames.size() -1 < i)
         throw IllegalTime(f_j + i);
 
-    return * f_frames [i];
+    return f_frames [i];
+}
+
+unsigned Witness::code(Expr_ptr expr, step_t index) const
+{
+    unsigned column;
+    if (! f_layout->find_column(expr, column) ||
+        f_columns.size() <= column)
+        return 0;
+
+    return f_columns[column].code(index);
 }
 
 /* Retrieves value for expr, throws an exception if no value exists. */
@@ -61,24 +208,23 @@ Expr_ptr TimeFrame::value( Expr_ptr expr )
 
     assert( find(lang.begin(), lang.end(), expr) != lang.end());
 
-    Expr2ExprMap::iterator eye;
+    f_owner.materialize(f_index, expr);
 
-    eye = f_map.find( expr );
-    if (f_map.end() == eye)
-        throw NoValue(expr);
+    unsigned code
+        (f_owner.code(expr, f_index));
 
-    Expr_ptr vexpr
-        ((*eye).second);
+    if (! code)
+        throw NoValue(expr);
 
-    Expr2FormatMap::iterator format_eye
-        (f_format_map.find( expr ));
+    unsigned column;
+    f_owner.f_layout->find_column(expr, column);
 
-    if (f_format_map.end() == format_eye)
-        assert(false); /* unreachable */
+    Expr_ptr vexpr
+        (f_owner.f_layout->decode(column, code));
 
     /* got value format */
     value_format_t fmt
-        ((*format_eye).second);
+        (f_owner.f_layout->format(column));
 
     /* force conversion of constants to required format. TODO: extend
        this to sets */
@@ -121,10 +267,9 @@ bool TimeFrame::has_value( Expr_ptr expr )
         assert(false);
     }
 
-    Expr2ExprMap::iterator eye;
+    f_owner.materialize(f_index, expr);
 
-    eye = f_map.find( expr );
-    return (f_map.end() != eye);
+    return 0 != f_owner.code(expr, f_index);
 }
 
 /* Sets value for expr */
@@ -145,12 +290,23 @@ void TimeFrame::set_value( Expr_ptr expr, Expr_ptr value, value_format_t format)
     assert( find( lang.begin(),
                   lang.end(), expr) != lang.end());
 
-    /* populate both maps at the same time. This ensures consistency. */
-    f_map.insert( std::pair< Expr_ptr, Expr_ptr >
-                  (expr, value));
+    /* the first value set for expr sticks */
+    if (f_owner.code(expr, f_index))
+        return;
+
+    WitnessLayout& layout
+        (* f_owner.f_layout);
+
+    unsigned column
+        (layout.column(expr, format));
+
+    WitnessColumns& columns
+        (f_owner.f_columns);
 
-    f_format_map.insert( std::pair< Expr_ptr, value_format_t >
-                         (expr, format));
+    if (columns.size() <= column)
+        columns.resize(1 + column);
+
+    columns[column].set_code(f_index, layout.encode(column, value));
 }
 
 ExprVector TimeFrame::assignments()
@@ -158,6 +314,8 @@ ExprVector TimeFrame::assignments()
     ExprMgr& em
         (ExprMgr::INSTANCE());
 
+    f_owner.materialize(f_index);
+
     ExprVector& lang
         (f_owner.lang());
 
@@ -186,6 +344,9 @@ Witness::Witness(Engine_ptr pe, Atom id, Atom desc, step_t j)
     : f_id(id)
     , f_desc(desc)
     , f_j(j)
+    , f_layout(new WitnessLayout())
+    , f_npending(0)
+    , f_loop(UINT_MAX)
     , p_engine(pe)
 {
     DEBUG
@@ -196,17 +357,77 @@ Witness::Witness(Engine_ptr pe, Atom id, Atom desc, step_t j)
         << std::endl;
 }
 
+Witness::Witness(const Witness& w)
+    : f_id(w.f_id)
+    , f_desc(w.f_desc)
+    , f_j(w.f_j)
+    , f_layout(w.f_layout)
+    , f_columns(w.f_columns)
+    , f_snapshot(w.f_snapshot)
+    , f_pending_variables(w.f_pending_variables)
+    , f_pending_defines(w.f_pending_defines)
+    , f_npending(w.f_npending)
+    , f_lang(w.f_lang)
+    , f_loop(w.f_loop)
+    , p_engine(w.p_engine)
+{
+    step_t nframes
+        (w.f_frames.size());
+
+    for (step_t i = 0; i < nframes; ++ i)
+        f_frames.push_back(TimeFrame(*this, i));
+
+    DEBUG
+        << "Duplicated witness: "
+        << f_id
+        << ", "
+        << nframes
+        << " frames"
+        << std::endl;
+}
+
 TimeFrame& Witness::extend(Witness& w)
 {
-    // seizing ownership of the TimeFrames from w
     TimeFrame_ptr last
         (NULL);
 
-    for (TimeFrames::iterator i = w.frames().begin(); i != w.frames().end(); ++ i) {
-        f_frames.push_back(*i);
-        last = (*i);
+    WitnessLayout& layout
+        (* f_layout);
+
+    const WitnessLayout& other
+        (* w.f_layout);
+
+    for (step_t i = 0; i < w.f_frames.size(); ++ i) {
+        last = & extend();
+        w.materialize(i);
+
+        for (unsigned wcol = 0; wcol < w.f_columns.size(); ++ wcol) {
+            unsigned code
+                (w.f_columns[wcol].code(i));
+
+            if (! code)
+                continue;
+
+            /* values are re-encoded in this witness' layout, unless
+               it is shared */
+            unsigned column
+                (wcol);
+
+            if (f_layout != w.f_layout) {
+                column = layout.column(other.expr(wcol), other.format(wcol));
+                code = layout.encode(column, other.decode(wcol, code));
+            }
+
+            if (f_columns.size() <= column)
+                f_columns.resize(1 + column);
+
+            f_columns[column].set_code(f_frames.size() -1, code);
+        }
     }
+
+    // w is left empty
     w.f_frames.clear();
+    w.f_columns.clear();
 
     assert( last);
     return * last;
@@ -214,13 +435,13 @@ TimeFrame& Witness::extend(Witness& w)
 
 TimeFrame& Witness::extend()
 {
-    TimeFrame_ptr tf
-        (new TimeFrame(*this));
+    f_frames.push_back(TimeFrame(*this, f_frames.size()));
 
-    f_frames.push_back(tf);
+    TimeFrame_ptr tf
+        (& f_frames.back());
 
     step_t last
-        (1 + last_time());
+        (last_time());
 
     DEBUG << "Added empty TimeFrame " << last
           << " to witness " << id()
@@ -238,7 +459,7 @@ Expr_ptr Witness::value( Expr_ptr expr, step_t time)
         throw IllegalTime(time);
 
     Expr_ptr vexpr
-        (f_frames[time]->value(expr));
+        (operator[](time).value(expr));
 
     return vexpr;
 }
@@ -250,7 +471,106 @@ bool Witness::has_value( Expr_ptr expr, step_t time)
         time > last_time())
         return false;
 
-    return f_frames[time]->has_value(expr);
+    return operator[](time).has_value(expr);
+}
+
+void Witness::set_snapshot(WitnessSnapshot_ptr snapshot)
+{
+    assert(! f_snapshot);
+    assert(snapshot->nrows() == f_frames.size());
+
+    f_snapshot = snapshot;
+    f_pending_variables.assign(f_frames.size(), true);
+    f_pending_defines.assign(f_frames.size(), true);
+    f_npending = 2 * f_frames.size();
+}
+
+void Witness::materialize(step_t index, Expr_ptr expr)
+{
+    if (! f_snapshot)
+        return;
+
+    /* decoding may complete the decoding of the witness, and drop the
+       snapshot from under our feet */
+    WitnessSnapshot_ptr snapshot
+        (f_snapshot);
+
+    const WitnessExtractor& extractor
+        (snapshot->extractor());
+
+    TimeFrame& tf
+        (f_frames[index]);
+
+    if (f_pending_variables[index]) {
+        f_pending_variables[index] = false;
+        -- f_npending;
+
+        const WitnessSymbols& variables
+            (extractor.variables());
+
+        for (unsigned i = 0; i < variables.size(); ++ i) {
+            const WitnessSymbol& var
+                (variables[i]);
+
+            if (! snapshot->monitors() &&
+                var.symb->as_variable().is_monitor())
+                continue;
+
+            Expr_ptr value
+                (snapshot->value(i, index));
+
+            /* NULL values here indicate UNDEFs */
+            if (value)
+                tf.set_value( var.key, value, var.symb->format());
+        }
+    }
+
+    if (f_pending_defines[index] &&
+        (! expr || extractor.is_define(expr))) {
+        f_pending_defines[index] = false;
+        -- f_npending;
+
+        /* a private evaluator, this may be called while the manager's
+           one is busy */
+        Evaluator evaluator
+            (WitnessMgr::INSTANCE());
+
+        const WitnessSymbols& defines
+            (extractor.defines());
+
+        for (WitnessSymbols::const_iterator i = defines.begin();
+             defines.end() != i; ++ i) {
+
+            const Define& define
+                (i->symb->as_define());
+
+            try {
+                Expr_ptr value
+                    (evaluator.process( *this, i->ctx, define.body(),
+                                        f_j + index));
+
+                /* NULL values here indicate UNDEFs */
+                if (value)
+                    tf.set_value( i->key, value, i->symb->format());
+            }
+
+            catch (NoValue& nv) {
+            }
+        }
+    }
+
+    /* all decoded, the snapshot is no longer needed */
+    if (! f_npending && f_snapshot) {
+        DEBUG
+            << "Witness "
+            << f_id
+            << " fully decoded, dropping snapshot"
+            << std::endl;
+
+        f_snapshot.reset();
+        f_pending_variables.clear();
+        f_pending_defines.clear();
+    }
 }
 
 /* Engine registration can be done only once */
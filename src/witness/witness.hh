@@ -29,9 +29,11 @@
 
 #include <common/common.hh>
 
+#include <deque>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <expr/expr.hh>
 #include <expr/expr_mgr.hh>
@@ -51,20 +53,96 @@
 #include <utils/variant.hh>
 
 #include <witness/exceptions.hh>
+#include <witness/extractor.hh>
 
-typedef boost::unordered_map<Expr_ptr, Expr_ptr, PtrHash, PtrEq> Expr2ExprMap;
-typedef Expr2ExprMap::iterator Expr2ExprMapIterator;
+typedef boost::unordered_map<Expr_ptr, unsigned, PtrHash, PtrEq> Expr2CodeMap;
+typedef Expr2CodeMap::iterator Expr2CodeMapIterator;
 
-typedef boost::unordered_map<Expr_ptr, value_format_t, PtrHash, PtrEq> Expr2FormatMap;
-typedef Expr2FormatMap::iterator Expr2FormatMapIterator;
+/* A column of the witness layout: the values taken by a symbol, each
+   one stored once. Codes are 1-based, 0 stands for no value. */
+struct WitnessColumnLayout {
+    Expr_ptr expr;
+    value_format_t format;
+
+    ExprVector values;
+    Expr2CodeMap codes;
+
+    WitnessColumnLayout(Expr_ptr expr_, value_format_t format_)
+        : expr(expr_)
+        , format(format_)
+    {}
+};
+
+/* Symbol layout of a witness: one column per symbol having a value in
+   any time frame. Layouts only grow, thus they can be shared among
+   duplicates of a witness. */
+class WitnessLayout {
+public:
+    WitnessLayout();
+    ~WitnessLayout();
+
+    /* Column for expr, created if needed */
+    unsigned column(Expr_ptr expr, value_format_t format);
+
+    /* Returns true iff expr has a column, and sets it */
+    bool find_column(Expr_ptr expr, unsigned& column) const;
+
+    inline unsigned ncolumns() const
+    { return f_columns.size(); }
+
+    inline Expr_ptr expr(unsigned column) const
+    { return f_columns[column].expr; }
+
+    inline value_format_t format(unsigned column) const
+    { return f_columns[column].format; }
+
+    /* Code of value in column, added if needed */
+    unsigned encode(unsigned column, Expr_ptr value);
+
+    inline Expr_ptr decode(unsigned column, unsigned code) const
+    {
+        assert(0 < code);
+        return f_columns[column].values[code -1];
+    }
+
+private:
+    std::vector<WitnessColumnLayout> f_columns;
+    Expr2CodeMap f_index;
+};
+
+typedef boost::shared_ptr<WitnessLayout> WitnessLayout_ptr;
+
+/* Codes of a column, one per time frame, packed in words. Codes are 1,
+   2, 4, 8, 16 or 32 bits wide, and never cross a word boundary; the
+   width grows with the number of values of the column. */
+class WitnessColumn {
+public:
+    WitnessColumn();
+
+    unsigned code(step_t frame) const;
+    void set_code(step_t frame, unsigned code);
+
+    inline unsigned width() const
+    { return f_width; }
+
+private:
+    unsigned f_width;
+    std::vector<uint64_t> f_words;
+
+    void widen(unsigned width);
+};
+
+typedef std::vector<WitnessColumn> WitnessColumns;
 
 class Witness; // fwd decl
 
+/* A time frame is a view on one step of its witness, values are
+   stored in the witness' columns and decoded on demand. */
 typedef class TimeFrame* TimeFrame_ptr;
 class TimeFrame {
 
 public:
-    TimeFrame(Witness& owner);
+    TimeFrame(Witness& owner, step_t index);
     ~TimeFrame();
 
     /* Retrieves value for expr, throws an exception if no value exists. */
@@ -84,18 +162,15 @@ public:
     ExprVector assignments();
 
 private:
-    Expr2ExprMap f_map;
-    Expr2FormatMap f_format_map;
-
-    // forbid copy
-    TimeFrame(const TimeFrame &other)
-        : f_owner( other.f_owner)
-    { assert (false); }
-
     Witness& f_owner;
+
+    /* index of this frame in the owner, regardless of first_time() */
+    step_t f_index;
 };
 
-typedef std::vector<TimeFrame_ptr> TimeFrames;
+/* frames are never moved once appended, references to them remain
+   valid as the witness grows */
+typedef std::deque<TimeFrame> TimeFrames;
 
 typedef class Witness* Witness_ptr;
 class Witness {
@@ -105,6 +180,9 @@ public:
             Atom desc = "<No description>",
             step_t j = 0);
 
+    /* Duplicates w: the layout is shared, columns are copied */
+    Witness(const Witness& w);
+
     /* data storage */
     inline TimeFrames& frames()
     { return f_frames; }
@@ -141,7 +219,19 @@ public:
     inline ExprVector& lang()
     { return f_lang; }
 
-    /* Extends trace by k appending the given one, yields last timeframe */
+    /* Lasso witnesses: the last time frame is followed by the one at
+       loop_time(), cfr. LTL counterexamples */
+    inline bool has_loop() const
+    { return UINT_MAX != f_loop; }
+
+    inline step_t loop_time() const
+    { assert(has_loop()); return f_loop; }
+
+    inline void set_loop(step_t time)
+    { f_loop = time; }
+
+    /* Extends trace by k appending the given one, yields last
+       timeframe. Values are moved out of w, which is left empty. */
     TimeFrame& extend(Witness& w);
 
     /* Extends trace by 1 steps, yields new step */
@@ -166,9 +256,25 @@ protected:
     /* Timeframes (list) */
     TimeFrames f_frames;
 
+    /* Values storage, one column per symbol of the layout */
+    WitnessLayout_ptr f_layout;
+    WitnessColumns f_columns;
+
+    /* Lazy witnesses: raw values of the SAT model, decoded into the
+       columns when a frame is first inspected. Shared by duplicates,
+       dropped once all the frames are decoded. Variables and DEFINEs
+       of a frame are decoded separately, cfr. materialize() */
+    WitnessSnapshot_ptr f_snapshot;
+    std::vector<bool> f_pending_variables;
+    std::vector<bool> f_pending_defines;
+    step_t f_npending;
+
     /* Language (i.e. full list of symbols) */
     ExprVector f_lang;
 
+    /* loop back time, UINT_MAX if none */
+    step_t f_loop;
+
     /* An engine that can be used to extend this witness. This is not
        necessarily the engine that created the trace. Ordinarily it
        should be a simulation engine. */
@@ -184,6 +290,25 @@ protected:
     }
 
     void register_engine(Engine& e);
+
+    /* Frames are decoded from snapshot on demand, one per row. To be
+       called once all the frames have been appended. */
+    void set_snapshot(WitnessSnapshot_ptr snapshot);
+
+private:
+    friend class TimeFrame;
+
+    /* Decodes from the snapshot what is needed to get the value of
+       expr in frame index, all of the frame if expr is NULL. Values of
+       variables never require DEFINEs to be decoded, thus evaluating
+       DEFINEs only ever decodes variables of other frames. */
+    void materialize(step_t index, Expr_ptr expr = NULL);
+
+    /* Code of expr in frame index, 0 if none */
+    unsigned code(Expr_ptr expr, step_t index) const;
+
+    // forbid assignment
+    Witness& operator=(const Witness& other);
 };
 
 class WitnessPrinter {
@@ -25,6 +25,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <stdint.h>
+#include <sstream>
 
 #include <expr.hh>
 #include <expr_mgr.hh>
@@ -113,6 +114,96 @@ static void callback(void *obj, int* list, int size)
   pchecker->add(tmp);
 }
 
+typedef boost::unordered_map<DdNode*, unsigned, PtrHash, PtrEq> DDNodeIds;
+
+/* dd, with variables named after their UCBIs. Nodes are numbered in
+   the order they are visited, so that dumps of DDs built in different
+   runs can be compared. */
+static unsigned dump_dd(std::ostream& os, DdNode* node, DDNodeIds& ids)
+{
+    DDNodeIds::const_iterator eye
+        (ids.find(node));
+
+    if (ids.end() != eye)
+        return eye->second;
+
+    std::ostringstream tmp;
+    if (Cudd_IsConstant(node))
+        tmp << Cudd_V(node);
+
+    else {
+        unsigned then_
+            (dump_dd(os, cuddT(node), ids));
+        unsigned else_
+            (dump_dd(os, cuddE(node), ids));
+
+        tmp
+            << EncodingMgr::INSTANCE().find_ucbi(node->index)
+            << " ? " << then_ << " : " << else_;
+    }
+
+    unsigned res
+        (ids.size());
+
+    ids.insert(std::pair<DdNode*, unsigned>(node, res));
+    os << res << " = " << tmp.str() << std::endl;
+
+    return res;
+}
+
+static void dump_dds(std::ostream& os, const DDVector& dv, DDNodeIds& ids)
+{
+    for (DDVector::const_iterator i = dv.begin(); dv.end() != i; ++ i)
+        os << "-> " << dump_dd(os, i->getNode(), ids) << std::endl;
+}
+
+/* all the DDs of unit */
+static std::string dump_unit(const CompilationUnit& unit)
+{
+    std::ostringstream oss;
+    DDNodeIds ids;
+
+    dump_dds(oss, unit.dds(), ids);
+
+    const InlinedOperatorDescriptors& inlined
+        (unit.inlined_operator_descriptors());
+    for (InlinedOperatorDescriptors::const_iterator i = inlined.begin();
+         inlined.end() != i; ++ i) {
+        oss << "inlined" << std::endl;
+        dump_dds(oss, i->z(), ids);
+        dump_dds(oss, i->x(), ids);
+        dump_dds(oss, i->y(), ids);
+    }
+
+    const Expr2BinarySelectionDescriptorsMap& bsd_map
+        (unit.binary_selection_descriptors_map());
+    for (Expr2BinarySelectionDescriptorsMap::const_iterator i = bsd_map.begin();
+         bsd_map.end() != i; ++ i)
+        for (BinarySelectionDescriptors::const_iterator j = i->second.begin();
+             i->second.end() != j; ++ j) {
+            oss << "ite " << i->first << std::endl;
+            dump_dds(oss, j->z(), ids);
+            oss
+                << "-> " << dump_dd(oss, j->cnd().getNode(), ids) << std::endl
+                << "-> " << dump_dd(oss, j->aux().getNode(), ids) << std::endl;
+            dump_dds(oss, j->x(), ids);
+            dump_dds(oss, j->y(), ids);
+        }
+
+    const MultiwaySelectionDescriptors& muxes
+        (unit.array_mux_descriptors());
+    for (MultiwaySelectionDescriptors::const_iterator i = muxes.begin();
+         muxes.end() != i; ++ i) {
+        oss << "mux" << std::endl;
+        dump_dds(oss, i->z(), ids);
+        dump_dds(oss, i->cnds(), ids);
+        dump_dds(oss, i->acts(), ids);
+        dump_dds(oss, i->x(), ids);
+    }
+
+    return oss.str();
+}
+
 BOOST_AUTO_TEST_SUITE(tests)
 BOOST_AUTO_TEST_CASE(compiler_boolean)
 {
@@ -422,4 +513,91 @@ BOOST_AUTO_TEST_CASE(compiler_boolean)
     }
 }
 
+/* Units compiled by a pool of workers are the same as the ones
+   compiled by a single worker, regardless of the number of workers. */
+BOOST_AUTO_TEST_CASE(compiler_parallel_determinism)
+{
+    ModelMgr& mm
+        (ModelMgr::INSTANCE());
+
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    TypeMgr& tm
+        (TypeMgr::INSTANCE());
+
+    Model& model
+        (mm.model());
+
+    Atom a_main("main");
+    Expr_ptr main_expr(em.make_identifier(a_main));
+
+    Module_ptr main_module;
+    Modules::const_iterator mi
+        (model.modules().find(main_expr));
+
+    if (model.modules().end() != mi)
+        main_module = mi->second;
+    else {
+        main_module = new Module(main_expr);
+        model.add_module(*main_module);
+    }
+
+    Type_ptr boolean = tm.find_boolean();
+    Type_ptr u4 = tm.find_unsigned(4);
+
+    Atom a_pa("pa"); Expr_ptr pa = em.make_identifier(a_pa);
+    main_module->add_var(pa, new Variable(main_expr, pa, boolean));
+
+    Atom a_pc("pc"); Expr_ptr pc = em.make_identifier(a_pc);
+    main_module->add_var(pc, new Variable(main_expr, pc, u4));
+
+    Atom a_pd("pd"); Expr_ptr pd = em.make_identifier(a_pd);
+    main_module->add_var(pd, new Variable(main_expr, pd, u4));
+
+    Atom a_pe("pe"); Expr_ptr pe = em.make_identifier(a_pe);
+    main_module->add_var(pe, new Variable(main_expr, pe, u4));
+
+    Expr_ptr ctx
+        (em.make_empty());
+
+    const Expr_ptr bodies[] = {
+        em.make_eq(em.make_add(pc, pd), pe),
+        em.make_eq(em.make_ite(em.make_cond(pa, pc), pd), pe),
+        em.make_eq(em.make_next(pc), em.make_mul(pc, pd)),
+        em.make_implies(pa, em.make_ne(pc, pd)),
+        em.make_ge(em.make_sub(pc, pd), pe),
+        em.make_ne(em.make_ite(em.make_cond(em.make_not(pa), pd), pe), pc),
+    };
+
+    CompilationKeys keys;
+    for (unsigned i = 0; i < sizeof(bodies) / sizeof(bodies[0]); ++ i)
+        keys.push_back(CompilationKey(ctx, bodies[i]));
+
+    std::vector<std::string> expected;
+
+    const unsigned nworkers[] = { 1, 2, 4 };
+    for (unsigned n = 0; n < sizeof(nworkers) / sizeof(nworkers[0]); ++ n) {
+        Compiler compiler;
+
+        CompilationUnitMap units;
+        compiler.process(keys, nworkers[n], units);
+        BOOST_REQUIRE(keys.size() == units.size());
+
+        for (unsigned i = 0; i < keys.size(); ++ i) {
+            CompilationUnitMap::const_iterator eye
+                (units.find(keys[i]));
+            BOOST_REQUIRE(units.end() != eye);
+
+            std::string dump
+                (dump_unit(eye->second));
+
+            if (0 == n)
+                expected.push_back(dump);
+            else
+                BOOST_CHECK(expected[i] == dump);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,13 +24,148 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <expr.hh>
 #include <expr_mgr.hh>
 #include <printer.hh>
 
+#include <enc/enc.hh>
+#include <enc/enc_mgr.hh>
+
+#include <type/type_mgr.hh>
+
+/* Decodes all the bit patterns of enc both ways: from the values of
+   its bits (bits_expr), and by evaluating its DDs on the equivalent
+   assignment of DD variables (expr). Returns the number of patterns
+   encoding a value. */
+static unsigned check_parity(Encoding_ptr enc)
+{
+    EncodingMgr& bm
+        (EncodingMgr::INSTANCE());
+
+    DDVector& bits
+        (enc->bits());
+
+    unsigned nbits
+        (bits.size());
+    assert(nbits <= 16);
+
+    std::vector<int> assignment
+        (bm.nbits(), 0);
+
+    std::vector<int> values
+        (nbits, 0);
+
+    unsigned res
+        (0);
+
+    for (unsigned pattern = 0; pattern < (1U << nbits); ++ pattern) {
+        for (unsigned i = 0; i < nbits; ++ i) {
+            values[i] = (pattern >> (nbits - 1 - i)) & 1;
+            assignment[bits[i].getNode()->index] = values[i];
+        }
+
+        Expr_ptr value
+            (enc->bits_expr(&values[0]));
+
+        /* e.g. enum patterns beyond the last literal */
+        if (! value)
+            continue;
+
+        ++ res;
+        BOOST_CHECK(value == enc->expr(&assignment[0]));
+    }
+
+    return res;
+}
+
 BOOST_AUTO_TEST_SUITE(tests)
-BOOST_AUTO_TEST_CASE(enc)
+BOOST_AUTO_TEST_CASE(enc_bits_expr_parity)
 {
-    // TODO
+    EncodingMgr& bm
+        (EncodingMgr::INSTANCE());
+
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    TypeMgr& tm
+        (TypeMgr::INSTANCE());
+
+    /* booleans */
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_boolean()));
+
+        BOOST_CHECK(2 == check_parity(enc));
+
+        const int t[] = { 1 };
+        BOOST_CHECK(em.make_true() == enc->bits_expr(t));
+    }
+
+    /* unsigned and signed ints, msb first */
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_unsigned(4)));
+
+        BOOST_CHECK(16 == check_parity(enc));
+
+        const int ten[] = { 1, 0, 1, 0 };
+        BOOST_CHECK(em.make_const(10) == enc->bits_expr(ten));
+    }
+
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_signed(4)));
+
+        BOOST_CHECK(16 == check_parity(enc));
+
+        const int minus_one[] = { 1, 1, 1, 1 };
+        BOOST_CHECK(em.make_neg(em.make_const(1)) == enc->bits_expr(minus_one));
+
+        const int seven[] = { 0, 1, 1, 1 };
+        BOOST_CHECK(em.make_const(7) == enc->bits_expr(seven));
+    }
+
+    /* enums, 2 bits for 3 literals */
+    ExprSet lits;
+    lits.insert(em.make_identifier("huey"));
+    lits.insert(em.make_identifier("louie"));
+    lits.insert(em.make_identifier("dewey"));
+
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_enum(lits)));
+
+        BOOST_CHECK(2 == enc->bits().size());
+        BOOST_CHECK(3 == check_parity(enc));
+
+        const int beyond[] = { 1, 1 };
+        BOOST_CHECK(NULL == enc->bits_expr(beyond));
+    }
+
+    /* arrays, element bits one after the other */
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_unsigned_array(2, 3)));
+
+        BOOST_CHECK(6 == enc->bits().size());
+        BOOST_CHECK(64 == check_parity(enc));
+    }
+
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_signed_array(3, 2)));
+
+        BOOST_CHECK(64 == check_parity(enc));
+    }
+
+    {
+        Encoding_ptr enc
+            (bm.make_encoding(tm.find_enum_array(lits, 2)));
+
+        BOOST_CHECK(4 == enc->bits().size());
+        BOOST_CHECK(9 == check_parity(enc));
+    }
 }
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,204 @@
+/**
+ * @file test_ltl.cc
+ * @brief LTL tableau unit tests.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <expr.hh>
+#include <expr_mgr.hh>
+
+#include <algorithms/ltl/tableau.hh>
+
+BOOST_AUTO_TEST_SUITE(tests)
+
+/* Negations are pushed down to the atoms, temporal operators are
+   dualized on the way. */
+BOOST_AUTO_TEST_CASE(ltl_tableau_nnf)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr x
+        (em.make_identifier("x"));
+
+    Expr_ptr y
+        (em.make_identifier("y"));
+
+    Expr_ptr not_x
+        (em.make_not(x));
+
+    Expr_ptr not_y
+        (em.make_not(y));
+
+    /* !(G F x) is F G !x */
+    {
+        LTLTableau tableau
+            (em);
+
+        unsigned root
+            (tableau.process(em.make_G(em.make_F(x)), true));
+
+        const LTLNode& f
+            (tableau.node(root));
+        BOOST_CHECK(LTL_F == f.op);
+        BOOST_CHECK(em.make_F(em.make_G(not_x)) == f.expr);
+
+        const LTLNode& g
+            (tableau.node(f.lhs));
+        BOOST_CHECK(LTL_G == g.op);
+
+        const LTLNode& atom
+            (tableau.node(g.lhs));
+        BOOST_CHECK(LTL_ATOM == atom.op);
+        BOOST_CHECK(not_x == atom.expr);
+    }
+
+    /* !(x U y) is !x R !y, !(X x) is X !x */
+    {
+        LTLTableau tableau
+            (em);
+
+        unsigned root
+            (tableau.process(em.make_U(x, y), true));
+
+        const LTLNode& r
+            (tableau.node(root));
+        BOOST_CHECK(LTL_R == r.op);
+        BOOST_CHECK(em.make_R(not_x, not_y) == r.expr);
+        BOOST_CHECK(not_x == tableau.node(r.lhs).expr);
+        BOOST_CHECK(not_y == tableau.node(r.rhs).expr);
+
+        root = tableau.process(em.make_X(x), true);
+        BOOST_CHECK(LTL_X == tableau.node(root).op);
+        BOOST_CHECK(em.make_X(not_x) == tableau.node(root).expr);
+    }
+
+    /* !G (x -> F y) is F (x & G !y) */
+    {
+        LTLTableau tableau
+            (em);
+
+        unsigned root
+            (tableau.process(em.make_G(em.make_implies(x, em.make_F(y))),
+                             true));
+
+        const LTLNode& f
+            (tableau.node(root));
+        BOOST_CHECK(LTL_F == f.op);
+
+        const LTLNode& conj
+            (tableau.node(f.lhs));
+        BOOST_CHECK(LTL_AND == conj.op);
+        BOOST_CHECK(x == tableau.node(conj.lhs).expr);
+
+        const LTLNode& g
+            (tableau.node(conj.rhs));
+        BOOST_CHECK(LTL_G == g.op);
+        BOOST_CHECK(not_y == tableau.node(g.lhs).expr);
+    }
+
+    /* propositional subformulas are kept whole, as a single atom */
+    {
+        LTLTableau tableau
+            (em);
+
+        Expr_ptr x_and_y
+            (em.make_and(x, y));
+
+        unsigned root
+            (tableau.process(em.make_G(x_and_y)));
+
+        const LTLNode& g
+            (tableau.node(root));
+        BOOST_CHECK(LTL_G == g.op);
+        BOOST_CHECK(LTL_ATOM == tableau.node(g.lhs).op);
+        BOOST_CHECK(x_and_y == tableau.node(g.lhs).expr);
+        BOOST_CHECK(2 == tableau.nodes().size());
+    }
+}
+
+/* Nodes are shared: a formula and its double negation have the same
+   root, and the negation of a node is computed once. */
+BOOST_AUTO_TEST_CASE(ltl_tableau_sharing)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr x
+        (em.make_identifier("x"));
+
+    Expr_ptr y
+        (em.make_identifier("y"));
+
+    Expr_ptr phi
+        (em.make_F(em.make_U(x, em.make_G(y))));
+
+    LTLTableau tableau
+        (em);
+
+    unsigned root
+        (tableau.process(phi));
+
+    unsigned nnodes
+        (tableau.nodes().size());
+
+    BOOST_CHECK(root == tableau.process(em.make_not(phi), true));
+    BOOST_CHECK(root == tableau.process(phi));
+
+    unsigned negated
+        (tableau.process(phi, true));
+    BOOST_CHECK(root != negated);
+    BOOST_CHECK(negated == tableau.process(em.make_not(phi)));
+
+    /* the negation adds one node per node of phi, no more */
+    BOOST_CHECK(2 * nnodes == tableau.nodes().size());
+}
+
+/* Temporal operators under arithmetics, and time shifts, have no NNF */
+BOOST_AUTO_TEST_CASE(ltl_tableau_unsupported)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr x
+        (em.make_identifier("x"));
+
+    {
+        LTLTableau tableau
+            (em);
+
+        BOOST_CHECK_THROW(tableau.process(em.make_add(em.make_G(x),
+                                                      em.make_const(1))),
+                          UnsupportedLTLFormula);
+    }
+
+    {
+        LTLTableau tableau
+            (em);
+
+        BOOST_CHECK_THROW(tableau.process(em.make_G(em.make_next(x))),
+                          UnsupportedLTLFormula);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,269 @@
+/**
+ * @file test_sat.cc
+ * @brief SAT subsystem unit tests.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include <expr.hh>
+#include <expr_mgr.hh>
+
+#include <enc/ucbi.hh>
+#include <enc/tcbi.hh>
+
+#include <sat/registry.hh>
+#include <sat/backend.hh>
+#include <sat/exchange.hh>
+
+BOOST_AUTO_TEST_SUITE(tests)
+
+BOOST_AUTO_TEST_CASE(sat_timed_var_registry)
+{
+    TimedVarRegistry registry;
+
+    BOOST_CHECK(VAR_UNDEF == registry.find(0, 0));
+
+    registry.insert(3, 0, 42);
+    registry.insert(3, UINT_MAX, 43);
+    registry.insert(0, 7, 44);
+
+    BOOST_CHECK(42 == registry.find(3, 0));
+    BOOST_CHECK(43 == registry.find(3, UINT_MAX));
+    BOOST_CHECK(44 == registry.find(0, 7));
+    BOOST_CHECK(VAR_UNDEF == registry.find(2, 0));
+    BOOST_CHECK(VAR_UNDEF == registry.find(3, 1));
+    BOOST_CHECK(3 == registry.nframes());
+    BOOST_CHECK(3 == registry.size());
+
+    registry.clear();
+    BOOST_CHECK(VAR_UNDEF == registry.find(3, 0));
+    BOOST_CHECK(0 == registry.nframes());
+
+    registry.insert(3, 1, 45);
+    BOOST_CHECK(45 == registry.find(3, 1));
+}
+
+BOOST_AUTO_TEST_CASE(sat_tcbi_registry)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr x
+        (em.make_identifier("x"));
+
+    TCBIRegistry registry;
+
+    /* x@1 at timebase 0 and x@0 at timebase 1 are the same bit */
+    const TCBI next_x
+        (UCBI(x, 1, 0), 0);
+    const TCBI curr_x
+        (UCBI(x, 0, 0), 1);
+
+    BOOST_CHECK(VAR_UNDEF == registry.find(next_x));
+    registry.insert(next_x, 1);
+
+    BOOST_CHECK(1 == registry.find(next_x));
+    BOOST_CHECK(1 == registry.find(curr_x));
+    BOOST_CHECK(VAR_UNDEF == registry.find(TCBI(UCBI(x, 0, 1), 1)));
+    BOOST_CHECK(VAR_UNDEF == registry.find(TCBI(UCBI(x, 0, 0), 0)));
+
+    BOOST_CHECK(x == registry.tcbi(1).expr());
+    BOOST_CHECK(1 == registry.tcbi(1).absolute_time());
+}
+
+/* Deep unrollings: every booked bit is found at every depth, with
+   the var it was booked with, one row per time frame. */
+BOOST_AUTO_TEST_CASE(sat_tcbi_registry_depth)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    const unsigned nvars (8);
+    const unsigned width (16);
+
+    ExprVector vars;
+    for (unsigned i = 0; i < nvars; ++ i) {
+        std::ostringstream oss;
+        oss << "depth_" << i;
+        vars.push_back(em.make_identifier(oss.str()));
+    }
+
+    const step_t depths[] = { 1, 10, 50, 200 };
+    for (unsigned d = 0; d < sizeof(depths) / sizeof(depths[0]); ++ d) {
+        step_t k
+            (depths[d]);
+
+        TCBIRegistry registry;
+        Var var (0);
+
+        for (step_t time = 0; time <= k; ++ time)
+            for (unsigned i = 0; i < nvars; ++ i)
+                for (unsigned bit = 0; bit < width; ++ bit)
+                    registry.insert(TCBI(UCBI(vars[i], 0, bit), time), var ++);
+
+        BOOST_CHECK(1 + k == registry.nframes());
+        BOOST_CHECK((1 + k) * nvars * width == registry.size());
+
+        unsigned misses (0);
+        var = 0;
+        for (step_t time = 0; time <= k; ++ time)
+            for (unsigned i = 0; i < nvars; ++ i)
+                for (unsigned bit = 0; bit < width; ++ bit) {
+                    const TCBI tcbi
+                        (UCBI(vars[i], 0, bit), time);
+
+                    if (var != registry.find(tcbi) ||
+                        time != registry.tcbi(var).absolute_time())
+                        ++ misses;
+
+                    ++ var;
+                }
+
+        BOOST_CHECK(0 == misses);
+
+        /* beyond the unrolling, and beyond the width */
+        BOOST_CHECK(VAR_UNDEF == registry.find(TCBI(UCBI(vars[0], 0, 0), 1 + k)));
+        BOOST_CHECK(VAR_UNDEF == registry.find(TCBI(UCBI(vars[0], 0, width), 0)));
+    }
+}
+
+/* 3 pigeons, 2 holes, enabled by selector. UNSAT, with conflicts */
+static Var pigeonhole(SATBackend& backend)
+{
+    Var selector
+        (backend.new_var());
+
+    Var p[3][2];
+    for (unsigned i = 0; i < 3; ++ i)
+        for (unsigned j = 0; j < 2; ++ j)
+            p[i][j] = backend.new_var();
+
+    vec<Lit> clause;
+    for (unsigned i = 0; i < 3; ++ i) {
+        clause.clear();
+        clause.push(mkLit(selector, true));
+        clause.push(mkLit(p[i][0]));
+        clause.push(mkLit(p[i][1]));
+        backend.add_clause(clause);
+    }
+
+    for (unsigned j = 0; j < 2; ++ j)
+        for (unsigned i = 0; i < 3; ++ i)
+            for (unsigned k = 1 + i; k < 3; ++ k) {
+                clause.clear();
+                clause.push(mkLit(selector, true));
+                clause.push(mkLit(p[i][j], true));
+                clause.push(mkLit(p[k][j], true));
+                backend.add_clause(clause);
+            }
+
+    return selector;
+}
+
+/* negative budgets mean no limit, also after conflicts have been
+   counted by previous solve() calls. The core backend is used, as
+   variable elimination could settle the instances without search. */
+BOOST_AUTO_TEST_CASE(sat_backend_unlimited_budget)
+{
+    SATBackend_ptr backend
+        (make_sat_backend("core"));
+
+    Var first
+        (pigeonhole(*backend));
+    Var second
+        (pigeonhole(*backend));
+    Var third
+        (pigeonhole(*backend));
+
+    vec<Lit> assumptions;
+    assumptions.push(mkLit(first));
+    BOOST_CHECK(STATUS_UNSAT == backend->solve(assumptions));
+
+    backend->set_budget(-1, -1);
+
+    assumptions.clear();
+    assumptions.push(mkLit(second));
+    BOOST_CHECK(STATUS_UNSAT == backend->solve(assumptions));
+
+    /* an exhausted budget stops the search */
+    backend->set_budget(0, -1);
+
+    assumptions.clear();
+    assumptions.push(mkLit(third));
+    BOOST_CHECK(STATUS_UNKNOWN == backend->solve(assumptions));
+
+    delete backend;
+}
+
+/* Readers get the clauses published by others, the channel only
+   retains the clauses some reader has not fetched yet. */
+BOOST_AUTO_TEST_CASE(sat_clause_exchange)
+{
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    Expr_ptr x
+        (em.make_identifier("x"));
+
+    ClauseExchange exchange
+        (8, 2);
+
+    int a, b;
+    exchange.subscribe(&a);
+    exchange.subscribe(&b);
+
+    SharedClauses clauses;
+    for (unsigned i = 0; i < 3; ++ i) {
+        SharedClause clause;
+        clause.push_back(SharedLit(TCBI(UCBI(x, 0, i), 0), false));
+        clauses.push_back(SharedClause_ptr(new SharedClause(clause)));
+    }
+
+    exchange.publish(&a, clauses);
+    BOOST_CHECK(3 == exchange.size());
+    BOOST_CHECK(3 == exchange.retained());
+
+    /* a skips its own clauses, b has not fetched them yet */
+    SharedClauses out;
+    exchange.fetch(&a, out);
+    BOOST_CHECK(out.empty());
+    BOOST_CHECK(3 == exchange.retained());
+
+    exchange.fetch(&b, out);
+    BOOST_CHECK(3 == out.size());
+    BOOST_CHECK(clauses[0] == out[0]);
+    BOOST_CHECK(0 == exchange.retained());
+
+    /* a reader that is gone holds nothing back */
+    exchange.publish(&b, clauses);
+    exchange.unsubscribe(&a);
+
+    out.clear();
+    exchange.fetch(&b, out);
+    BOOST_CHECK(out.empty());
+    BOOST_CHECK(0 == exchange.retained());
+    BOOST_CHECK(6 == exchange.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/**
+ * @file test_witness.cc
+ * @brief Witness subsystem unit tests.
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <climits>
+
+#include <witness/witness.hh>
+
+/* largest code fitting in width bits */
+static unsigned max_code(unsigned width)
+{
+    return 32 == width ? UINT_MAX : (1U << width) - 1;
+}
+
+BOOST_AUTO_TEST_SUITE(tests)
+
+/* 1 bit codes, 64 frames per word */
+BOOST_AUTO_TEST_CASE(witness_column_packing)
+{
+    WitnessColumn column;
+
+    BOOST_CHECK(1 == column.width());
+    BOOST_CHECK(0 == column.code(0));
+    BOOST_CHECK(0 == column.code(1000));
+
+    for (step_t frame = 0; frame < 200; ++ frame)
+        if (frame % 3)
+            column.set_code(frame, 1);
+
+    BOOST_CHECK(1 == column.width());
+    for (step_t frame = 0; frame < 200; ++ frame)
+        BOOST_CHECK((frame % 3 ? 1 : 0) == column.code(frame));
+
+    /* no value past the last frame set */
+    BOOST_CHECK(0 == column.code(200));
+    BOOST_CHECK(0 == column.code(1000));
+
+    /* codes are overwritten, neighbours untouched */
+    column.set_code(64, 0);
+    BOOST_CHECK(0 == column.code(64));
+    BOOST_CHECK(1 == column.code(65));
+    BOOST_CHECK(0 == column.code(63));
+    BOOST_CHECK(1 == column.code(62));
+}
+
+/* Codes set before the column is widened are kept */
+BOOST_AUTO_TEST_CASE(witness_column_widen)
+{
+    WitnessColumn column;
+
+    for (step_t frame = 0; frame < 100; ++ frame)
+        column.set_code(frame, frame % 2);
+    BOOST_CHECK(1 == column.width());
+
+    column.set_code(100, 3);
+    BOOST_CHECK(2 == column.width());
+
+    column.set_code(101, 200);
+    BOOST_CHECK(8 == column.width());
+
+    column.set_code(102, 70000);
+    BOOST_CHECK(32 == column.width());
+
+    for (step_t frame = 0; frame < 100; ++ frame)
+        BOOST_CHECK(frame % 2 == column.code(frame));
+
+    BOOST_CHECK(3 == column.code(100));
+    BOOST_CHECK(200 == column.code(101));
+    BOOST_CHECK(70000 == column.code(102));
+    BOOST_CHECK(0 == column.code(103));
+
+    /* a smaller code does not narrow the column */
+    column.set_code(103, 1);
+    BOOST_CHECK(32 == column.width());
+    BOOST_CHECK(1 == column.code(103));
+}
+
+/* For each width, the frames around word boundaries are read back
+   exactly, with all the bits of the code set. */
+BOOST_AUTO_TEST_CASE(witness_column_word_boundaries)
+{
+    const unsigned widths[] = { 1, 2, 4, 8, 16, 32 };
+
+    for (unsigned w = 0; w < sizeof(widths) / sizeof(widths[0]); ++ w) {
+        unsigned width
+            (widths[w]);
+
+        unsigned per_word
+            (64 / width);
+
+        unsigned top
+            (max_code(width));
+
+        WitnessColumn column;
+        column.set_code(0, top);
+        BOOST_CHECK(width == column.width());
+
+        const step_t frames[] = {
+            per_word - 1, per_word, 2 * per_word - 1, 2 * per_word,
+        };
+
+        for (unsigned i = 0; i < 4; ++ i)
+            column.set_code(frames[i], top - i % 2);
+
+        BOOST_CHECK(top == column.code(0));
+        for (unsigned i = 0; i < 4; ++ i)
+            BOOST_CHECK(top - i % 2 == column.code(frames[i]));
+
+        /* frames next to the boundaries hold no value, with two
+           codes per word the frames set are all adjacent */
+        if (2 < per_word) {
+            BOOST_CHECK(0 == column.code(per_word - 2));
+            BOOST_CHECK(0 == column.code(per_word + 1));
+        }
+        BOOST_CHECK(0 == column.code(2 * per_word + 1));
+
+        /* clearing a code leaves its neighbours alone */
+        column.set_code(per_word, 0);
+        BOOST_CHECK(0 == column.code(per_word));
+        BOOST_CHECK(top == column.code(per_word - 1));
+        BOOST_CHECK(top == column.code(2 * per_word - 1));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,210 @@
+/**
+ * @file bench_registry.cc
+ * @brief Timed variables registries micro-benchmark.
+ *
+ * This program measures the average cost of a TCBI lookup as the
+ * number of unrolled time frames grows, for the per-time-frame
+ * registries used by the Engine (TimedVarRegistry, TCBIRegistry) and
+ * for the hashed TCBI -> Var map they replace. The registries are
+ * expected to stay flat, regardless of the unrolling depth.
+ *
+ * Usage: yasmv_bench [nlookups]
+ *
+ * Copyright (C) 2012 Marco Pensallorto < marco AT pensallorto DOT gmail DOT com >
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ **/
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <boost/unordered_map.hpp>
+
+#include <common/common.hh>
+
+#include <expr.hh>
+#include <expr_mgr.hh>
+
+#include <enc/ucbi.hh>
+#include <enc/tcbi.hh>
+
+#include <sat/registry.hh>
+
+/* the TCBI -> Var mapping used by the Engine before the registries */
+typedef boost::unordered_map<TCBI, Var, TCBIHash, TCBIEq> HashedTCBIMap;
+
+static const unsigned nvars (32);
+static const unsigned width (32);
+
+/* nanoseconds per lookup, from a clock() interval */
+static double ns_per_lookup(clock_t t0, clock_t t1, unsigned nlookups)
+{
+    return 1e9 * (double) (t1 - t0) / (double) CLOCKS_PER_SEC / nlookups;
+}
+
+/* every lookup must hit, this also keeps the lookups from being
+   optimized away */
+static void check_hits(unsigned hits, unsigned nlookups)
+{
+    if (hits != nlookups) {
+        std::cerr
+            << "Expected " << nlookups << " hits, got " << hits
+            << std::endl;
+
+        exit(1);
+    }
+}
+
+/* lookups cycle over bits and time frames, so that consecutive
+   lookups never hit the same time frame */
+static double bench_timed_var_registry(step_t k, unsigned nlookups)
+{
+    TimedVarRegistry registry;
+    Var var (0);
+
+    for (step_t time = 0; time <= k; ++ time)
+        for (unsigned index = 0; index < nvars * width; ++ index)
+            registry.insert(index, time, var ++);
+
+    unsigned hits (0);
+    clock_t t0 = clock();
+    for (unsigned n = 0; n < nlookups; ++ n)
+        if (VAR_UNDEF != registry.find(n % (nvars * width), n % (1 + k)))
+            ++ hits;
+    clock_t t1 = clock();
+
+    check_hits(hits, nlookups);
+    return ns_per_lookup(t0, t1, nlookups);
+}
+
+static double bench_tcbi_registry(const ExprVector& vars, step_t k,
+                                  unsigned nlookups)
+{
+    TCBIRegistry registry;
+    Var var (0);
+
+    for (step_t time = 0; time <= k; ++ time)
+        for (unsigned i = 0; i < nvars; ++ i)
+            for (unsigned bit = 0; bit < width; ++ bit)
+                registry.insert(TCBI(UCBI(vars[i], 0, bit), time), var ++);
+
+    unsigned hits (0);
+    clock_t t0 = clock();
+    for (unsigned n = 0; n < nlookups; ++ n) {
+        const TCBI tcbi
+            (UCBI(vars[n % nvars], 0, (n / nvars) % width), n % (1 + k));
+
+        if (VAR_UNDEF != registry.find(tcbi))
+            ++ hits;
+    }
+    clock_t t1 = clock();
+
+    check_hits(hits, nlookups);
+    return ns_per_lookup(t0, t1, nlookups);
+}
+
+static double bench_hashed_map(const ExprVector& vars, step_t k,
+                               unsigned nlookups)
+{
+    HashedTCBIMap map;
+    Var var (0);
+
+    for (step_t time = 0; time <= k; ++ time)
+        for (unsigned i = 0; i < nvars; ++ i)
+            for (unsigned bit = 0; bit < width; ++ bit)
+                map.insert(std::pair<TCBI, Var>
+                           (TCBI(UCBI(vars[i], 0, bit), time), var ++));
+
+    unsigned hits (0);
+    clock_t t0 = clock();
+    for (unsigned n = 0; n < nlookups; ++ n) {
+        const TCBI tcbi
+            (UCBI(vars[n % nvars], 0, (n / nvars) % width), n % (1 + k));
+
+        if (map.end() != map.find(tcbi))
+            ++ hits;
+    }
+    clock_t t1 = clock();
+
+    check_hits(hits, nlookups);
+    return ns_per_lookup(t0, t1, nlookups);
+}
+
+int main(int argc, const char *argv[])
+{
+    unsigned nlookups
+        (1 < argc ? strtoul(argv[1], NULL, 10) : 1 << 22);
+
+    ExprMgr& em
+        (ExprMgr::INSTANCE());
+
+    ExprVector vars;
+    for (unsigned i = 0; i < nvars; ++ i) {
+        std::ostringstream oss;
+        oss << "bench_" << i;
+        vars.push_back(em.make_identifier(oss.str()));
+    }
+
+    std::cout
+        << nvars << " vars x " << width << " bits, "
+        << nlookups << " lookups per depth, ns per lookup"
+        << std::endl
+        << std::setw(8) << "k"
+        << std::setw(12) << "timed-var"
+        << std::setw(12) << "tcbi"
+        << std::setw(12) << "hashed"
+        << std::endl;
+
+    const step_t depths[] = { 1, 10, 50, 100, 200, 500, 1000 };
+    for (unsigned d = 0; d < sizeof(depths) / sizeof(depths[0]); ++ d) {
+        step_t k
+            (depths[d]);
+
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << std::setw(8) << k
+            << std::setw(12) << bench_timed_var_registry(k, nlookups)
+            << std::setw(12) << bench_tcbi_registry(vars, k, nlookups)
+            << std::setw(12) << bench_hashed_map(vars, k, nlookups)
+            << std::endl;
+    }
+
+    return 0;
+}
+
+/* logging subsystem settings */
+namespace axter {
+    std::string get_log_prefix_format(const char*FileName,
+                                      int LineNo, const char*FunctionName,
+                                      ext_data levels_format_usage_data) {
+
+        return ezlogger_format_policy::
+            get_log_prefix_format(FileName, LineNo, FunctionName,
+                                  levels_format_usage_data);
+    }
+
+    std::ostream& get_log_stream() {
+        return ezlogger_output_policy::get_log_stream();
+    }
+
+    verbosity get_verbosity_level_tolerance() {
+        return log_very_rarely;
+    }
+};
@@ -23,3 +23,6 @@ test herschel
 YASMV_HOME=`pwd` $YASMV --quiet "$EXAMPLES/koenisberg/koenisberg.smv" < "$EXAMPLES/koenisberg/commands" > koenisberg-out
 test koenisberg
 
+YASMV_HOME=`pwd` $YASMV --quiet "$EXAMPLES/phases/phases.smv" < "$EXAMPLES/phases/commands" > phases-out
+test phases
+